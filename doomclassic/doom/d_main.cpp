@@ -176,12 +176,16 @@ void D_Wipe()
 }
 
 
-void D_Display (void)
+//
+// D_DisplayStart
+// Everything drawn before the player view, returns false if nothing is drawn.
+//
+static qboolean D_DisplayStart (void)
 {
 	qboolean			redrawsbar;
 
 	if (::g->nodrawers)
-		return;                    // for comparative timing / profiling
+		return false;                    // for comparative timing / profiling
 
 	redrawsbar = false;
 
@@ -237,10 +241,23 @@ void D_Display (void)
 	// draw buffered stuff to screen
 	I_UpdateNoBlit ();
 
-	// draw the view directly
-	if (::g->gamestate == GS_LEVEL && !::g->automapactive && ::g->gametic)
-		R_RenderPlayerView (&::g->players[::g->displayplayer]);
+	return true;
+}
+
+//
+// D_NeedsPlayerView
+//
+static qboolean D_NeedsPlayerView (void)
+{
+	return ::g->gamestate == GS_LEVEL && !::g->automapactive && ::g->gametic;
+}
 
+//
+// D_DisplayFinish
+// Everything drawn over the player view.
+//
+static void D_DisplayFinish (void)
+{
 	if (::g->gamestate == GS_LEVEL && ::g->gametic)
 		HU_Drawer ();
 
@@ -305,6 +322,18 @@ void D_Display (void)
 	D_Wipe(); // initialize g->wipedone
 }
 
+void D_Display (void)
+{
+	if (!D_DisplayStart ())
+		return;
+
+	// draw the view directly
+	if (D_NeedsPlayerView ())
+		R_RenderPlayerView (&::g->players[::g->displayplayer]);
+
+	D_DisplayFinish ();
+}
+
 
 
 void D_RunFrame( bool Sounds )
@@ -323,6 +352,46 @@ void D_RunFrame( bool Sounds )
 	}
 }
 
+//
+// D_StartFrame
+// D_RunFrame split around the player view so the views of all
+// split-screen players can be rendered at the same time.
+// Returns true if D_FinishFrame has to be called.
+//
+bool D_StartFrame( bool *renderView )
+{
+	// move positional sounds
+	S_UpdateSounds (::g->players[::g->consoleplayer].mo);
+
+	*renderView = false;
+	if (!D_DisplayStart ())
+		return false;
+
+	*renderView = D_NeedsPlayerView () != false;
+	return true;
+}
+
+//
+// D_RenderPlayerView
+// Only touches the current player's globals, safe to call from a job.
+//
+void D_RenderPlayerView( void )
+{
+	R_RenderPlayerViewNoNet (&::g->players[::g->displayplayer]);
+}
+
+//
+// D_FinishFrame
+//
+void D_FinishFrame( bool displayed )
+{
+	if (displayed)
+		D_DisplayFinish ();
+
+	// Update sound output.
+	I_SubmitSound();
+}
+
 
 
 //
@@ -55,10 +55,29 @@ static char*			mpArgVPtr[4][10];
 
 static bool drawFullScreen = false;
 
+idCVar doom_parallelViews( "doom_parallelViews", "1", CVAR_BOOL, "render the views of split-screen players in parallel on the job system" );
+
+/*
+========================
+DoomRenderPlayerViewJob
+
+Each job thread works on its own copy of the thread local globals pointer,
+so the player's globals are an isolated context for the whole view.
+========================
+*/
+static void DoomRenderPlayerViewJob( Globals * globals ) {
+	Globals * prev = ::g;
+	::g = globals;
+	DoomLib::RenderView();
+	::g = prev;
+}
+REGISTER_PARALLEL_JOB( DoomRenderPlayerViewJob, "DoomRenderPlayerViewJob" );
+
 DoomInterface::DoomInterface() {
 	numplayers = 0;
 	bFinished[0] = bFinished[1] = bFinished[2] = bFinished[3] = false;
 	lastTicRun = 0;
+	viewJobList = NULL;
 }
 
 DoomInterface::~DoomInterface() {
@@ -126,6 +145,35 @@ void DoomInterface::Startup( int playerscount, bool multiplayer )
 	}
 }
 
+/*
+========================
+FinishPlayerFrame
+
+Wipe and menus for the current player, drawn after the player view.
+========================
+*/
+static void FinishPlayerFrame( int numPlayers ) {
+	if (::g->wipe) {
+		DoomLib::Wipe();
+		// Draw the menus over the wipe.
+		M_Drawer();
+	}
+
+	if( ::g->gamestate != GS_LEVEL && numPlayers > 2 ) {
+		drawFullScreen = true;
+	}
+}
+
+/*
+========================
+DoomInterface::Frame
+
+Tics, sound and networking always run serially per player. With
+doom_parallelViews the frame is split around the player view: every
+player is started, the views are rendered concurrently, then every
+player is finished in order.
+========================
+*/
 bool DoomInterface::Frame( int iTime, idUserCmdMgr * userCmdMgr )
 {
 	int i;
@@ -135,6 +183,11 @@ bool DoomInterface::Frame( int iTime, idUserCmdMgr * userCmdMgr )
 
 		drawFullScreen = false;
 
+		const bool parallelViews = doom_parallelViews.GetBool() && numplayers > 1 && !globalNetworking;
+		bool inFrame[4] = { false, false, false, false };
+		bool startedFrame[4] = { false, false, false, false };
+		int numViews = 0;
+
 		DoomLib::SetPlayer( 0 );
 		DoomLib::PollNetwork();
 
@@ -159,22 +212,53 @@ bool DoomInterface::Frame( int iTime, idUserCmdMgr * userCmdMgr )
 							Sys_Yield();
 						}
 					}
-					DoomLib::Frame();
-				}
-				if (::g->wipe) {
-					DoomLib::Wipe();
-					// Draw the menus over the wipe.
-					M_Drawer();
+					if ( parallelViews ) {
+						startedFrame[i] = true;
+						if ( DoomLib::FrameStart() ) {
+							if ( viewJobList == NULL ) {
+								viewJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, 4, 0, NULL );
+							}
+							viewJobList->AddJob( (jobRun_t)DoomRenderPlayerViewJob, ::g );
+							numViews++;
+						}
+					} else {
+						DoomLib::Frame();
+					}
 				}
 
-				if( ::g->gamestate != GS_LEVEL && GetNumPlayers() > 2 ) {
-					drawFullScreen = true;
+				if ( parallelViews ) {
+					inFrame[i] = true;
+				} else {
+					FinishPlayerFrame( GetNumPlayers() );
 				}
 			}
 
 			DoomLib::SetPlayer(-1);
 		}
 
+		if ( parallelViews ) {
+			if ( numViews > 0 ) {
+				viewJobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_THREADS );
+				viewJobList->Wait();
+			}
+
+			for (i = 0; i < numplayers; ++i)
+			{
+				if ( !inFrame[i] ) {
+					continue;
+				}
+
+				DoomLib::SetPlayer( i );
+
+				if ( startedFrame[i] ) {
+					DoomLib::FrameFinish();
+				}
+				FinishPlayerFrame( GetNumPlayers() );
+
+				DoomLib::SetPlayer(-1);
+			}
+		}
+
 		DoomLib::SetPlayer( 0 );
 		DoomLib::SendNetwork();
 		DoomLib::RunSound();
@@ -201,6 +285,11 @@ void DoomInterface::Shutdown() {
 	// Shutdown local network state
 	I_ShutdownNetwork();
 
+	if ( viewJobList != NULL ) {
+		parallelJobManager->FreeJobList( viewJobList );
+		viewJobList = NULL;
+	}
+
 	for ( i=0; i < numplayers; i++ ) {
 		DoomLib::SetPlayer( i );
 		DoomLib::Shutdown();
@@ -38,6 +38,7 @@ If you have questions concerning this license or the applicable additional terms
 #include <string>
 
 class idUserCmdMgr;
+class idParallelJobList;
 
 class DoomInterface
 {
@@ -71,6 +72,8 @@ protected:
 	bool				bFinished[4];
 
 	int					lastTicRun;
+
+	idParallelJobList *	viewJobList;
 };
 
 
@@ -166,6 +166,7 @@ namespace DoomLib
 	void 	(*Z_FreeTag)(int lowtag );
 
 	idArray< idSysMutex, 4 >		playerScreenMutexes;
+	idArray< bool, 4 >				frameDisplayed;
 
 	void ExitGame() {
 		// TODO: If we ever support splitscreen and online,
@@ -236,6 +237,9 @@ extern void D_DoomMain();
 extern bool D_DoomMainPoll();
 extern void I_InitInput();
 extern void D_RunFrame( bool );
+extern bool D_StartFrame( bool * );
+extern void D_RenderPlayerView();
+extern void D_FinishFrame( bool );
 extern void I_ShutdownSound();
 extern void I_ShutdownMusic();
 extern void I_ShutdownGraphics();
@@ -341,6 +345,33 @@ void DoomLib::Frame( int realoffset, int buffer )
 	}
 }
 
+// Same as Frame, but leaves the player view to be drawn by RenderView
+// once every split-screen player has been started. The player's screen
+// stays locked until FrameFinish.
+bool DoomLib::FrameStart( int realoffset )
+{
+	::g->realoffset = realoffset;
+
+	playerScreenMutexes[currentplayer].Lock();
+
+	bool renderView = false;
+	frameDisplayed[currentplayer] = D_StartFrame( &renderView );
+	return renderView;
+}
+
+// Called from a job with ::g set to the player being rendered.
+void DoomLib::RenderView()
+{
+	D_RenderPlayerView();
+}
+
+void DoomLib::FrameFinish()
+{
+	D_FinishFrame( frameDisplayed[currentplayer] );
+
+	playerScreenMutexes[currentplayer].Unlock();
+}
+
 void DoomLib::Draw()
 {
 	R_RenderPlayerView (&::g->players[::g->displayplayer]);
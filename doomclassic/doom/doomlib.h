@@ -105,6 +105,9 @@ namespace DoomLib
 	bool Tic( idUserCmdMgr * userCmdMgr );
 	void Wipe();
 	void Frame( int realoffset = 0, int buffer = 0 );
+	bool FrameStart( int realoffset = 0 );
+	void RenderView();
+	void FrameFinish();
 	void Draw();
 	void Shutdown();
 
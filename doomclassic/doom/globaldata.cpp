@@ -102,5 +102,5 @@ void Globals::InitGlobals()
 #include "constructs.h"
 }
 
-Globals *g;
+thread_local Globals *g;
 
@@ -60,7 +60,9 @@ struct Globals {
 #include "vars.h"
 };
 
-extern Globals *g;
+// Each thread works on one player's globals at a time, so split-screen
+// player views can be rendered concurrently.
+extern thread_local Globals *g;
 
 #define GLOBAL( type, name ) type name
 #define GLOBAL_ARRAY( type, name, count ) type name[count]
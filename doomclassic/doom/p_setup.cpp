@@ -490,7 +490,7 @@ void P_LoadBlockMap (int lump)
 	int		count;
 
 	bool firstTime = false;
-	if (!lumpcache[lump]) {			// SMF - solution for double endian conversion issue
+	if (!::g->lumpcache[lump]) {			// SMF - solution for double endian conversion issue
 		firstTime = true;
 	}
 
@@ -657,6 +657,386 @@ void R_DrawSpanLow ( fixed_t xfrac,
 	} while (count--); 
 }
 
+#ifdef ID_X86_SSE2_INTRIN
+
+//
+// SSE2 drawers.
+// The fixed point stepping is done four pixels at a time,
+//  the texture and colormap lookups stay scalar.
+// Integer adds wrap the same way as the scalar stepping
+//  and the shifts are arithmetic, so every pixel is
+//  identical to the scalar drawers above.
+//
+
+//
+// R_FracLanes
+// frac, frac+step, frac+2*step, frac+3*step
+//
+static ID_INLINE __m128i R_FracLanes ( fixed_t frac, fixed_t step )
+{
+	const unsigned int f = (unsigned int)frac;
+	const unsigned int s = (unsigned int)step;
+
+	return _mm_set_epi32( (int)( f + s * 3 ), (int)( f + s * 2 ), (int)( f + s ), (int)f );
+}
+
+//
+// R_FracStep4
+//
+static ID_INLINE __m128i R_FracStep4 ( fixed_t step )
+{
+	return _mm_set1_epi32( (int)( (unsigned int)step * 4 ) );
+}
+
+void R_DrawColumn_SSE2 ( lighttable_t * dc_colormap,
+						 byte * dc_source )
+{
+	int			count;
+	byte*		dest;
+	fixed_t		frac;
+	fixed_t		fracstep;
+	ALIGN16( int index[4] );
+
+	count = ::g->dc_yh - ::g->dc_yl;
+
+	// Zero length, column does not exceed a pixel.
+	if (count < 0)
+		return;
+
+#ifdef RANGECHECK
+	if ((unsigned)::g->dc_x >= SCREENWIDTH
+		|| ::g->dc_yl < 0
+		|| ::g->dc_yh >= SCREENHEIGHT)
+		I_Error ("R_DrawColumn: %i to %i at %i", ::g->dc_yl, ::g->dc_yh, ::g->dc_x);
+#endif
+
+	dest = ::g->ylookup[::g->dc_yl] + ::g->columnofs[::g->dc_x];
+
+	fracstep = ::g->dc_iscale;
+	frac = ::g->dc_texturemid + (::g->dc_yl-::g->centery)*fracstep;
+
+	// number of pixels
+	count++;
+
+	const __m128i mask = _mm_set1_epi32( 127 );
+	const __m128i step4 = R_FracStep4( fracstep );
+	__m128i fracs = R_FracLanes( frac, fracstep );
+
+	while (count >= 4)
+	{
+		_mm_store_si128( (__m128i *)index, _mm_and_si128( _mm_srai_epi32( fracs, FRACBITS ), mask ) );
+
+		dest[0] = dc_colormap[dc_source[index[0]]];
+		dest[SCREENWIDTH] = dc_colormap[dc_source[index[1]]];
+		dest[SCREENWIDTH*2] = dc_colormap[dc_source[index[2]]];
+		dest[SCREENWIDTH*3] = dc_colormap[dc_source[index[3]]];
+
+		fracs = _mm_add_epi32( fracs, step4 );
+		dest += SCREENWIDTH*4;
+		count -= 4;
+	}
+
+	frac = _mm_cvtsi128_si32( fracs );
+	while (count > 0)
+	{
+		*dest = dc_colormap[dc_source[(frac>>FRACBITS)&127]];
+		frac += fracstep;
+		dest += SCREENWIDTH;
+		count--;
+	}
+}
+
+void R_DrawColumnLow_SSE2 ( lighttable_t * dc_colormap,
+							byte * dc_source )
+{
+	int			count;
+	byte*		dest;
+	byte*		dest2;
+	fixed_t		frac;
+	fixed_t		fracstep;
+	ALIGN16( int index[4] );
+
+	count = ::g->dc_yh - ::g->dc_yl;
+
+	// Zero length.
+	if (count < 0)
+		return;
+
+#ifdef RANGECHECK
+	if ((unsigned)::g->dc_x >= SCREENWIDTH
+		|| ::g->dc_yl < 0
+		|| ::g->dc_yh >= SCREENHEIGHT)
+	{
+		I_Error ("R_DrawColumn: %i to %i at %i", ::g->dc_yl, ::g->dc_yh, ::g->dc_x);
+	}
+#endif
+	// Blocky mode, need to multiply by 2.
+	::g->dc_x <<= 1;
+
+	dest = ::g->ylookup[::g->dc_yl] + ::g->columnofs[::g->dc_x];
+	dest2 = ::g->ylookup[::g->dc_yl] + ::g->columnofs[::g->dc_x+1];
+
+	fracstep = ::g->dc_iscale;
+	frac = ::g->dc_texturemid + (::g->dc_yl-::g->centery)*fracstep;
+
+	// Same as R_DrawColumnLow, which reads the globals.
+	const lighttable_t * colormap = ::g->dc_colormap;
+	const byte * source = ::g->dc_source;
+
+	// number of pixels
+	count++;
+
+	const __m128i mask = _mm_set1_epi32( 127 );
+	const __m128i step4 = R_FracStep4( fracstep );
+	__m128i fracs = R_FracLanes( frac, fracstep );
+
+	while (count >= 4)
+	{
+		_mm_store_si128( (__m128i *)index, _mm_and_si128( _mm_srai_epi32( fracs, FRACBITS ), mask ) );
+
+		dest2[0] = dest[0] = colormap[source[index[0]]];
+		dest2[SCREENWIDTH] = dest[SCREENWIDTH] = colormap[source[index[1]]];
+		dest2[SCREENWIDTH*2] = dest[SCREENWIDTH*2] = colormap[source[index[2]]];
+		dest2[SCREENWIDTH*3] = dest[SCREENWIDTH*3] = colormap[source[index[3]]];
+
+		fracs = _mm_add_epi32( fracs, step4 );
+		dest += SCREENWIDTH*4;
+		dest2 += SCREENWIDTH*4;
+		count -= 4;
+	}
+
+	frac = _mm_cvtsi128_si32( fracs );
+	while (count > 0)
+	{
+		*dest2 = *dest = colormap[source[(frac>>FRACBITS)&127]];
+		frac += fracstep;
+		dest += SCREENWIDTH;
+		dest2 += SCREENWIDTH;
+		count--;
+	}
+}
+
+void R_DrawTranslatedColumn_SSE2 ( lighttable_t * dc_colormap,
+								   byte * dc_source )
+{
+	int			count;
+	byte*		dest;
+	fixed_t		frac;
+	fixed_t		fracstep;
+	ALIGN16( int index[4] );
+
+	count = ::g->dc_yh - ::g->dc_yl;
+	if (count < 0)
+		return;
+
+#ifdef RANGECHECK
+	if ((unsigned)::g->dc_x >= SCREENWIDTH
+		|| ::g->dc_yl < 0
+		|| ::g->dc_yh >= SCREENHEIGHT)
+	{
+		I_Error ( "R_DrawColumn: %i to %i at %i",
+			::g->dc_yl, ::g->dc_yh, ::g->dc_x);
+	}
+#endif
+
+	dest = ::g->ylookup[::g->dc_yl] + ::g->columnofs[::g->dc_x];
+
+	fracstep = ::g->dc_iscale;
+	frac = ::g->dc_texturemid + (::g->dc_yl-::g->centery)*fracstep;
+
+	const byte * translation = ::g->dc_translation;
+
+	// number of pixels
+	count++;
+
+	const __m128i step4 = R_FracStep4( fracstep );
+	__m128i fracs = R_FracLanes( frac, fracstep );
+
+	while (count >= 4)
+	{
+		// not wrapped, sprite columns are never tiled
+		_mm_store_si128( (__m128i *)index, _mm_srai_epi32( fracs, FRACBITS ) );
+
+		dest[0] = dc_colormap[translation[dc_source[index[0]]]];
+		dest[SCREENWIDTH] = dc_colormap[translation[dc_source[index[1]]]];
+		dest[SCREENWIDTH*2] = dc_colormap[translation[dc_source[index[2]]]];
+		dest[SCREENWIDTH*3] = dc_colormap[translation[dc_source[index[3]]]];
+
+		fracs = _mm_add_epi32( fracs, step4 );
+		dest += SCREENWIDTH*4;
+		count -= 4;
+	}
+
+	frac = _mm_cvtsi128_si32( fracs );
+	while (count > 0)
+	{
+		*dest = dc_colormap[translation[dc_source[frac>>FRACBITS]]];
+		frac += fracstep;
+		dest += SCREENWIDTH;
+		count--;
+	}
+}
+
+//
+// R_SpanSpots
+// ((yfrac>>(16-6))&(63*64)) + ((xfrac>>16)&63) for four pixels.
+//
+static ID_INLINE __m128i R_SpanSpots ( __m128i xfracs, __m128i yfracs )
+{
+	const __m128i ymask = _mm_set1_epi32( 63*64 );
+	const __m128i xmask = _mm_set1_epi32( 63 );
+
+	return _mm_add_epi32( _mm_and_si128( _mm_srai_epi32( yfracs, 16-6 ), ymask ),
+						  _mm_and_si128( _mm_srai_epi32( xfracs, 16 ), xmask ) );
+}
+
+void R_DrawSpan_SSE2 ( fixed_t xfrac,
+					   fixed_t yfrac,
+					   fixed_t ds_y,
+					   int ds_x1,
+					   int ds_x2,
+					   fixed_t ds_xstep,
+					   fixed_t ds_ystep,
+					   lighttable_t * ds_colormap,
+					   byte * ds_source )
+{
+	byte*		dest;
+	int			count;
+	ALIGN16( int spot[4] );
+
+#ifdef RANGECHECK
+	if (::g->ds_x2 < ::g->ds_x1
+		|| ::g->ds_x1<0
+		|| ::g->ds_x2>=SCREENWIDTH
+		|| (unsigned)::g->ds_y>SCREENHEIGHT)
+	{
+		I_Error( "R_DrawSpan: %i to %i at %i",
+			::g->ds_x1,::g->ds_x2,::g->ds_y);
+	}
+#endif
+
+	dest = ::g->ylookup[::g->ds_y] + ::g->columnofs[::g->ds_x1];
+
+	count = ds_x2 - g->ds_x1;
+
+	if ( ds_x2 < ds_x1 ) {
+		return;						// SMF - think this is the sky
+	}
+
+	// number of pixels
+	count++;
+
+	const __m128i xstep4 = R_FracStep4( ds_xstep );
+	const __m128i ystep4 = R_FracStep4( ds_ystep );
+	__m128i xfracs = R_FracLanes( xfrac, ds_xstep );
+	__m128i yfracs = R_FracLanes( yfrac, ds_ystep );
+
+	while (count >= 4)
+	{
+		_mm_store_si128( (__m128i *)spot, R_SpanSpots( xfracs, yfracs ) );
+
+		dest[0] = ds_colormap[ds_source[spot[0]]];
+		dest[1] = ds_colormap[ds_source[spot[1]]];
+		dest[2] = ds_colormap[ds_source[spot[2]]];
+		dest[3] = ds_colormap[ds_source[spot[3]]];
+
+		xfracs = _mm_add_epi32( xfracs, xstep4 );
+		yfracs = _mm_add_epi32( yfracs, ystep4 );
+		dest += 4;
+		count -= 4;
+	}
+
+	xfrac = _mm_cvtsi128_si32( xfracs );
+	yfrac = _mm_cvtsi128_si32( yfracs );
+	while (count > 0)
+	{
+		*dest++ = ds_colormap[ds_source[((yfrac>>(16-6))&(63*64)) + ((xfrac>>16)&63)]];
+		xfrac += ds_xstep;
+		yfrac += ds_ystep;
+		count--;
+	}
+}
+
+void R_DrawSpanLow_SSE2 ( fixed_t xfrac,
+						  fixed_t yfrac,
+						  fixed_t ds_y,
+						  int ds_x1,
+						  int ds_x2,
+						  fixed_t ds_xstep,
+						  fixed_t ds_ystep,
+						  lighttable_t * ds_colormap,
+						  byte * ds_source )
+{
+	byte*		dest;
+	int			count;
+	ALIGN16( int spot[4] );
+
+	// Leave anything odd to the scalar drawer.
+	if ( ::g->ds_x2 < ::g->ds_x1 ) {
+		R_DrawSpanLow( xfrac, yfrac, ds_y, ds_x1, ds_x2, ds_xstep, ds_ystep, ds_colormap, ds_source );
+		return;
+	}
+
+#ifdef RANGECHECK
+	if (::g->ds_x1<0
+		|| ::g->ds_x2>=SCREENWIDTH
+		|| (unsigned)::g->ds_y>SCREENHEIGHT)
+	{
+		I_Error( "R_DrawSpan: %i to %i at %i",
+			::g->ds_x1,::g->ds_x2,::g->ds_y);
+	}
+#endif
+
+	// Blocky mode, need to multiply by 2.
+	::g->ds_x1 <<= 1;
+	::g->ds_x2 <<= 1;
+
+	dest = ::g->ylookup[::g->ds_y] + ::g->columnofs[::g->ds_x1];
+
+	// Same as R_DrawSpanLow, which reads the globals.
+	const fixed_t xstep = ::g->ds_xstep;
+	const fixed_t ystep = ::g->ds_ystep;
+	const lighttable_t * colormap = ::g->ds_colormap;
+	const byte * source = ::g->ds_source;
+
+	// number of pixel pairs
+	count = ::g->ds_x2 - ::g->ds_x1 + 1;
+
+	const __m128i xstep4 = R_FracStep4( xstep );
+	const __m128i ystep4 = R_FracStep4( ystep );
+	__m128i xfracs = R_FracLanes( xfrac, xstep );
+	__m128i yfracs = R_FracLanes( yfrac, ystep );
+
+	while (count >= 4)
+	{
+		_mm_store_si128( (__m128i *)spot, R_SpanSpots( xfracs, yfracs ) );
+
+		dest[1] = dest[0] = colormap[source[spot[0]]];
+		dest[3] = dest[2] = colormap[source[spot[1]]];
+		dest[5] = dest[4] = colormap[source[spot[2]]];
+		dest[7] = dest[6] = colormap[source[spot[3]]];
+
+		xfracs = _mm_add_epi32( xfracs, xstep4 );
+		yfracs = _mm_add_epi32( yfracs, ystep4 );
+		dest += 8;
+		count -= 4;
+	}
+
+	xfrac = _mm_cvtsi128_si32( xfracs );
+	yfrac = _mm_cvtsi128_si32( yfracs );
+	while (count > 0)
+	{
+		const int spot1 = ((yfrac>>(16-6))&(63*64)) + ((xfrac>>16)&63);
+		*dest++ = colormap[source[spot1]];
+		*dest++ = colormap[source[spot1]];
+		xfrac += xstep;
+		yfrac += ystep;
+		count--;
+	}
+}
+
+#endif
+
 //
 // R_InitBuffer 
 // Creats lookup tables that avoid
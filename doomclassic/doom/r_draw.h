@@ -113,6 +113,35 @@ void 	R_DrawSpanLow ( fixed_t xfrac,
 				  lighttable_t * ds_colormap,
 				  byte * ds_source );
 
+#ifdef ID_X86_SSE2_INTRIN
+// SSE2 versions of the drawers above, pixel for pixel identical.
+// There is no SSE2 fuzz column, it reads back pixels it has just written.
+void 	R_DrawColumn_SSE2 ( lighttable_t * dc_colormap,
+						byte * dc_source );
+void 	R_DrawColumnLow_SSE2 ( lighttable_t * dc_colormap,
+						byte * dc_source );
+void	R_DrawTranslatedColumn_SSE2 ( lighttable_t * dc_colormap,
+						byte * dc_source );
+void 	R_DrawSpan_SSE2 ( fixed_t xfrac,
+				  fixed_t yfrac,
+				  fixed_t ds_y,
+				  int ds_x1,
+				  int ds_x2,
+				  fixed_t ds_xstep,
+				  fixed_t ds_ystep,
+				  lighttable_t * ds_colormap,
+				  byte * ds_source );
+void 	R_DrawSpanLow_SSE2 ( fixed_t xfrac,
+				  fixed_t yfrac,
+				  fixed_t ds_y,
+				  int ds_x1,
+				  int ds_x2,
+				  fixed_t ds_xstep,
+				  fixed_t ds_ystep,
+				  lighttable_t * ds_colormap,
+				  byte * ds_source );
+#endif
+
 
 void
 R_InitBuffer
@@ -96,7 +96,7 @@ const fixed_t*		finecosine = &finesine[FINEANGLES/4];
 
 
 
-void (*colfunc) (lighttable_t * dc_colormap,
+thread_local void (*colfunc) (lighttable_t * dc_colormap,
 				 byte * dc_source);
 void (*basecolfunc) (lighttable_t * dc_colormap,
 						byte * dc_source);
@@ -114,6 +114,9 @@ void (*spanfunc) (fixed_t xfrac,
 	lighttable_t * ds_colormap,
 	byte * ds_source);
 
+idCVar doom_simdDraw( "doom_simdDraw", "1", CVAR_BOOL, "use the SSE2 column and span drawers, applied on the next view size change" );
+
+
 
 
 //
@@ -654,6 +657,46 @@ R_SetViewSize
 }
 
 
+//
+// R_SetDrawFunctions
+// Picks the column and span drawers for the current detail level.
+//
+static void R_SetDrawFunctions (bool simd)
+{
+	if (!::g->detailshift)
+	{
+		colfunc = basecolfunc = R_DrawColumn;
+		fuzzcolfunc = R_DrawFuzzColumn;
+		transcolfunc = R_DrawTranslatedColumn;
+		spanfunc = R_DrawSpan;
+	}
+	else
+	{
+		colfunc = basecolfunc = R_DrawColumnLow;
+		fuzzcolfunc = R_DrawFuzzColumn;
+		transcolfunc = R_DrawTranslatedColumn;
+		spanfunc = R_DrawSpanLow;
+	}
+
+#ifdef ID_X86_SSE2_INTRIN
+	if (simd)
+	{
+		if (!::g->detailshift)
+		{
+			colfunc = basecolfunc = R_DrawColumn_SSE2;
+			spanfunc = R_DrawSpan_SSE2;
+		}
+		else
+		{
+			colfunc = basecolfunc = R_DrawColumnLow_SSE2;
+			spanfunc = R_DrawSpanLow_SSE2;
+		}
+		transcolfunc = R_DrawTranslatedColumn_SSE2;
+	}
+#endif
+}
+
+
 //
 // R_ExecuteSetViewSize
 //
@@ -692,20 +735,7 @@ void R_ExecuteSetViewSize (void)
 	::g->centeryfrac = ::g->centery<<FRACBITS;
 	::g->projection = ::g->centerxfrac;
 
-	if (!::g->detailshift)
-	{
-		colfunc = basecolfunc = R_DrawColumn;
-		fuzzcolfunc = R_DrawFuzzColumn;
-		transcolfunc = R_DrawTranslatedColumn;
-		spanfunc = R_DrawSpan;
-	}
-	else
-	{
-		colfunc = basecolfunc = R_DrawColumnLow;
-		fuzzcolfunc = R_DrawFuzzColumn;
-		transcolfunc = R_DrawTranslatedColumn;
-		spanfunc = R_DrawSpanLow;
-	}
+	R_SetDrawFunctions (doom_simdDraw.GetBool());
 
 	R_InitBuffer (::g->scaledviewwidth, ::g->viewheight);
 
@@ -860,8 +890,10 @@ void R_SetupFrame (player_t* player)
 
 //
 // R_RenderView
+// NetUpdate polls input and sends packets, so it can only
+// be called while rendering on the main thread.
 //
-void R_RenderPlayerView (player_t* player)
+static void R_RenderPlayerView (player_t* player, bool netupdate)
 {
 	if ( player->mo == NULL ) {
 		return;
@@ -869,6 +901,9 @@ void R_RenderPlayerView (player_t* player)
 
 	R_SetupFrame (player);
 
+	// colfunc is thread local, the view may be rendered by a job thread.
+	colfunc = basecolfunc;
+
 	// Clear buffers.
 	R_ClearClipSegs ();
 	R_ClearDrawSegs ();
@@ -876,22 +911,108 @@ void R_RenderPlayerView (player_t* player)
 	R_ClearSprites ();
 
 	// check for new console commands.
-	NetUpdate ( NULL );
+	if (netupdate)
+		NetUpdate ( NULL );
 
 	// The head node is the last node output.
 	R_RenderBSPNode (::g->numnodes-1);
 
 	// Check for new console commands.
-	NetUpdate ( NULL );
+	if (netupdate)
+		NetUpdate ( NULL );
 
 	R_DrawPlanes ();
 
 	// Check for new console commands.
-	NetUpdate ( NULL );
+	if (netupdate)
+		NetUpdate ( NULL );
 
 	R_DrawMasked ();
 
 	// Check for new console commands.
-	NetUpdate ( NULL );				
+	if (netupdate)
+		NetUpdate ( NULL );
+}
+
+void R_RenderPlayerView (player_t* player)
+{
+	R_RenderPlayerView (player, true);
+}
+
+//
+// R_RenderPlayerViewNoNet
+// Renders the view without touching the network,
+// safe to call from a job thread.
+//
+void R_RenderPlayerViewNoNet (player_t* player)
+{
+	R_RenderPlayerView (player, false);
 }
 
+/*
+========================
+doomTestSIMDDraw
+
+Renders the current view of a classic Doom player with the scalar and the
+SIMD drawers and compares the two frames pixel by pixel.  The screen is filled
+with a sentinel before each pass, so pixels a drawer skips show up as differences.
+========================
+*/
+CONSOLE_COMMAND( doomTestSIMDDraw, "compares classic Doom frames drawn with the scalar and SIMD drawers", NULL ) {
+	const int player = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 0;
+	if ( player < 0 || player >= MAXPLAYERS || DoomLib::GetGlobalData( player ) == NULL ) {
+		idLib::Printf( "usage: doomTestSIMDDraw [player]\n" );
+		return;
+	}
+
+	const int prevPlayer = DoomLib::GetPlayer();
+	DoomLib::SetPlayer( player );
+
+	if ( ::g->gamestate != GS_LEVEL || !::g->gametic || ::g->players[::g->displayplayer].mo == NULL ) {
+		idLib::Printf( "player %d is not in a level\n", player );
+		DoomLib::SetPlayer( prevPlayer );
+		return;
+	}
+
+	const int screenSize = SCREENWIDTH * SCREENHEIGHT;
+	idTempArray< byte > savedScreen( screenSize );
+	idTempArray< byte > frames( screenSize * 2 );
+
+	memcpy( savedScreen.Ptr(), ::g->screens[0], screenSize );
+
+	int usec[2];
+	for ( int i = 0; i < 2; i++ ) {
+		R_SetDrawFunctions( i == 1 );
+
+		memset( ::g->screens[0], 0xff, screenSize );
+
+		// the fuzz table position is the only drawer state carried between frames
+		const int fuzzpos = ::g->fuzzpos;
+		const uint64 start = Sys_Microseconds();
+		R_RenderPlayerViewNoNet( &::g->players[::g->displayplayer] );
+		usec[i] = (int)( Sys_Microseconds() - start );
+		::g->fuzzpos = fuzzpos;
+
+		memcpy( frames.Ptr() + i * screenSize, ::g->screens[0], screenSize );
+	}
+	R_SetDrawFunctions( doom_simdDraw.GetBool() );
+
+	memcpy( ::g->screens[0], savedScreen.Ptr(), screenSize );
+
+	int numDiffer = 0;
+	for ( int i = 0; i < screenSize; i++ ) {
+		if ( frames[i] != frames[screenSize + i] ) {
+			numDiffer++;
+		}
+	}
+
+	idLib::Printf( "scalar: %5d usec\n", usec[0] );
+	idLib::Printf( "simd:   %5d usec\n", usec[1] );
+	if ( numDiffer == 0 ) {
+		idLib::Printf( "frames match\n" );
+	} else {
+		idLib::Printf( "FRAMES DIFFER in %d pixels\n", numDiffer );
+	}
+
+	DoomLib::SetPlayer( prevPlayer );
+}
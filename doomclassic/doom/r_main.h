@@ -99,13 +99,17 @@ extern	int		detailshift;
 //
 // Function pointers to switch refresh/drawing functions.
 // Used to select shadow mode etc.
+// colfunc is switched per sprite, so every thread rendering
+// a player view has its own.
 //
-extern void		(*colfunc) ( lighttable_t * ds_colormap,
+extern thread_local void	(*colfunc) ( lighttable_t * ds_colormap,
 						byte * ds_source );
 extern void		(*basecolfunc) ( lighttable_t * ds_colormap,
 						byte * ds_source );
 extern void		(*fuzzcolfunc) ( lighttable_t * ds_colormap,
 						byte * ds_source );
+extern void		(*transcolfunc) ( lighttable_t * ds_colormap,
+						byte * ds_source );
 // No shadow effects on floors.
 extern void		(*spanfunc) (
 	fixed_t xfrac,
@@ -172,6 +176,7 @@ R_AddPointToBox
 
 // Called by G_Drawer.
 void R_RenderPlayerView (player_t *player);
+void R_RenderPlayerViewNoNet (player_t *player);
 
 // Called by startup code.
 void R_Init (void);
@@ -32,6 +32,9 @@ memzone_t*	mainzone;
 idFile *	wadFileHandles[MAXWADFILES];
 int		numWadFiles;
 
+// per player so lumps purged from one zone never dangle in another
+void**	lumpcache;
+
 //  am_map.vars begin // 
 int 	cheating ;
 int 	grid ;
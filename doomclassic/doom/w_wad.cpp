@@ -53,7 +53,9 @@ If you have questions concerning this license or the applicable additional terms
 
 lumpinfo_t*	lumpinfo = NULL;
 int			numlumps;
-void**		lumpcache;
+
+// lumpinfo handles are shared by every player
+static idSysMutex	wadReadMutex;
 
 
 
@@ -214,15 +216,15 @@ void W_Reload (void)
 // Frees all lump data
 //
 void W_FreeLumps() {
-	if ( lumpcache != NULL ) {
+	if ( ::g->lumpcache != NULL ) {
 		for ( int i = 0; i < numlumps; i++ ) {
-			if ( lumpcache[i] ) {
-				Z_Free( lumpcache[i] );
+			if ( ::g->lumpcache[i] ) {
+				Z_Free( ::g->lumpcache[i] );
 			}
 		}
 
-		Z_Free( lumpcache );
-		lumpcache = NULL;
+		Z_Free( ::g->lumpcache );
+		::g->lumpcache = NULL;
 	}
 
 	if ( lumpinfo != NULL ) {
@@ -282,28 +284,18 @@ void W_InitMultipleFiles (const char** filenames)
 		
 		if (!numlumps)
 			I_Error ("W_InitMultipleFiles: no files found");
+	}
 
-		// set up caching
-		size = numlumps * sizeof(*lumpcache);
-		lumpcache = (void**)DoomLib::Z_Malloc(size, PU_STATIC_SHARED, 0 );
-
-		if (!lumpcache)
-			I_Error ("Couldn't allocate lumpcache");
-
-		memset (lumpcache,0, size);
-	} else {
-		// set up caching
-		size = numlumps * sizeof(*lumpcache);
-		lumpcache = (void**)DoomLib::Z_Malloc(size, PU_STATIC_SHARED, 0 );
+	// set up caching, every player gets its own cache in its own zone
+	size = numlumps * sizeof(*::g->lumpcache);
+	::g->lumpcache = (void**)DoomLib::Z_Malloc(size, PU_STATIC_SHARED, 0 );
 
-		if (!lumpcache)
-			I_Error ("Couldn't allocate lumpcache");
+	if (!::g->lumpcache)
+		I_Error ("Couldn't allocate lumpcache");
 
-		memset (lumpcache,0, size);
-	}
+	memset (::g->lumpcache,0, size);
 }
 
-
 void W_Shutdown( void ) {
 /*
 	for (int i = 0 ; i < MAXWADFILES ; i++) {
@@ -435,7 +427,8 @@ W_ReadLump
     l = lumpinfo+lump;
 	
 	handle = l->handle;
-	
+
+	idScopedCriticalSection crit( wadReadMutex );
 	handle->Seek( l->position, FS_SEEK_SET );
 	c = handle->Read( dest, l->size );
 
@@ -459,16 +452,16 @@ W_CacheLumpNum
 	I_Error ("W_CacheLumpNum: %i >= numlumps",lump);
 #endif
 
-	if (!lumpcache[lump])
+	if (!::g->lumpcache[lump])
 	{
 		byte*	ptr;
 		// read the lump in
 		//I_Printf ("cache miss on lump %i\n",lump);
-		ptr = (byte*)DoomLib::Z_Malloc(W_LumpLength (lump), tag, &lumpcache[lump]);
-		W_ReadLump (lump, lumpcache[lump]);
+		ptr = (byte*)DoomLib::Z_Malloc(W_LumpLength (lump), tag, &::g->lumpcache[lump]);
+		W_ReadLump (lump, ::g->lumpcache[lump]);
 	}
 
-	return lumpcache[lump];
+	return ::g->lumpcache[lump];
 }
 
 
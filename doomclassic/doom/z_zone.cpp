@@ -112,7 +112,8 @@ void Z_Init (void)
     block->size = ::g->mainzone->size - sizeof(memzone_t);
 }
 
-int NumAlloc = 0;
+// zones are per player but players may allocate from different threads
+interlockedInt_t NumAlloc = 0;
 
 //
 // Z_Free
@@ -124,7 +125,7 @@ void Z_Free (void* ptr)
 
 	block = (memblock_t *) ( (byte *)ptr - sizeof(memblock_t));
 
-	NumAlloc -= block->size;
+	Sys_InterlockedAdd( NumAlloc, -block->size );
 
     if (block->id != ZONEID)
 	I_Error ("Z_Free: freed a pointer without ZONEID");
@@ -191,7 +192,7 @@ Z_Malloc
     memblock_t* rover;
     memblock_t* newblock;
     memblock_t*	base;
-	NumAlloc += size;
+	Sys_InterlockedAdd( NumAlloc, size );
     	
 	size = (size + 3) & ~3;
     
@@ -33,6 +33,11 @@ If you have questions concerning this license or the applicable additional terms
 #include "AASFile.h"
 #include "AASFile_local.h"
 
+idCVar binaryLoadAAS( "binaryLoadAAS", "1", 0, "enable binary load/write of AAS files" );
+
+static const byte BAAS_VERSION = 100;
+static const unsigned int BAAS_MAGIC = ( 'B' << 24 ) | ( 'A' << 16 ) | ( 'A' << 8 ) | BAAS_VERSION;
+static const unsigned int BAAS_BYTE_ORDER = 0x01020304;
 
 /*
 ===============================================================================
@@ -496,6 +501,74 @@ bool idAASSettings::WriteToFile( idFile *fp ) const {
 	return true;
 }
 
+/*
+============
+idAASSettings::ReadBinary
+============
+*/
+bool idAASSettings::ReadBinary( idFile *file ) {
+	file->ReadBig( numBoundingBoxes );
+	if ( numBoundingBoxes <= 0 || numBoundingBoxes > MAX_AAS_BOUNDING_BOXES ) {
+		return false;
+	}
+	for ( int i = 0; i < numBoundingBoxes; i++ ) {
+		file->ReadBig( boundingBoxes[i] );
+	}
+	file->ReadBig( usePatches );
+	file->ReadBig( writeBrushMap );
+	file->ReadBig( playerFlood );
+	file->ReadBig( noOptimize );
+	file->ReadBig( allowSwimReachabilities );
+	file->ReadBig( allowFlyReachabilities );
+	file->ReadString( fileExtension );
+	file->ReadBig( gravity );
+	file->ReadBig( gravityDir );
+	file->ReadBig( invGravityDir );
+	file->ReadBig( gravityValue );
+	file->ReadBig( maxStepHeight );
+	file->ReadBig( maxBarrierHeight );
+	file->ReadBig( maxWaterJumpHeight );
+	file->ReadBig( maxFallHeight );
+	file->ReadBig( minFloorCos );
+	file->ReadBig( tt_barrierJump );
+	file->ReadBig( tt_startCrouching );
+	file->ReadBig( tt_waterJump );
+	file->ReadBig( tt_startWalkOffLedge );
+	return true;
+}
+
+/*
+============
+idAASSettings::WriteBinary
+============
+*/
+void idAASSettings::WriteBinary( idFile *file ) const {
+	file->WriteBig( numBoundingBoxes );
+	for ( int i = 0; i < numBoundingBoxes; i++ ) {
+		file->WriteBig( boundingBoxes[i] );
+	}
+	file->WriteBig( usePatches );
+	file->WriteBig( writeBrushMap );
+	file->WriteBig( playerFlood );
+	file->WriteBig( noOptimize );
+	file->WriteBig( allowSwimReachabilities );
+	file->WriteBig( allowFlyReachabilities );
+	file->WriteString( fileExtension );
+	file->WriteBig( gravity );
+	file->WriteBig( gravityDir );
+	file->WriteBig( invGravityDir );
+	file->WriteBig( gravityValue );
+	file->WriteBig( maxStepHeight );
+	file->WriteBig( maxBarrierHeight );
+	file->WriteBig( maxWaterJumpHeight );
+	file->WriteBig( maxFallHeight );
+	file->WriteBig( minFloorCos );
+	file->WriteBig( tt_barrierJump );
+	file->WriteBig( tt_startCrouching );
+	file->WriteBig( tt_waterJump );
+	file->WriteBig( tt_startWalkOffLedge );
+}
+
 /*
 ============
 idAASSettings::ValidForBounds
@@ -1094,21 +1167,15 @@ void idAASFileLocal::FinishAreas() {
 
 /*
 ================
-idAASFileLocal::Load
+idAASFileLocal::LoadText
 ================
 */
-bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
+bool idAASFileLocal::LoadText( unsigned int mapFileCRC ) {
 	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
 	idToken token;
 	int depth;
 	unsigned int c;
 
-	name = fileName;
-	crc = mapFileCRC;
-
-	common->Printf( "[Load AAS]\n" );
-	common->Printf( "loading %s\n", name.c_str() );
-
 	if ( !src.LoadFile( name ) ) {
 		return false;
 	}
@@ -1192,6 +1259,252 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
+	return true;
+}
+
+/*
+================
+WriteBinaryList
+================
+*/
+template< class type, memTag_t tag >
+static void WriteBinaryList( idFile *file, const idList< type, tag > &list ) {
+	file->WriteBig( list.Num() );
+	file->Write( list.Ptr(), list.Num() * sizeof( type ) );
+}
+
+/*
+================
+ReadBinaryList
+================
+*/
+template< class type, memTag_t tag >
+static bool ReadBinaryList( idFile *file, idList< type, tag > &list ) {
+	int num = -1;
+	file->ReadBig( num );
+	if ( num < 0 ) {
+		return false;
+	}
+	list.SetNum( num );
+	const int size = num * sizeof( type );
+	return ( file->Read( list.Ptr(), size ) == size );
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+
+The lists are stored as they are in memory so they can be read in one go, the header
+makes sure the binary was written with the same byte order and structure layout.
+================
+*/
+bool idAASFileLocal::LoadBinary( idFile *file, ID_TIME_T sourceTimeStamp, unsigned int mapFileCRC ) {
+	int i, j, num;
+
+	if ( file == NULL ) {
+		return false;
+	}
+
+	unsigned int magic = 0;
+	file->ReadBig( magic );
+	if ( magic != BAAS_MAGIC ) {
+		return false;
+	}
+
+	ID_TIME_T loadedTimeStamp;
+	file->ReadBig( loadedTimeStamp );
+	if ( !fileSystem->InProductionMode() && sourceTimeStamp != loadedTimeStamp ) {
+		return false;
+	}
+
+	unsigned int loadedCRC;
+	file->ReadBig( loadedCRC );
+	if ( mapFileCRC && loadedCRC != mapFileCRC ) {
+		return false;
+	}
+
+	unsigned int byteOrder = 0;
+	file->Read( &byteOrder, sizeof( byteOrder ) );
+	if ( byteOrder != BAAS_BYTE_ORDER ) {
+		return false;
+	}
+
+	int layout[8];
+	file->ReadBigArray( layout, 8 );
+	if ( layout[0] != sizeof( idPlane ) || layout[1] != sizeof( aasVertex_t ) || layout[2] != sizeof( aasEdge_t ) || layout[3] != sizeof( aasFace_t ) ||
+			layout[4] != sizeof( aasArea_t ) || layout[5] != sizeof( aasNode_t ) || layout[6] != sizeof( aasPortal_t ) || layout[7] != sizeof( aasCluster_t ) ) {
+		return false;
+	}
+
+	Clear();
+
+	if ( !settings.ReadBinary( file ) ||
+			!ReadBinaryList( file, planeList ) ||
+			!ReadBinaryList( file, vertices ) ||
+			!ReadBinaryList( file, edges ) ||
+			!ReadBinaryList( file, edgeIndex ) ||
+			!ReadBinaryList( file, faces ) ||
+			!ReadBinaryList( file, faceIndex ) ||
+			!ReadBinaryList( file, areas ) ||
+			!ReadBinaryList( file, nodes ) ||
+			!ReadBinaryList( file, portals ) ||
+			!ReadBinaryList( file, portalIndex ) ||
+			!ReadBinaryList( file, clusters ) ) {
+		Clear();
+		return false;
+	}
+
+	// the reachabilities are stored in list order
+	for ( i = 0; i < areas.Num(); i++ ) {
+		areas[i].reach = NULL;
+		areas[i].rev_reach = NULL;
+	}
+	for ( i = 0; i < areas.Num(); i++ ) {
+		idReachability **tail = &areas[i].reach;
+
+		file->ReadBig( num );
+		if ( num < 0 || num > MAX_REACH_PER_AREA ) {
+			DeleteReachabilities();
+			Clear();
+			return false;
+		}
+		for ( j = 0; j < num; j++ ) {
+			idReachability reach;
+			file->ReadBig( reach.travelType );
+			file->ReadBig( reach.toAreaNum );
+			file->ReadBig( reach.start );
+			file->ReadBig( reach.end );
+			file->ReadBig( reach.edgeNum );
+			file->ReadBig( reach.travelTime );
+
+			idReachability *newReach;
+			if ( reach.travelType == TFL_SPECIAL ) {
+				idReachability_Special *special = new (TAG_AAS) idReachability_Special();
+				special->dict.ReadFromFileHandle( file );
+				newReach = special;
+			} else {
+				newReach = new (TAG_AAS) idReachability();
+			}
+			newReach->CopyBase( reach );
+			newReach->fromAreaNum = i;
+			newReach->next = NULL;
+			*tail = newReach;
+			tail = &newReach->next;
+		}
+	}
+
+	unsigned int endMagic = 0;
+	file->ReadBig( endMagic );
+	if ( endMagic != BAAS_MAGIC ) {
+		DeleteReachabilities();
+		Clear();
+		return false;
+	}
+
+	LinkReversedReachability();
+
+	return true;
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+================
+*/
+void idAASFileLocal::WriteBinary( idFile *file, ID_TIME_T sourceTimeStamp ) const {
+	int i, num;
+	const idReachability *reach;
+
+	if ( file == NULL ) {
+		return;
+	}
+
+	file->WriteBig( BAAS_MAGIC );
+	file->WriteBig( sourceTimeStamp );
+	file->WriteBig( crc );
+	file->Write( &BAAS_BYTE_ORDER, sizeof( BAAS_BYTE_ORDER ) );
+
+	const int layout[8] = {
+		sizeof( idPlane ), sizeof( aasVertex_t ), sizeof( aasEdge_t ), sizeof( aasFace_t ),
+		sizeof( aasArea_t ), sizeof( aasNode_t ), sizeof( aasPortal_t ), sizeof( aasCluster_t )
+	};
+	file->WriteBigArray( layout, 8 );
+
+	settings.WriteBinary( file );
+	WriteBinaryList( file, planeList );
+	WriteBinaryList( file, vertices );
+	WriteBinaryList( file, edges );
+	WriteBinaryList( file, edgeIndex );
+	WriteBinaryList( file, faces );
+	WriteBinaryList( file, faceIndex );
+	WriteBinaryList( file, areas );
+	WriteBinaryList( file, nodes );
+	WriteBinaryList( file, portals );
+	WriteBinaryList( file, portalIndex );
+	WriteBinaryList( file, clusters );
+
+	for ( i = 0; i < areas.Num(); i++ ) {
+		for ( num = 0, reach = areas[i].reach; reach; reach = reach->next ) {
+			num++;
+		}
+		file->WriteBig( num );
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			file->WriteBig( reach->travelType );
+			file->WriteBig( reach->toAreaNum );
+			file->WriteBig( reach->start );
+			file->WriteBig( reach->end );
+			file->WriteBig( reach->edgeNum );
+			file->WriteBig( reach->travelTime );
+			if ( reach->travelType == TFL_SPECIAL ) {
+				static_cast<const idReachability_Special *>( reach )->dict.WriteToFileHandle( file );
+			}
+		}
+	}
+
+	file->WriteBig( BAAS_MAGIC );
+}
+
+/*
+================
+idAASFileLocal::Load
+================
+*/
+bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
+	name = fileName;
+	crc = mapFileCRC;
+
+	common->Printf( "[Load AAS]\n" );
+	common->Printf( "loading %s\n", name.c_str() );
+
+	idStr extension;
+	name.ExtractFileExtension( extension );
+
+	idStrStatic< MAX_OSPATH > generatedFileName = "generated/";
+	generatedFileName.AppendPath( name );
+	generatedFileName.SetFileExtension( va( "b%s", extension.c_str() ) );
+
+	// if the source is newer than the binary, regenerate it
+	ID_TIME_T sourceTimeStamp = fileSystem->GetTimestamp( name );
+
+	if ( binaryLoadAAS.GetBool() ) {
+		idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+		if ( LoadBinary( file, sourceTimeStamp, mapFileCRC ) ) {
+			common->UpdateLevelLoadPacifier();
+			common->Printf( "done.\n" );
+			return true;
+		}
+	}
+
+	if ( !LoadText( mapFileCRC ) ) {
+		return false;
+	}
+
+	if ( binaryLoadAAS.GetBool() ) {
+		common->Printf( "writing %s\n", generatedFileName.c_str() );
+		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+		WriteBinary( outputFile, sourceTimeStamp );
+	}
+
 	common->UpdateLevelLoadPacifier();
 
 	common->Printf( "done.\n" );
@@ -243,6 +243,8 @@ public:
 	bool						FromParser( idLexer &src );
 	bool						FromDict( const char *name, const idDict *dict );
 	bool						WriteToFile( idFile *fp ) const;
+	bool						ReadBinary( idFile *file );
+	void						WriteBinary( idFile *file ) const;
 	bool						ValidForBounds( const idBounds &bounds ) const;
 	bool						ValidEntity( const char *classname ) const;
 
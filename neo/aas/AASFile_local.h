@@ -76,6 +76,10 @@ public:
 	void						DeleteClusters();
 
 private:
+	bool						LoadText( unsigned int mapFileCRC );
+	bool						LoadBinary( idFile *file, ID_TIME_T sourceTimeStamp, unsigned int mapFileCRC );
+	void						WriteBinary( idFile *file, ID_TIME_T sourceTimeStamp ) const;
+
 	bool						ParseIndex( idLexer &src, idList<aasIndex_t> &indexes );
 	bool						ParsePlanes( idLexer &src );
 	bool						ParseVertices( idLexer &src );
@@ -83,6 +83,7 @@ typedef int cmHandle_t;
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
+#define CM_MAX_TRACE_CONTEXTS	4			// maximum number of translations that can run in parallel
 
 class idCollisionModelManager {
 public:
@@ -132,6 +133,18 @@ public:
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
 
+	// Reserves the first numContexts trace contexts for parallel translations. Until EndParallelTranslations
+	// is called only the Parallel* functions may be used, each thread with its own trace context.
+	virtual void			BeginParallelTranslations( int numContexts ) = 0;
+	// Releases the trace contexts so the regular queries can be used again.
+	virtual void			EndParallelTranslations() = 0;
+	// Same as SetupTrmModel but for the trace model of the given trace context.
+	virtual cmHandle_t		ParallelSetupTrmModel( int traceContext, const idTraceModel &trm, const idMaterial *material ) = 0;
+	// Same as Translation but using the given trace context, 0 <= traceContext < numContexts.
+	virtual void			ParallelTranslation( int traceContext, trace_t *results, const idVec3 &start, const idVec3 &end,
+								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+
 	// Tests collision detection.
 	virtual void			DebugOutput( const idVec3 &origin ) = 0;
 	// Draws a model.
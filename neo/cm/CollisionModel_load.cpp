@@ -196,6 +196,8 @@ void idCollisionModelManagerLocal::Clear() {
 	contacts = NULL;
 	maxContacts = 0;
 	numContacts = 0;
+	numParallelContexts = 0;
+	memset( traceContexts, 0, sizeof( traceContexts ) );
 }
 
 /*
@@ -425,6 +427,8 @@ void idCollisionModelManagerLocal::FreeMap() {
 
 	FreeTrmModelStructure();
 
+	FreeTraceContexts();
+
 	Mem_Free( models );
 
 	Clear();
@@ -434,25 +438,63 @@ void idCollisionModelManagerLocal::FreeMap() {
 
 /*
 ================
-idCollisionModelManagerLocal::FreeTrmModelStructure
+idCollisionModelManagerLocal::FreeTrmModel
 ================
 */
-void idCollisionModelManagerLocal::FreeTrmModelStructure() {
+void idCollisionModelManagerLocal::FreeTrmModel( cm_model_t *model, cm_polygonRef_t **polygons, cm_brushRef_t **brushes ) {
 	int i;
 
+	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
+		FreePolygon( model, polygons[i]->p );
+	}
+	FreeBrush( model, brushes[0]->b );
+
+	model->node->polygons = NULL;
+	model->node->brushes = NULL;
+	FreeModel( model );
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeTrmModelStructure
+================
+*/
+void idCollisionModelManagerLocal::FreeTrmModelStructure() {
 	assert( models );
 	if ( !models[MAX_SUBMODELS] ) {
 		return;
 	}
 
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
-	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	FreeTrmModel( models[MAX_SUBMODELS], trmPolygons, trmBrushes );
+}
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+/*
+================
+idCollisionModelManagerLocal::FreeTraceContexts
+================
+*/
+void idCollisionModelManagerLocal::FreeTraceContexts() {
+	for ( int i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ ) {
+		cm_traceContext_t *context = traceContexts[i];
+		if ( context == NULL ) {
+			continue;
+		}
+		// the first context uses the models of the collision map
+		if ( i > 0 ) {
+			for ( int j = 0; j < context->numModels; j++ ) {
+				cm_model_t *model = context->models[j];
+				if ( model == NULL ) {
+					continue;
+				}
+				Mem_Free( model->vertices );
+				Mem_Free( model->edges );
+				delete model;
+			}
+			FreeTrmModel( context->models[TRACE_MODEL_HANDLE], context->trmPolygons, context->trmBrushes );
+		}
+		delete context;
+		traceContexts[i] = NULL;
+	}
 }
 
 
@@ -731,10 +773,10 @@ void idCollisionModelManagerLocal::AddBrushToNode( cm_model_t *model, cm_node_t
 
 /*
 ================
-idCollisionModelManagerLocal::SetupTrmModelStructure
+idCollisionModelManagerLocal::AllocTrmModel
 ================
 */
-void idCollisionModelManagerLocal::SetupTrmModelStructure() {
+cm_model_t *idCollisionModelManagerLocal::AllocTrmModel( cm_polygonRef_t **polygons, cm_brushRef_t **brushes ) {
 	int i;
 	cm_node_t *node;
 	cm_model_t *model;
@@ -742,8 +784,6 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure() {
 	// setup model
 	model = AllocModel();
 
-	assert( models );
-	models[MAX_SUBMODELS] = model;
 	// create node to hold the collision data
 	node = (cm_node_t *) AllocNode( model, 1 );
 	node->planeType = -1;
@@ -755,32 +795,95 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure() {
 	model->numEdges = 0;
 	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
 	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t), TAG_COLLISION );
+
+	// allocate polygons
+	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
+		polygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
+		polygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
+		polygons[i]->p->bounds.Clear();
+		polygons[i]->p->plane.Zero();
+		polygons[i]->p->checkcount = 0;
+		polygons[i]->p->contents = -1;		// all contents
+		polygons[i]->p->material = trmMaterial;
+		polygons[i]->p->numEdges = 0;
+	}
+	// allocate brush for position test
+	brushes[0] = AllocBrushReference( model, 1 );
+	brushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
+	brushes[0]->b->primitiveNum = 0;
+	brushes[0]->b->bounds.Clear();
+	brushes[0]->b->checkcount = 0;
+	brushes[0]->b->contents = -1;		// all contents
+	brushes[0]->b->material = trmMaterial;
+	brushes[0]->b->numPlanes = 0;
+
+	return model;
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTrmModelStructure
+================
+*/
+void idCollisionModelManagerLocal::SetupTrmModelStructure() {
 	// create a material for the trace model polygons
 	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
 	if ( !trmMaterial ) {
 		common->FatalError( "_tracemodel material not found" );
 	}
 
-	// allocate polygons
-	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		trmPolygons[i] = AllocPolygonReference( model, MAX_TRACEMODEL_POLYS );
-		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
-		trmPolygons[i]->p->bounds.Clear();
-		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
-		trmPolygons[i]->p->contents = -1;		// all contents
-		trmPolygons[i]->p->material = trmMaterial;
-		trmPolygons[i]->p->numEdges = 0;
+	assert( models );
+	models[MAX_SUBMODELS] = AllocTrmModel( trmPolygons, trmBrushes );
+}
+
+/*
+================
+idCollisionModelManagerLocal::UpdateTraceContexts
+
+Allocates the first numContexts trace contexts and gives them copies of the vertex
+and edge arrays of the models loaded since their last update.  The first context
+uses the arrays of the models themselves, so the copies are only made once a batch
+actually runs on more than one thread.
+================
+*/
+void idCollisionModelManagerLocal::UpdateTraceContexts( int numContexts ) {
+	assert( models );
+	assert( numContexts > 0 && numContexts <= CM_MAX_TRACE_CONTEXTS );
+
+	for ( int i = 0; i < numContexts; i++ ) {
+		cm_traceContext_t *context = traceContexts[i];
+		if ( context == NULL ) {
+			context = new (TAG_COLLISION) cm_traceContext_t;
+			context->checkCount = 0;
+			context->numModels = 0;
+			context->numInvalidModels = 0;
+			context->numHugeTranslations = 0;
+			memset( context->models, 0, sizeof( context->models ) );
+			if ( i == 0 ) {
+				context->models[TRACE_MODEL_HANDLE] = models[TRACE_MODEL_HANDLE];
+				memcpy( context->trmPolygons, trmPolygons, sizeof( trmPolygons ) );
+				context->trmBrushes[0] = trmBrushes[0];
+			} else {
+				context->models[TRACE_MODEL_HANDLE] = AllocTrmModel( context->trmPolygons, context->trmBrushes );
+			}
+			traceContexts[i] = context;
+		}
+
+		for ( ; context->numModels < numModels; context->numModels++ ) {
+			cm_model_t *model = models[context->numModels];
+			if ( i == 0 || model == NULL ) {
+				context->models[context->numModels] = model;
+				continue;
+			}
+			// share everything but the vertices and edges which store the sidedness caches
+			cm_model_t *copy = new (TAG_COLLISION) cm_model_t( *model );
+			copy->vertices = (cm_vertex_t *) Mem_Alloc( Max( model->maxVertices, 1 ) * sizeof( cm_vertex_t ), TAG_COLLISION );
+			memcpy( copy->vertices, model->vertices, model->maxVertices * sizeof( cm_vertex_t ) );
+			copy->edges = (cm_edge_t *) Mem_Alloc( Max( model->maxEdges, 1 ) * sizeof( cm_edge_t ), TAG_COLLISION );
+			memcpy( copy->edges, model->edges, model->maxEdges * sizeof( cm_edge_t ) );
+			context->models[context->numModels] = copy;
+		}
 	}
-	// allocate brush for position test
-	trmBrushes[0] = AllocBrushReference( model, 1 );
-	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
-	trmBrushes[0]->b->primitiveNum = 0;
-	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
-	trmBrushes[0]->b->contents = -1;		// all contents
-	trmBrushes[ 0 ]->b->material = trmMaterial;
-	trmBrushes[0]->b->numPlanes = 0;
 }
 
 /*
@@ -792,27 +895,39 @@ as a reusable temporary buffer
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) {
+	assert( models );
+	assert( numParallelContexts == 0 );
+
+	SetupTrmModel( models[MAX_SUBMODELS], trmPolygons, trmBrushes, trm, material );
+
+	return TRACE_MODEL_HANDLE;
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTrmModel
+
+Converts the trace model into the given trm model.
+================
+*/
+void idCollisionModelManagerLocal::SetupTrmModel( cm_model_t *model, cm_polygonRef_t **trmPolygons, cm_brushRef_t **trmBrushes, const idTraceModel &trm, const idMaterial *material ) {
 	int i, j;
 	cm_vertex_t *vertex;
 	cm_edge_t *edge;
 	cm_polygon_t *poly;
-	cm_model_t *model;
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
 
-	assert( models );
-
 	if ( material == NULL ) {
-		material = trmMaterial;
+		material = idCollisionModelManagerLocal::trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
 	if ( trm.type == TRM_INVALID || !trm.numPolys ) {
-		return TRACE_MODEL_HANDLE;
+		return;
 	}
 	// vertices
 	model->numVertices = trm.numVerts;
@@ -867,8 +982,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	model->bounds = trm.bounds;
 	// convex
 	model->isConvex = trm.isConvex;
-
-	return TRACE_MODEL_HANDLE;
 }
 
 /*
@@ -253,6 +253,7 @@ typedef struct cm_traceWork_s {
 	idBounds size;									// bounds of transformed trm relative to start
 	idVec3 extents;									// largest of abs(size[0]) and abs(size[1]) for BSP trace
 	int contents;									// ignore polygons that do not have any of these contents flags
+	int checkCount;									// for multi-check avoidance
 	trace_t trace;									// collision detection result
 
 	bool rotation;									// true if calculating rotational collision
@@ -284,6 +285,22 @@ typedef struct cm_traceWork_s {
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
 } cm_traceWork_t;
 
+// State for translations that can run at the same time as translations in other contexts.
+// Every context but the first has its own copy of the vertex and edge arrays of the loaded
+// models because the sidedness caches are stored with the edges and vertices.  Polygons
+// and brushes are shared, the check counts of the contexts never overlap so a polygon
+// stamped by another context is at worst tested twice.
+typedef struct cm_traceContext_s {
+	cm_traceWork_t			tw;					// trace work for the context
+	int						checkCount;			// for multi-check avoidance
+	int						numModels;			// number of loaded models the context has been set up for
+	int						numInvalidModels;	// warnings are printed on the calling thread by EndParallelTranslations
+	int						numHugeTranslations;
+	cm_model_t *			models[MAX_SUBMODELS+1];	// models with the vertex and edge arrays used by the context
+	cm_polygonRef_t *		trmPolygons[MAX_TRACEMODEL_POLYS];	// polygons and brush for the trm model of the context
+	cm_brushRef_t *			trmBrushes[1];
+} cm_traceContext_t;
+
 /*
 ===============================================================================
 
@@ -353,6 +370,17 @@ public:
 	// write a collision model file for the map entity
 	bool			WriteCollisionModelForMapEntity( const idMapEntity *mapEnt, const char *filename, const bool testTraceModel = true );
 
+	// reserve the trace contexts for parallel translations
+	void			BeginParallelTranslations( int numContexts );
+	// release the trace contexts
+	void			EndParallelTranslations();
+	// sets up a trace model for collision with other trace models in the given trace context
+	cmHandle_t		ParallelSetupTrmModel( int traceContext, const idTraceModel &trm, const idMaterial *material );
+	// translates a trm using the given trace context
+	void			ParallelTranslation( int traceContext, trace_t *results, const idVec3 &start, const idVec3 &end,
+								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+
 private:			// CollisionMap_translate.cpp
 	int				TranslateEdgeThroughEdge( idVec3 &cross, idPluecker &l1, idPluecker &l2, float *fraction );
 	void			TranslateTrmEdgeThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmEdge_t *trmEdge );
@@ -362,6 +390,10 @@ private:			// CollisionMap_translate.cpp
 	bool			TranslateTrmThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *p );
 	void			SetupTranslationHeartPlanes( cm_traceWork_t *tw );
 	void			SetupTrm( cm_traceWork_t *tw, const idTraceModel *trm );
+	void			ContextTranslation( cm_traceContext_t *context, cm_traceWork_t &tw, trace_t *results, const idVec3 &start, const idVec3 &end,
+								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	int				NextCheckCount( cm_traceContext_t *context );
 
 private:			// CollisionMap_rotate.cpp
 	int				CollisionBetweenEdgeBounds( cm_traceWork_t *tw, const idVec3 &va, const idVec3 &vb,
@@ -395,9 +427,9 @@ private:			// CollisionMap_contents.cpp
 	bool			TestTrmVertsInBrush( cm_traceWork_t *tw, cm_brush_t *b );
 	bool			TestTrmInPolygon( cm_traceWork_t *tw, cm_polygon_t *p );
 	cm_node_t *		PointNode( const idVec3 &p, cm_model_t *model );
-	int				PointContents( const idVec3 p, cmHandle_t model );
-	int				TransformedPointContents( const idVec3 &p, cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis );
-	int				ContentsTrm( trace_t *results, const idVec3 &start,
+	int				PointContents( const idVec3 p, cm_model_t *model );
+	int				TransformedPointContents( const idVec3 &p, cm_model_t *model, const idVec3 &origin, const idMat3 &modelAxis );
+	int				ContentsTrm( cm_traceContext_t *context, trace_t *results, const idVec3 &start,
 									const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 									cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 
@@ -409,7 +441,9 @@ private:			// CollisionMap_trace.cpp
 
 private:			// CollisionMap_load.cpp
 	void			Clear();
+	void			FreeTrmModel( cm_model_t *model, cm_polygonRef_t **polygons, cm_brushRef_t **brushes );
 	void			FreeTrmModelStructure();
+	void			FreeTraceContexts();
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -449,7 +483,10 @@ private:			// CollisionMap_load.cpp
 	cm_brush_t *	AllocBrush( cm_model_t *model, int numPlanes );
 	void			AddPolygonToNode( cm_model_t *model, cm_node_t *node, cm_polygon_t *p );
 	void			AddBrushToNode( cm_model_t *model, cm_node_t *node, cm_brush_t *b );
+	cm_model_t *	AllocTrmModel( cm_polygonRef_t **polygons, cm_brushRef_t **brushes );
 	void			SetupTrmModelStructure();
+	void			SetupTrmModel( cm_model_t *model, cm_polygonRef_t **polygons, cm_brushRef_t **brushes, const idTraceModel &trm, const idMaterial *material );
+	void			UpdateTraceContexts( int numContexts );
 	void			R_FilterPolygonIntoTree( cm_model_t *model, cm_node_t *node, cm_polygonRef_t *pref, cm_polygon_t *p );
 	void			R_FilterBrushIntoTree( cm_model_t *model, cm_node_t *node, cm_brushRef_t *pref, cm_brush_t *b );
 	cm_node_t *		R_CreateAxialBSPTree( cm_model_t *model, cm_node_t *node, const idBounds &bounds );
@@ -533,6 +570,9 @@ private:			// collision map data
 	contactInfo_t *	contacts;
 	int				maxContacts;
 	int				numContacts;
+					// for parallel translations
+	int				numParallelContexts;	// contexts reserved by BeginParallelTranslations, 0 when not running parallel translations
+	cm_traceContext_t *traceContexts[CM_MAX_TRACE_CONTEXTS];
 };
 
 // for debugging
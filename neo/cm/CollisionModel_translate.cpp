@@ -244,7 +244,7 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edge->checkcount == tw->checkCount ) {
 			continue;
 		}
 		// can never collide with internal edges
@@ -415,9 +415,9 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
 			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( edge->checkcount != tw->checkCount ) {
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edge->checkcount = tw->checkCount;
 				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
 				fl = v->pl.PermutedInnerProduct( pl );
 				edge->side = ( fl < 0.0f );
@@ -511,10 +511,10 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_edge_t *e;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( p->checkcount == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -568,7 +568,7 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( e->checkcount != tw->checkCount ) {
 				e->sideSet = 0;
 			}
 			// pluecker coordinate for edge
@@ -577,7 +577,7 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 
 			v = &tw->model->vertices[e->vertexNum[INT32_SIGNBITSET( edgeNum )]];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( v->checkcount != tw->checkCount ) {
 				v->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
@@ -607,11 +607,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( e->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -621,11 +621,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( v->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -722,17 +722,35 @@ void idCollisionModelManagerLocal::SetupTranslationHeartPlanes( cm_traceWork_t *
 
 /*
 ================
-idCollisionModelManagerLocal::Translation
+idCollisionModelManagerLocal::NextCheckCount
+
+Every context steps its check count by the number of contexts so the counts
+of contexts running at the same time never overlap.
+================
+*/
+int idCollisionModelManagerLocal::NextCheckCount( cm_traceContext_t *context ) {
+	if ( context == NULL ) {
+		assert( numParallelContexts == 0 );
+		return ++checkCount;
+	}
+	context->checkCount += CM_MAX_TRACE_CONTEXTS;
+	return context->checkCount;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ContextTranslation
+
+The context is NULL for the regular queries.
 ================
 */
 #ifdef _DEBUG
 static int entered = 0;
 #endif
 
-void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
+void idCollisionModelManagerLocal::ContextTranslation( cm_traceContext_t *context, cm_traceWork_t &tw, trace_t *results, const idVec3 &start, const idVec3 &end,
 										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
-
 	int i, j;
 	float dist;
 	bool model_rotated, trm_rotated;
@@ -741,7 +759,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_model_t *cmodel;
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof( trace_t )) );
@@ -750,24 +768,33 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	memset( results, 0, sizeof( *results ) );
 
 	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
-		common->Printf("idCollisionModelManagerLocal::Translation: invalid model handle\n");
+		if ( context != NULL ) {
+			context->numInvalidModels++;
+		} else {
+			common->Printf("idCollisionModelManagerLocal::Translation: invalid model handle\n");
+		}
 		return;
 	}
-	if ( !idCollisionModelManagerLocal::models[model] ) {
-		common->Printf("idCollisionModelManagerLocal::Translation: invalid model\n");
+	cmodel = ( context != NULL ) ? context->models[model] : idCollisionModelManagerLocal::models[model];
+	if ( !cmodel ) {
+		if ( context != NULL ) {
+			context->numInvalidModels++;
+		} else {
+			common->Printf("idCollisionModelManagerLocal::Translation: invalid model\n");
+		}
 		return;
 	}
 
 	// if case special position test
 	if ( start[0] == end[0] && start[1] == end[1] && start[2] == end[2] ) {
-		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+		idCollisionModelManagerLocal::ContentsTrm( context, results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 		return;
 	}
 
 #ifdef _DEBUG
 	bool startsolid = false;
 	// test whether or not stuck to begin with
-	if ( cm_debugCollision.GetBool() ) {
+	if ( cm_debugCollision.GetBool() && context == NULL ) {
 		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
 			entered = 1;
 			// if already messed up to begin with
@@ -779,8 +806,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
-
+	tw.checkCount = idCollisionModelManagerLocal::NextCheckCount( context );
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -793,7 +819,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.contacts = idCollisionModelManagerLocal::contacts;
 	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = cmodel;
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -856,7 +882,9 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		if ( tw.getContacts ) {
+			idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		}
 		return;
 	}
 
@@ -868,6 +896,10 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		results->c.normal = vec3_origin;
 		results->c.material = NULL;
 		results->c.point = start;
+		if ( context != NULL ) {
+			context->numHugeTranslations++;
+			return;
+		}
 		if ( common->RW() ) {
 			common->RW()->DebugArrow( colorRed, start, end, 1 );
 		}
@@ -1067,7 +1099,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 
 #ifdef _DEBUG
 	// test for missed collisions
-	if ( cm_debugCollision.GetBool() ) {
+	if ( cm_debugCollision.GetBool() && context == NULL ) {
 		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
 			entered = 1;
 			// if the trm is stuck in the model
@@ -1084,3 +1116,87 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 }
+
+/*
+================
+idCollisionModelManagerLocal::Translation
+================
+*/
+void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
+										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	ALIGN16( static cm_traceWork_t tw );
+
+	ContextTranslation( NULL, tw, results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+}
+
+/*
+================
+idCollisionModelManagerLocal::BeginParallelTranslations
+================
+*/
+void idCollisionModelManagerLocal::BeginParallelTranslations( int numContexts ) {
+	assert( numParallelContexts == 0 );
+	assert( !getContacts );
+
+	UpdateTraceContexts( numContexts );
+
+	for ( int i = 0; i < numContexts; i++ ) {
+		traceContexts[i]->checkCount = checkCount + i;
+	}
+	numParallelContexts = numContexts;
+}
+
+/*
+================
+idCollisionModelManagerLocal::EndParallelTranslations
+================
+*/
+void idCollisionModelManagerLocal::EndParallelTranslations() {
+	assert( numParallelContexts > 0 );
+
+	for ( int i = 0; i < numParallelContexts; i++ ) {
+		cm_traceContext_t *context = traceContexts[i];
+
+		// continue past all the check counts used by the contexts
+		checkCount = Max( checkCount, context->checkCount );
+
+		// the contexts may have been used on other threads, so report their problems here
+		if ( context->numInvalidModels > 0 ) {
+			common->Printf( "idCollisionModelManagerLocal::ParallelTranslation: %d translations against an invalid model\n", context->numInvalidModels );
+			context->numInvalidModels = 0;
+		}
+		if ( context->numHugeTranslations > 0 ) {
+			common->Printf( "idCollisionModelManagerLocal::ParallelTranslation: %d huge translations\n", context->numHugeTranslations );
+			context->numHugeTranslations = 0;
+		}
+	}
+	numParallelContexts = 0;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ParallelSetupTrmModel
+================
+*/
+cmHandle_t idCollisionModelManagerLocal::ParallelSetupTrmModel( int traceContext, const idTraceModel &trm, const idMaterial *material ) {
+	assert( traceContext >= 0 && traceContext < numParallelContexts );
+
+	cm_traceContext_t *context = traceContexts[traceContext];
+	SetupTrmModel( context->models[TRACE_MODEL_HANDLE], context->trmPolygons, context->trmBrushes, trm, material );
+	return TRACE_MODEL_HANDLE;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ParallelTranslation
+================
+*/
+void idCollisionModelManagerLocal::ParallelTranslation( int traceContext, trace_t *results, const idVec3 &start, const idVec3 &end,
+										const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	assert( traceContext >= 0 && traceContext < numParallelContexts );
+
+	cm_traceContext_t *context = traceContexts[traceContext];
+	ContextTranslation( context, context->tw, results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+}
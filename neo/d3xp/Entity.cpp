@@ -3134,79 +3134,64 @@ void idEntity::RemoveContactEntity( idEntity *ent ) {
 
 /*
 ============
-idEntity::CanDamage
+idEntity::GetDamageTestPoints
 
-Returns true if the inflictor can directly damage the target.  Used for
-explosions and melee attacks.
+Returns the points CanDamage traces to, in the order they are tested.
 ============
 */
-bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
-	idVec3 	dest;
-	trace_t	tr;
+void idEntity::GetDamageTestPoints( idVec3 points[NUM_DAMAGE_TEST_POINTS] ) const {
 	idVec3 	midpoint;
 
 	// use the midpoint of the bounds instead of the origin, because
 	// bmodels may have their origin at 0,0,0
 	midpoint = ( GetPhysics()->GetAbsBounds()[0] + GetPhysics()->GetAbsBounds()[1] ) * 0.5;
 
-	dest = midpoint;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[0] = midpoint;
 
 	// this should probably check in the plane of projection, rather than in world coordinate
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[1] = midpoint;
+	points[1][0] += 15.0;
+	points[1][1] += 15.0;
 
-	dest = midpoint;
-	dest[0] += 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[2] = midpoint;
+	points[2][0] += 15.0;
+	points[2][1] -= 15.0;
 
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[3] = midpoint;
+	points[3][0] -= 15.0;
+	points[3][1] += 15.0;
 
-	dest = midpoint;
-	dest[0] -= 15.0;
-	dest[1] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[4] = midpoint;
+	points[4][0] -= 15.0;
+	points[4][1] -= 15.0;
 
-	dest = midpoint;
-	dest[2] += 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
-	}
+	points[5] = midpoint;
+	points[5][2] += 15.0;
 
-	dest = midpoint;
-	dest[2] -= 15.0;
-	gameLocal.clip.TracePoint( tr, origin, dest, MASK_SOLID, NULL );
-	if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
-		damagePoint = tr.endpos;
-		return true;
+	points[6] = midpoint;
+	points[6][2] -= 15.0;
+}
+
+/*
+============
+idEntity::CanDamage
+
+Returns true if the inflictor can directly damage the target.  Used for
+explosions and melee attacks.
+============
+*/
+bool idEntity::CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const {
+	idVec3 	points[NUM_DAMAGE_TEST_POINTS];
+	trace_t	tr;
+
+	GetDamageTestPoints( points );
+
+	for ( int i = 0; i < NUM_DAMAGE_TEST_POINTS; i++ ) {
+		gameLocal.clip.TracePoint( tr, origin, points[i], MASK_SOLID, NULL );
+		if ( tr.fraction == 1.0 || ( gameLocal.GetTraceEntity( tr ) == this ) ) {
+			damagePoint = tr.endpos;
+			return true;
+		}
 	}
 
 	return false;
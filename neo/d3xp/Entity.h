@@ -369,6 +369,9 @@ public:
 	virtual void			RemoveContactEntity( idEntity *ent );
 
 	// damage
+	static const int		NUM_DAMAGE_TEST_POINTS = 7;
+							// returns the points that are traced to from the origin of the damage, in the order CanDamage tests them
+	void					GetDamageTestPoints( idVec3 points[NUM_DAMAGE_TEST_POINTS] ) const;
 							// returns true if this entity can be damaged from the given origin
 	virtual bool			CanDamage( const idVec3 &origin, idVec3 &damagePoint ) const;
 							// applies damage to this entity
@@ -216,6 +216,7 @@ void idGameLocal::Clear() {
 	random.SetSeed( 0 );
 	world = NULL;
 	frameCommandThread = NULL;
+	animFrameJobList = NULL;
 	testmodel = NULL;
 	testFx = NULL;
 	clip.Shutdown();
@@ -324,6 +325,8 @@ void idGameLocal::Init() {
 
 	InitConsoleCommands();
 
+	animFrameJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_HIGH, MAX_ANIM_FRAME_JOBS, 0, NULL );
+
 	shellHandler = new (TAG_SWF) idMenuHandler_Shell();
 
 	if(!g_xp_bind_run_once.GetBool()) {
@@ -392,6 +395,13 @@ void idGameLocal::Shutdown() {
 
 	idEvent::Shutdown();
 
+	if ( animFrameJobList != NULL ) {
+		parallelJobManager->FreeJobList( animFrameJobList );
+		animFrameJobList = NULL;
+	}
+	animFrames.Clear();
+	animFrameJoints.Clear();
+
 	delete[] locationEntities;
 	locationEntities = NULL;
 
@@ -2229,6 +2239,97 @@ void idGameLocal::RunTimeGroup2( idUserCmdMgr & userCmdMgr ) {
 	SelectTimeGroup( false );
 }
 
+/*
+================
+AnimFrameJob
+================
+*/
+static void AnimFrameJob( animFrameJob_t *job ) {
+	for ( int i = 0; i < job->numFrames; i++ ) {
+		const animFrame_t &frame = job->frames[ i ];
+		frame.animator->CreateFrame( frame.time, job->jointArena + frame.firstJoint );
+	}
+}
+
+REGISTER_PARALLEL_JOB( AnimFrameJob, "AnimFrameJob" );
+
+/*
+================
+idGameLocal::RunAnimFrames
+
+Creates the frames of the animated entities in the player PVS that will need
+a new frame for this game frame.  Otherwise the first joint query or the
+renderer callback creates each frame one at a time on the game or render
+thread.  Each animator only writes its own joints and the joint arena slice
+it was given, so the frames are spread over jobs that are balanced by the
+number of joints.
+================
+*/
+void idGameLocal::RunAnimFrames() {
+	idEntity *ent;
+	idAnimator *animator;
+	int i, numJoints;
+
+	animFrames.SetNum( 0 );
+	numJoints = 0;
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( ent->GetModelDefHandle() == -1 || ent->GetRenderEntity()->callback != idEntity::ModelCallback ) {
+			continue;
+		}
+		animator = ent->GetAnimator();
+		if ( animator == NULL || !InPlayerPVS( ent ) ) {
+			continue;
+		}
+		const int frameTime = GetTimeGroupTime( ent->GetRenderEntity()->timeGroup );
+		if ( !animator->NeedsFrame( frameTime ) ) {
+			continue;
+		}
+		animFrame_t &frame = animFrames.Alloc();
+		frame.animator = animator;
+		frame.time = frameTime;
+		frame.firstJoint = numJoints;
+		numJoints += animator->ModelDef()->Joints().Num();
+	}
+
+	const int numFrames = animFrames.Num();
+	if ( numFrames == 0 ) {
+		return;
+	}
+
+	if ( animFrameJoints.Num() < numJoints ) {
+		animFrameJoints.SetNum( numJoints );
+	}
+
+	// don't bother with jobs for a handful of frames
+	const int minFramesPerJob = Max( g_parallelAnimMinFrames.GetInteger(), 1 );
+	const int numJobs = Min( ( numFrames + minFramesPerJob - 1 ) / minFramesPerJob, MAX_ANIM_FRAME_JOBS );
+	const int jointsPerJob = ( numJoints + numJobs - 1 ) / numJobs;
+
+	int numSubmitted = 0;
+	for ( i = 0; i < numFrames; numSubmitted++ ) {
+		animFrameJob_t &job = animFrameJobs[ numSubmitted ];
+		job.frames = animFrames.Ptr() + i;
+		job.numFrames = 0;
+		job.jointArena = animFrameJoints.Ptr();
+
+		const int lastJoint = ( numSubmitted + 1 ) * jointsPerJob;
+		while ( i < numFrames && ( job.numFrames == 0 || animFrames[ i ].firstJoint < lastJoint || numSubmitted == numJobs - 1 ) ) {
+			job.numFrames++;
+			i++;
+		}
+	}
+
+	if ( numSubmitted == 1 ) {
+		AnimFrameJob( &animFrameJobs[ 0 ] );
+	} else {
+		for ( i = 0; i < numSubmitted; i++ ) {
+			animFrameJobList->AddJob( (jobRun_t)AnimFrameJob, &animFrameJobs[ i ] );
+		}
+		animFrameJobList->Submit();
+		animFrameJobList->Wait();
+	}
+}
+
 /*
 ================
 idGameLocal::RunEntityThink
@@ -2435,6 +2536,11 @@ void idGameLocal::RunFrame( idUserCmdMgr & cmdMgr, gameReturn_t & ret ) {
 
 		timer_events.Stop();
 
+		// create the animation frames that are going to be needed on the job threads
+		if ( g_parallelAnimFrames.GetBool() && g_debugAnim.GetInteger() == -1 ) {
+			RunAnimFrames();
+		}
+
 		// free the player pvs
 		FreePlayerPVS();
 
@@ -3804,9 +3910,19 @@ idActor *idGameLocal::GetAlertEntity() {
 	return NULL;
 }
 
+typedef struct {
+	idEntity *				ent;
+	float					dist;				// distance from the edge of the bounding box
+	idVec3					points[ idEntity::NUM_DAMAGE_TEST_POINTS ];
+	bool					canDamage;
+} radiusDamageTarget_t;
+
 /*
 ============
 idGameLocal::RadiusDamage
+
+The entities in range are found first and their line of sight to the
+origin is tested before any of them takes damage.
 ============
 */
 void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEntity *attacker, idEntity *ignoreDamage, idEntity *ignorePush, const char *damageDefName, float dmgPower ) {
@@ -3815,7 +3931,7 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 	idEntity *	entityList[ MAX_GENTITIES ];
 	int			numListedEntities;
 	idBounds	bounds;
-	idVec3 		v, damagePoint, dir;
+	idVec3 		v, dir;
 	int			i, e, damage, radius, push;
 
 	const idDict *damageDef = FindEntityDefDict( damageDefName, false );
@@ -3849,7 +3965,8 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 		ignoreDamage = static_cast<idAFAttachment*>(ignoreDamage)->GetBody();
 	}
 
-	// apply damage to the entities
+	// find the entities in range that can take damage
+	idList< radiusDamageTarget_t > targets;
 	for ( e = 0; e < numListedEntities; e++ ) {
 		ent = entityList[ e ];
 		assert( ent );
@@ -3887,7 +4004,56 @@ void idGameLocal::RadiusDamage( const idVec3 &origin, idEntity *inflictor, idEnt
 			continue;
 		}
 
-		if ( ent->CanDamage( origin, damagePoint ) ) {
+		radiusDamageTarget_t &target = targets.Alloc();
+		target.ent = ent;
+		target.dist = dist;
+		target.canDamage = false;
+		ent->GetDamageTestPoints( target.points );
+	}
+
+	// same tests as idEntity::CanDamage, but each point is traced for all the targets at once so
+	// the traces from the origin share their broadphase queries, and a target stops testing at
+	// the first point it can be damaged at
+	idList< int > remaining;
+	idList< clipTranslation_t > translations;
+	idList< trace_t > traces;
+	remaining.SetNum( targets.Num() );
+	for ( i = 0; i < targets.Num(); i++ ) {
+		remaining[ i ] = i;
+	}
+	for ( int point = 0; point < idEntity::NUM_DAMAGE_TEST_POINTS && remaining.Num() > 0; point++ ) {
+		translations.SetNum( remaining.Num() );
+		traces.SetNum( remaining.Num() );
+		for ( i = 0; i < remaining.Num(); i++ ) {
+			clipTranslation_t &translation = translations[ i ];
+			translation.start = origin;
+			translation.end = targets[ remaining[ i ] ].points[ point ];
+			translation.mdl = NULL;
+			translation.trmAxis = mat3_identity;
+			translation.contentMask = MASK_SOLID;
+			translation.passEntity = NULL;
+		}
+		clip.TranslationBatch( traces.Ptr(), translations.Ptr(), translations.Num() );
+
+		int numRemaining = 0;
+		for ( i = 0; i < remaining.Num(); i++ ) {
+			radiusDamageTarget_t &target = targets[ remaining[ i ] ];
+			const trace_t &tr = traces[ i ];
+			if ( tr.fraction == 1.0 || ( GetTraceEntity( tr ) == target.ent ) ) {
+				target.canDamage = true;
+			} else {
+				remaining[ numRemaining++ ] = remaining[ i ];
+			}
+		}
+		remaining.SetNum( numRemaining );
+	}
+
+	// apply damage to the entities
+	for ( e = 0; e < targets.Num(); e++ ) {
+		ent = targets[ e ].ent;
+		dist = targets[ e ].dist;
+
+		if ( targets[ e ].canDamage ) {
 			// push the center of mass higher than the origin so players
 			// get knocked into the air more
 			dir = ent->GetPhysics()->GetOrigin() - origin;
@@ -189,6 +189,22 @@ private:
 
 //============================================================================
 
+const int MAX_ANIM_FRAME_JOBS		= 32;
+
+typedef struct {
+	idAnimator *			animator;
+	int						time;
+	int						firstJoint;			// offset of the joint buffer in the joint arena
+} animFrame_t;
+
+typedef struct {
+	const animFrame_t *		frames;
+	int						numFrames;
+	idJointQuat *			jointArena;
+} animFrameJob_t;
+
+//============================================================================
+
 template< class type >
 class idEntityPtr {
 public:
@@ -327,6 +343,12 @@ public:
 	void					ComputeSlowScale();
 	void					RunTimeGroup2( idUserCmdMgr & userCmdMgr );
 
+	idParallelJobList *		animFrameJobList;
+	idList<animFrame_t>		animFrames;
+	idList<idJointQuat, TAG_ANIM>	animFrameJoints;	// per frame joint arena the jobs blend into
+	animFrameJob_t			animFrameJobs[ MAX_ANIM_FRAME_JOBS ];
+	void					RunAnimFrames();
+
 	void					ResetSlowTimeVars();
 	void					QuickSlowmoReset();
 
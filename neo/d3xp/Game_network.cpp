@@ -42,6 +42,11 @@ static const int SNAP_ENTITIES_END = SNAP_ENTITIES + MAX_GENTITIES;
 static const int SNAP_LAST_CLIENT_FRAME = SNAP_ENTITIES_END;
 static const int SNAP_LAST_CLIENT_FRAME_END = SNAP_LAST_CLIENT_FRAME + MAX_PLAYERS;
 
+// How fast changed snapshot objects climb when they don't fit a client's snapshot budget
+static const float SNAP_PRIORITY_DEFAULT = 1.0f;
+static const float SNAP_PRIORITY_PLAYER = 4.0f;
+static const float SNAP_PRIORITY_GLOBAL = 16.0f;
+
 /*
 ===============================================================================
 
@@ -56,6 +61,9 @@ idCVar net_clientSmoothing( "net_clientSmoothing", "0.8", CVAR_GAME | CVAR_FLOAT
 idCVar net_clientSelfSmoothing( "net_clientSelfSmoothing", "0.6", CVAR_GAME | CVAR_FLOAT, "smooth self position if network causes prediction error.", 0.0f, 0.95f );
 extern idCVar net_clientMaxPrediction;
 
+idCVar net_snapshotPVS( "net_snapshotPVS", "1", CVAR_GAME | CVAR_BOOL, "only send entities to clients whose players can see them" );
+idCVar net_snapshotCullDistance( "net_snapshotCullDistance", "0", CVAR_GAME | CVAR_FLOAT, "with net_snapshotPVS, also stop sending entities farther than this from a player, 0 = no limit", 0.0f, 65536.0f );
+
 idCVar cg_predictedSpawn_debug( "cg_predictedSpawn_debug", "0", CVAR_BOOL, "Debug predictive spawning of presentables" );
 idCVar g_clientFire_checkLineOfSightDebug( "g_clientFire_checkLineOfSightDebug", "0", CVAR_BOOL, "" );
 
@@ -305,6 +313,61 @@ void idGameLocal::SaveEntityNetworkEvent( const idEntity *ent, int eventId, cons
 	savedEventQueue.Enqueue( event, idEventQueue::OUTOFORDER_IGNORE );
 }
 
+struct snapshotVis_t {
+	pvsHandle_t		pvsHandles[ MAX_PLAYERS ];
+	uint32			playerVisBits[ MAX_PLAYERS ];
+	idEntity *		viewers[ MAX_PLAYERS ];
+	uint32			alwaysVisibleMask;			// peers without a player and the unused bits
+	float			cullDistanceSqr;
+	int				mapSpawnCount;
+};
+
+/*
+================
+SnapshotVisMask
+
+  Returns the snapshot visibility mask of an entity, one bit per
+  client, see idLobby::SubmitPendingSnap for the bit of a peer.
+================
+*/
+static uint32 SnapshotVisMask( idEntity * ent, const snapshotVis_t & vis ) {
+	// The client complains about stale map entities unless they can move between areas
+	if ( ent->entityNumber >= MAX_CLIENTS && ent->entityNumber < vis.mapSpawnCount && !ent->spawnArgs.GetBool( "net_dynamic" ) ) {
+		return ~0U;
+	}
+
+	// Nothing to cull against
+	if ( ent->GetNumPVSAreas() == 0 ) {
+		return ~0U;
+	}
+
+	uint32 visMask = vis.alwaysVisibleMask;
+	for ( int i = 0; i < MAX_PLAYERS; i++ ) {
+		if ( vis.playerVisBits[i] == 0 || ( visMask & vis.playerVisBits[i] ) != 0 ) {
+			continue;
+		}
+
+		// A player always sees itself and everything bound to it
+		idEntity * viewer = vis.viewers[i];
+		if ( ent == viewer || ( ent->GetTeamMaster() != NULL && ent->GetTeamMaster() == viewer->GetTeamMaster() ) ) {
+			visMask |= vis.playerVisBits[i];
+			continue;
+		}
+
+		if ( !ent->PhysicsTeamInPVS( vis.pvsHandles[i] ) ) {
+			continue;
+		}
+
+		if ( vis.cullDistanceSqr > 0.0f && ( ent->GetPhysics()->GetOrigin() - viewer->GetPhysics()->GetOrigin() ).LengthSqr() > vis.cullDistanceSqr ) {
+			continue;
+		}
+
+		visMask |= vis.playerVisBits[i];
+	}
+
+	return visMask;
+}
+
 /*
 ================
 idGameLocal::ServerWriteSnapshot
@@ -322,14 +385,14 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 	// First write the generic game state to the snapshot
 	msg.InitWrite( buffer, sizeof( buffer ) );
 	mpGame.WriteToSnapshot( msg );
-	ss.S_AddObject( SNAP_GAMESTATE, ~0U, msg, "Game State" );
+	ss.S_AddObject( SNAP_GAMESTATE, ~0U, msg, "Game State" )->priority = SNAP_PRIORITY_GLOBAL;
 
 	// Update global shader parameters
 	msg.InitWrite( buffer, sizeof( buffer ) );
 	for ( int i = 0; i < MAX_GLOBAL_SHADER_PARMS; i++ ) {
 		msg.WriteFloat( globalShaderParms[i] );
 	}
-	ss.S_AddObject( SNAP_SHADERPARMS, ~0U, msg, "Shader Parms" );
+	ss.S_AddObject( SNAP_SHADERPARMS, ~0U, msg, "Shader Parms" )->priority = SNAP_PRIORITY_GLOBAL;
 
 	// update portals for opened doors
 	msg.InitWrite( buffer, sizeof( buffer ) );
@@ -338,7 +401,7 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 	for ( int i = 0; i < numPortals; i++ ) {
 		msg.WriteBits( gameRenderWorld->GetPortalState( (qhandle_t) (i+1) ) , NUM_RENDER_PORTAL_BITS );
 	}
-	ss.S_AddObject( SNAP_PORTALS, ~0U, msg, "Portal State" );
+	ss.S_AddObject( SNAP_PORTALS, ~0U, msg, "Portal State" )->priority = SNAP_PRIORITY_GLOBAL;
 
 	idEntity * skyEnt = portalSkyEnt.GetEntity();
 	pvsHandle_t	portalSkyPVS;
@@ -348,8 +411,16 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 	}
 
 	// Build PVS data for each player and write their player state to the snapshot as well
-	pvsHandle_t pvsHandles[ MAX_PLAYERS ];
+	const bool cullEntities = net_snapshotPVS.GetBool() && common->IsMultiplayer();
+	snapshotVis_t vis;
+	vis.alwaysVisibleMask = ~0U;
+	vis.cullDistanceSqr = Square( net_snapshotCullDistance.GetFloat() );
+	vis.mapSpawnCount = mapSpawnCount;
+	pvsHandle_t * pvsHandles = vis.pvsHandles;
 	for ( int i = 0; i < MAX_PLAYERS; i++ ) {
+		vis.playerVisBits[i] = 0;
+		vis.viewers[i] = NULL;
+
 		idPlayer * player = static_cast<idPlayer *>( entities[ i ] );
 		if ( player == NULL ) {
 			pvsHandles[i].i = -1;
@@ -362,7 +433,7 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 
 		msg.InitWrite( buffer, sizeof( buffer ) );
 		spectated->WritePlayerStateToSnapshot( msg );
-		ss.S_AddObject( SNAP_PLAYERSTATE + i, ~0U, msg, "Player State" );
+		ss.S_AddObject( SNAP_PLAYERSTATE + i, ~0U, msg, "Player State" )->priority = SNAP_PRIORITY_GLOBAL;
 
 		int sourceAreas[ idEntity::MAX_PVS_AREAS ];
 		int numSourceAreas = gameRenderWorld->BoundsInAreas( spectated->GetPlayerPhysics()->GetAbsBounds(), sourceAreas, idEntity::MAX_PVS_AREAS );
@@ -373,18 +444,31 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 			pvsHandles[i] = tempPVS;
 		}
 
+		if ( common->IsMultiplayer() ) {
+			// Players of the host have no peer, the host never reads snapshots
+			const int peerIndex = session->GetActingGameStateLobbyBase().PeerIndexFromLobbyUser( lobbyUserIDs[i] );
+			if ( peerIndex >= 0 && peerIndex + 1 < idSnapShot::MAX_VIS_INDEX ) {
+				ss.SetViewOrigin( peerIndex + 1, spectated->GetPhysics()->GetOrigin() );
+				if ( cullEntities ) {
+					vis.playerVisBits[i] = (uint32)BIT( peerIndex + 1 );
+					vis.alwaysVisibleMask &= ~vis.playerVisBits[i];
+					vis.viewers[i] = spectated;
+				}
+			}
+		}
+
 		// Write the last usercmd processed by the server so that clients know
 		// when to stop predicting.
 		msg.BeginWriting();
 		msg.WriteLong( usercmdLastClientMilliseconds[i] );
-		ss.S_AddObject( SNAP_LAST_CLIENT_FRAME + i, ~0U, msg, "Last client frame" );
+		ss.S_AddObject( SNAP_LAST_CLIENT_FRAME + i, ~0U, msg, "Last client frame" )->priority = SNAP_PRIORITY_GLOBAL;
 	}
 
 	if ( portalSkyPVS.i >= 0 ) {
 		pvs.FreeCurrentPVS( portalSkyPVS );
 	}
 
-	// Add all entities to the snapshot
+	// Add all entities to the snapshot, entities a client can't see go stale for that client
 	for ( idEntity * ent = spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
 		if ( ent->GetSkipReplication() ) {
 			continue;
@@ -402,7 +486,11 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot & ss ) {
 			ent->WriteToSnapshot( msg );
 		}
 
-		ss.S_AddObject( SNAP_ENTITIES + ent->entityNumber, ~0U, msg, ent->GetName() );
+		const uint32 visMask = cullEntities ? SnapshotVisMask( ent, vis ) : ~0U;
+		idSnapShot::objectState_t * state = ss.S_AddObject( SNAP_ENTITIES + ent->entityNumber, visMask, msg, ent->GetName() );
+		state->priority = ent->IsType( idPlayer::Type ) ? SNAP_PRIORITY_PLAYER : SNAP_PRIORITY_DEFAULT;
+		state->origin = ent->GetPhysics()->GetOrigin();
+		state->hasOrigin = true;
 	}
 
 	// Free PVS handles for all the players
@@ -111,6 +111,7 @@ void idSmokeParticles::Shutdown() {
 		renderModelManager->FreeModel( renderEntity.hModel );
 		renderEntity.hModel = NULL;
 	}
+	spawns.Clear();
 	initialized = false;
 }
 
@@ -318,6 +319,8 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const r
 
 	g.renderEnt = renderEntity;
 	g.renderView = renderView;
+	g.origin.Zero();
+	g.axis.Identity();
 
 	for ( int activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ ) {
 		singleSmoke_t *smoke, *next, *last;
@@ -347,17 +350,18 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const r
 		tri->bounds[1][1] =
 		tri->bounds[1][2] = 99999;
 
-		tri->numVerts = 0;
+		spawns.SetNum( 0 );
 		for ( last = NULL, smoke = active->smokes; smoke; smoke = next ) {
 			next = smoke->next;
 
+			float frac;
 			if ( smoke->timeGroup ) {
-				g.frac = (float)( gameLocal.fast.time - smoke->privateStartTime ) / (stage->particleLife * 1000);
+				frac = (float)( gameLocal.fast.time - smoke->privateStartTime ) / (stage->particleLife * 1000);
 			}
 			else {
-				g.frac = (float)( gameLocal.time - smoke->privateStartTime ) / (stage->particleLife * 1000);
+				frac = (float)( gameLocal.time - smoke->privateStartTime ) / (stage->particleLife * 1000);
 			}
-			if ( g.frac >= 1.0f ) {
+			if ( frac >= 1.0f ) {
 				// remove the particle from the stage list
 				if ( last != NULL ) {
 					last->next = smoke->next;
@@ -371,19 +375,16 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s *renderEntity, const r
 				continue;
 			}
 
-			g.index = smoke->index;
-			g.random = smoke->random;
-
-			g.origin = smoke->origin;
-			g.axis = smoke->axis;
-
-			g.originalRandom = g.random;
-			g.age = g.frac * stage->particleLife;
-
-			tri->numVerts += stage->CreateParticle( &g, tri->verts + tri->numVerts );
+			particleSpawn_t &spawn = spawns.Alloc();
+			spawn.index = smoke->index;
+			spawn.frac = frac;
+			spawn.random = smoke->random;
+			spawn.origin = &smoke->origin;
+			spawn.axis = &smoke->axis;
 
 			last = smoke;
 		}
+		tri->numVerts = stage->CreateParticles( &g, spawns.Ptr(), spawns.Num(), tri->verts );
 		if ( tri->numVerts > quads * 4 ) {
 			gameLocal.Error( "idSmokeParticles::UpdateRenderEntity: miscounted verts" );
 		}
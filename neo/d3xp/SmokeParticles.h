@@ -95,6 +95,7 @@ private:
 	singleSmoke_t *				freeSmokes;
 	int							numActiveSmokes;
 	int							currentParticleTime;	// don't need to recalculate if == view time
+	idList<particleSpawn_t, TAG_PARTICLE>	spawns;				// live particles of the stage being updated
 
 	bool						UpdateRenderEntity( renderEntity_s *renderEntity, const renderView_t *renderView );
 	static bool					ModelCallback( renderEntity_s *renderEntity, const renderView_t *renderView );
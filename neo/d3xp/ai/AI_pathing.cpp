@@ -1350,15 +1350,19 @@ static float HeightForTrajectory( const idVec3 &start, float zVel, float gravity
 }
 #endif
 
+static const int TRAJECTORY_TRACE_BATCH = 2;		// number of trajectory segments traced together
+
 /*
 =====================
 idAI::TestTrajectory
 =====================
 */
 bool idAI::TestTrajectory( const idVec3 &start, const idVec3 &end, float zVel, float gravity, float time, float max_height, const idClipModel *clip, int clipmask, const idEntity *ignore, const idEntity *targetEntity, int drawtime ) {
-	int i, numSegments;
+	int i, j, numSegments;
 	float maxHeight, t, t2;
 	idVec3 points[5];
+	clipTranslation_t segments[TRAJECTORY_TRACE_BATCH];
+	trace_t traces[TRAJECTORY_TRACE_BATCH];
 	trace_t trace;
 	bool result;
 
@@ -1410,10 +1414,28 @@ bool idAI::TestTrajectory( const idVec3 &start, const idVec3 &end, float zVel, f
 		}
 	}
 
+	// trace the segments in pairs so neighbouring segments share a broadphase query,
+	// but stop at the first blocked pair instead of tracing the whole trajectory
 	result = true;
-	for ( i = 0; i < numSegments; i++ ) {
-		gameLocal.clip.Translation( trace, points[i], points[i+1], clip, mat3_identity, clipmask, ignore );
-		if ( trace.fraction < 1.0f ) {
+	for ( i = 0; i < numSegments; i += TRAJECTORY_TRACE_BATCH ) {
+		int numBatch = Min( numSegments - i, TRAJECTORY_TRACE_BATCH );
+		for ( j = 0; j < numBatch; j++ ) {
+			segments[j].start = points[i+j];
+			segments[j].end = points[i+j+1];
+			segments[j].mdl = clip;
+			segments[j].trmAxis = mat3_identity;
+			segments[j].contentMask = clipmask;
+			segments[j].passEntity = ignore;
+		}
+		gameLocal.clip.TranslationBatch( traces, segments, numBatch );
+
+		for ( j = 0; j < numBatch; j++ ) {
+			trace = traces[j];
+			if ( trace.fraction < 1.0f ) {
+				break;
+			}
+		}
+		if ( j < numBatch ) {
 			if ( gameLocal.GetTraceEntity( trace ) == targetEntity ) {
 				result = true;
 			} else {
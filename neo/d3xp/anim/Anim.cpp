@@ -34,10 +34,10 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar binaryLoadAnim( "binaryLoadAnim", "1", 0, "enable binary load/write of idMD5Anim" );
 
-static const byte B_ANIM_MD5_VERSION = 101;
+static const byte B_ANIM_MD5_VERSION = 102;
 static const unsigned int B_ANIM_MD5_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | B_ANIM_MD5_VERSION;
 
-static const int JOINT_FRAME_PAD	= 1;	// one extra to be able to read one more float than is necessary
+static const int COMPONENT_QUANT_MAX	= 65535;	// components are quantized to 16 bits over their range in the animation
 
 bool idAnimManager::forceExport = false;
 
@@ -59,6 +59,7 @@ idMD5Anim::idMD5Anim() {
 	frameRate	= 24;
 	animLength	= 0;
 	numAnimatedComponents = 0;
+	componentStride = 0;
 	totaldelta.Zero();
 }
 
@@ -82,6 +83,7 @@ void idMD5Anim::Free() {
 	frameRate	= 24;
 	animLength	= 0;
 	numAnimatedComponents = 0;
+	componentStride = 0;
 	//name		= "";
 
 	totaldelta.Zero();
@@ -89,6 +91,8 @@ void idMD5Anim::Free() {
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	componentBias.Clear();
+	componentScale.Clear();
 }
 
 /*
@@ -156,7 +160,7 @@ idMD5Anim::Allocated
 ====================
 */
 size_t idMD5Anim::Allocated() const {
-	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size_t	size = bounds.Allocated() + jointInfo.Allocated() + baseFrame.Allocated() + componentFrames.Allocated() + componentBias.Allocated() + componentScale.Allocated() + name.Allocated();
 	return size;
 }
 
@@ -293,11 +297,11 @@ bool idMD5Anim::LoadAnim( const char * filename ) {
 	parser.ExpectTokenString( "}" );
 
 	// parse frames
-	componentFrames.SetGranularity( 1 );
-	componentFrames.SetNum( numAnimatedComponents * numFrames + JOINT_FRAME_PAD );
-	componentFrames[numAnimatedComponents * numFrames + JOINT_FRAME_PAD - 1] = 0.0f;
+	idList<float, TAG_MD5_ANIM> frames;
+	frames.SetGranularity( 1 );
+	frames.SetNum( numAnimatedComponents * numFrames );
 
-	float *componentPtr = componentFrames.Ptr();
+	float *componentPtr = frames.Ptr();
 	for ( int i = 0; i < numFrames; i++ ) {
 		parser.ExpectTokenString( "frame" );
 		int num = parser.ParseInt();
@@ -317,7 +321,7 @@ bool idMD5Anim::LoadAnim( const char * filename ) {
 	if ( !numAnimatedComponents ) {
 		totaldelta.Zero();
 	} else {
-		componentPtr = &componentFrames[ jointInfo[ 0 ].firstComponent ];
+		componentPtr = &frames[ jointInfo[ 0 ].firstComponent ];
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			for ( int i = 0; i < numFrames; i++ ) {
 				componentPtr[ numAnimatedComponents * i ] -= baseFrame[ 0 ].t.x;
@@ -347,6 +351,8 @@ bool idMD5Anim::LoadAnim( const char * filename ) {
 	}
 	baseFrame[ 0 ].t.Zero();
 
+	CompressFrames( frames.Ptr() );
+
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
@@ -428,11 +434,15 @@ bool idMD5Anim::LoadBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 		j.w = 0.0f;
 	}
 
+	file->ReadBig( componentStride );
+	componentBias.SetNum( componentStride );
+	componentScale.SetNum( componentStride );
+	file->ReadBigArray( componentBias.Ptr(), componentStride );
+	file->ReadBigArray( componentScale.Ptr(), componentStride );
+
 	file->ReadBig( num );
-	componentFrames.SetNum( num + JOINT_FRAME_PAD );
-	for ( int i = 0; i < componentFrames.Num(); i++ ) {
-		file->ReadFloat( componentFrames[i] );
-	}
+	componentFrames.SetNum( num );
+	file->ReadBigArray( componentFrames.Ptr(), num );
 
 	//file->ReadString( name );
 	file->ReadVec3( totaldelta );
@@ -488,16 +498,158 @@ void idMD5Anim::WriteBinary( idFile * file, ID_TIME_T sourceTimeStamp ) {
 		file->WriteVec3( j.t );
 	}
 
-	file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
-	for ( int i = 0; i < componentFrames.Num(); i++ ) {
-		file->WriteFloat( componentFrames[i] );
-	}
+	file->WriteBig( componentStride );
+	file->WriteBigArray( componentBias.Ptr(), componentStride );
+	file->WriteBigArray( componentScale.Ptr(), componentStride );
+
+	file->WriteBig( componentFrames.Num() );
+	file->WriteBigArray( componentFrames.Ptr(), componentFrames.Num() );
 
 	//file->WriteString( name );
 	file->WriteVec3( totaldelta );
 	//file->WriteBig( ref_count );
 }
 
+/*
+========================
+idMD5Anim::CompressFrames
+
+Components that are the same in every frame are folded into the base frame
+and the others are quantized to 16 bits over their range in the animation.
+The frames are padded to a multiple of 8 components so DecodeFrame can
+dequantize them 8 at a time.
+========================
+*/
+void idMD5Anim::CompressFrames( const float *frames ) {
+	idList<float> minComponent;
+	idList<float> maxComponent;
+	idList<int> remap;
+
+	minComponent.SetNum( numAnimatedComponents );
+	maxComponent.SetNum( numAnimatedComponents );
+	remap.SetNum( numAnimatedComponents );
+
+	for ( int i = 0; i < numAnimatedComponents; i++ ) {
+		minComponent[i] = maxComponent[i] = frames[i];
+		for ( int j = 1; j < numFrames; j++ ) {
+			const float value = frames[ numAnimatedComponents * j + i ];
+			minComponent[i] = Min( minComponent[i], value );
+			maxComponent[i] = Max( maxComponent[i], value );
+		}
+	}
+
+	int numComponents = 0;
+	for ( int i = 0; i < numJoints; i++ ) {
+		jointAnimInfo_t &info = jointInfo[ i ];
+		const int animBits = info.animBits;
+		int component = info.firstComponent;
+
+		info.firstComponent = numComponents;
+		for ( int j = ANIM_BIT_TX; j <= ANIM_BIT_QZ; j++ ) {
+			if ( !( animBits & BIT( j ) ) ) {
+				continue;
+			}
+			if ( minComponent[ component ] == maxComponent[ component ] ) {
+				// constant over the whole animation
+				if ( j < ANIM_BIT_QX ) {
+					baseFrame[ i ].t[ j - ANIM_BIT_TX ] = minComponent[ component ];
+				} else {
+					baseFrame[ i ].q[ j - ANIM_BIT_QX ] = minComponent[ component ];
+				}
+				info.animBits &= ~BIT( j );
+				remap[ component ] = -1;
+			} else {
+				remap[ component ] = numComponents++;
+			}
+			component++;
+		}
+
+		// the decode no longer calculates w if none of the rotation components are left
+		if ( ( animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) && !( info.animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) ) {
+			baseFrame[ i ].q.w = baseFrame[ i ].q.CalcW();
+		}
+	}
+
+	componentStride = ( numComponents + 7 ) & ~7;
+
+	componentBias.SetGranularity( 1 );
+	componentBias.SetNum( componentStride );
+	componentScale.SetGranularity( 1 );
+	componentScale.SetNum( componentStride );
+	componentFrames.SetGranularity( 1 );
+	componentFrames.SetNum( numFrames * componentStride );
+
+	// the padding decodes to zero
+	memset( componentBias.Ptr(), 0, componentBias.Allocated() );
+	memset( componentScale.Ptr(), 0, componentScale.Allocated() );
+	memset( componentFrames.Ptr(), 0, componentFrames.Allocated() );
+
+	for ( int i = 0; i < numAnimatedComponents; i++ ) {
+		const int c = remap[ i ];
+		if ( c < 0 ) {
+			continue;
+		}
+		componentBias[ c ] = minComponent[ i ];
+		componentScale[ c ] = ( maxComponent[ i ] - minComponent[ i ] ) / COMPONENT_QUANT_MAX;
+		const float invScale = 1.0f / componentScale[ c ];
+		for ( int j = 0; j < numFrames; j++ ) {
+			const float value = frames[ numAnimatedComponents * j + i ];
+			componentFrames[ componentStride * j + c ] = (unsigned short)idMath::ClampInt( 0, COMPONENT_QUANT_MAX, idMath::Ftoi( ( value - minComponent[ i ] ) * invScale + 0.5f ) );
+		}
+	}
+
+	numAnimatedComponents = numComponents;
+}
+
+/*
+====================
+idMD5Anim::DecodeFrame
+
+  dequantizes all components of a frame, components needs to be 16 byte aligned with room for componentStride floats
+====================
+*/
+void idMD5Anim::DecodeFrame( int framenum, float *components ) const {
+	const unsigned short *quantized = &componentFrames[ framenum * componentStride ];
+	const float *bias = componentBias.Ptr();
+	const float *scale = componentScale.Ptr();
+
+	assert_16_byte_aligned( components );
+
+#ifdef ID_X86_SSE2_INTRIN
+	const __m128i zero = _mm_setzero_si128();
+	for ( int i = 0; i < componentStride; i += 8 ) {
+		const __m128i q = _mm_load_si128( (const __m128i *)( quantized + i ) );
+		const __m128 q0 = _mm_cvtepi32_ps( _mm_unpacklo_epi16( q, zero ) );
+		const __m128 q1 = _mm_cvtepi32_ps( _mm_unpackhi_epi16( q, zero ) );
+		_mm_store_ps( components + i + 0, _mm_add_ps( _mm_load_ps( bias + i + 0 ), _mm_mul_ps( _mm_load_ps( scale + i + 0 ), q0 ) ) );
+		_mm_store_ps( components + i + 4, _mm_add_ps( _mm_load_ps( bias + i + 4 ), _mm_mul_ps( _mm_load_ps( scale + i + 4 ), q1 ) ) );
+	}
+#else
+	for ( int i = 0; i < numAnimatedComponents; i++ ) {
+		components[i] = bias[i] + scale[i] * quantized[i];
+	}
+#endif
+}
+
+/*
+====================
+idMD5Anim::DecodeJoint
+
+  dequantizes the components of a single joint in a frame, components needs room for 6 floats
+====================
+*/
+void idMD5Anim::DecodeJoint( int framenum, int jointnum, float *components ) const {
+	const jointAnimInfo_t &info = jointInfo[ jointnum ];
+	const unsigned short *quantized = &componentFrames[ framenum * componentStride ];
+	int c = info.firstComponent;
+	for ( int i = ANIM_BIT_TX; i <= ANIM_BIT_QZ; i++ ) {
+		if ( info.animBits & BIT( i ) ) {
+			*components++ = componentBias[ c ] + componentScale[ c ] * quantized[ c ];
+			c++;
+		}
+	}
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -612,8 +764,13 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 6 ];
+	float components2[ 6 ];
+	DecodeJoint( frame.frame1, 0, components1 );
+	DecodeJoint( frame.frame2, 0, components2 );
+
+	const float *componentPtr1 = components1;
+	const float *componentPtr2 = components2;
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -652,8 +809,13 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 6 ];
+	float components2[ 6 ];
+	DecodeJoint( frame.frame1, 0, components1 );
+	DecodeJoint( frame.frame2, 0, components2 );
+
+	const float	*jointframe1 = components1;
+	const float	*jointframe2 = components2;
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -764,8 +926,13 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	idVec3 offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float components1[ 6 ];
+		float components2[ 6 ];
+		DecodeJoint( frame.frame1, 0, components1 );
+		DecodeJoint( frame.frame2, 0, components2 );
+
+		const float *componentPtr1 = components1;
+		const float *componentPtr2 = components2;
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -867,8 +1034,10 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	idJointQuat * blendJoints = (idJointQuat *)_alloca16( baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
 	int * lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 
-	const float * frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
-	const float * frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
+	float * frame1 = (float *)_alloca16( componentStride * sizeof( frame1[ 0 ] ) );
+	float * frame2 = (float *)_alloca16( componentStride * sizeof( frame2[ 0 ] ) );
+	DecodeFrame( frame.frame1, frame1 );
+	DecodeFrame( frame.frame2, frame2 );
 
 	int numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
 
@@ -940,7 +1109,8 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	const float * frame = &componentFrames[framenum * numAnimatedComponents];
+	float * frame = (float *)_alloca16( componentStride * sizeof( frame[ 0 ] ) );
+	DecodeFrame( framenum, frame );
 
 	DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
 }
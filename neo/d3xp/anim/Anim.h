@@ -201,11 +201,18 @@ private:
 	idList<idBounds, TAG_MD5_ANIM>		bounds;
 	idList<jointAnimInfo_t, TAG_MD5_ANIM>	jointInfo;
 	idList<idJointQuat, TAG_MD5_ANIM>		baseFrame;
-	idList<float, TAG_MD5_ANIM>			componentFrames;
+	int						componentStride;		// numAnimatedComponents rounded up to a multiple of 8
+	idList<unsigned short, TAG_MD5_ANIM>	componentFrames;	// quantized components, componentStride per frame
+	idList<float, TAG_MD5_ANIM>			componentBias;		// component = bias + scale * quantized component
+	idList<float, TAG_MD5_ANIM>			componentScale;
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+	void					CompressFrames( const float *frames );
+	void					DecodeFrame( int framenum, float *components ) const;
+	void					DecodeJoint( int framenum, int jointnum, float *components ) const;
+
 public:
 							idMD5Anim();
 							~idMD5Anim();
@@ -491,6 +498,9 @@ public:
 	void						ForceUpdate();
 	void						ClearForceUpdate();
 	bool						CreateFrame( int animtime, bool force );
+								// same as CreateFrame without force but blends into the given joint buffer, safe to run on a job thread
+	bool						CreateFrame( int animtime, idJointQuat *jointFrame );
+	bool						NeedsFrame( int animtime ) const;
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -538,6 +548,7 @@ public:
 private:
 	void						FreeData();
 	void						PushAnims( int channel, int currentTime, int blendTime );
+	bool						BlendFrame( int currentTime, idJointQuat *jointFrame, bool debugInfo );
 
 private:
 	const idDeclModelDef *		modelDef;
@@ -4253,23 +4253,33 @@ bool idAnimator::FrameHasChanged( int currentTime ) const {
 	return false;
 }
 
+/*
+=====================
+idAnimator::NeedsFrame
+
+  returns true if CreateFrame would create a new frame for the given time
+=====================
+*/
+bool idAnimator::NeedsFrame( int currentTime ) const {
+	if ( !modelDef || !modelDef->ModelHandle() ) {
+		return false;
+	}
+	if ( lastTransformTime == currentTime ) {
+		return false;
+	}
+	if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
+		return false;
+	}
+	return true;
+}
+
 /*
 =====================
 idAnimator::CreateFrame
 =====================
 */
 bool idAnimator::CreateFrame( int currentTime, bool force ) {
-	int					i, j;
-	int					numJoints;
-	int					parentNum;
-	bool				hasAnim;
 	bool				debugInfo;
-	float				baseBlend;
-	float				blendWeight;
-	const idAnimBlend *	blend;
-	const int *			jointParent;
-	const jointMod_t *	jointMod;
-	const idJointQuat *	defaultPose;
 
 	static idCVar		r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 
@@ -4278,10 +4288,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 
 	if ( !force && !r_showSkel.GetInteger() ) {
-		if ( lastTransformTime == currentTime ) {
-			return false;
-		}
-		if ( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) ) {
+		if ( !NeedsFrame( currentTime ) ) {
 			return false;
 		}
 	}
@@ -4297,6 +4304,50 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		debugInfo = false;
 	}
 
+	return BlendFrame( currentTime, NULL, debugInfo );
+}
+
+/*
+=====================
+idAnimator::CreateFrame
+
+  Creates the frame the same way as CreateFrame without force but blends into
+  the given buffer of modelDef->Joints().Num() joints instead of the stack.
+  Doesn't print or touch anything outside the animator so it can run on a
+  job thread.
+=====================
+*/
+bool idAnimator::CreateFrame( int currentTime, idJointQuat *jointFrame ) {
+	if ( !NeedsFrame( currentTime ) ) {
+		return false;
+	}
+
+	lastTransformTime = currentTime;
+	stoppedAnimatingUpdate = false;
+
+	return BlendFrame( currentTime, jointFrame, false );
+}
+
+/*
+=====================
+idAnimator::BlendFrame
+
+  blends the channels into jointFrame, or a buffer on the stack if it's NULL,
+  and transforms the result into the joints
+=====================
+*/
+bool idAnimator::BlendFrame( int currentTime, idJointQuat *jointFrame, bool debugInfo ) {
+	int					i, j;
+	int					numJoints;
+	int					parentNum;
+	bool				hasAnim;
+	float				baseBlend;
+	float				blendWeight;
+	const idAnimBlend *	blend;
+	const int *			jointParent;
+	const jointMod_t *	jointMod;
+	const idJointQuat *	defaultPose;
+
 	// init the joint buffer
 	if ( AFPoseJoints.Num() ) {
 		// initialize with AF pose anim for the case where there are no other animations and no AF pose joint modifications
@@ -4311,7 +4362,9 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 
 	numJoints = modelDef->Joints().Num();
-	idJointQuat *jointFrame = ( idJointQuat * )_alloca16( numJoints * sizeof( jointFrame[0] ) );
+	if ( jointFrame == NULL ) {
+		jointFrame = ( idJointQuat * )_alloca16( numJoints * sizeof( jointFrame[0] ) );
+	}
 	memcpy( jointFrame, defaultPose, numJoints * sizeof( jointFrame[0] ) );
 
 	hasAnim = false;
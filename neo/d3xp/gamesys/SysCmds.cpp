@@ -202,6 +202,136 @@ void Cmd_Script_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===================
+ScriptBenchmark_Run
+
+Runs the function to completion the given number of times and returns the
+average time per call in microseconds.
+===================
+*/
+static float ScriptBenchmark_Run( const function_t *func, int iterations, bool threadedDispatch ) {
+	const bool oldThreadedDispatch = g_scriptThreadedDispatch.GetBool();
+	g_scriptThreadedDispatch.SetBool( threadedDispatch );
+
+	idThread *thread = new idThread();
+	thread->ManualDelete();
+	thread->ManualControl();
+	thread->SetThreadName( "scriptBenchmark" );
+
+	uint64 start = Sys_Microseconds();
+	for ( int i = 0; i < iterations; i++ ) {
+		thread->CallFunction( func, true );
+		thread->Execute();
+	}
+	uint64 end = Sys_Microseconds();
+
+	delete thread;
+
+	g_scriptThreadedDispatch.SetBool( oldThreadedDispatch );
+
+	return ( float )( end - start ) / iterations;
+}
+
+/*
+===================
+scriptBenchmark
+
+Times the script interpreter with the switch and with threaded dispatch.  With
+no function name a built in loop of the arithmetic, vector, string, call and
+event opcodes that AI scripts spend their time in is used.
+===================
+*/
+static const char *scriptBenchmarkText =
+	"float scriptBenchmark_step( float f ) {\n"
+	"	return f * 0.5 + 1;\n"
+	"}\n"
+	"void scriptBenchmark_loop() {\n"
+	"	float i;\n"
+	"	float f;\n"
+	"	float d;\n"
+	"	vector v;\n"
+	"	vector dir;\n"
+	"	string s;\n"
+	"	dir = '1 0 0';\n"
+	"	for( i = 0; i < 20000; i++ ) {\n"
+	"		f = scriptBenchmark_step( f ) + i * 0.25;\n"
+	"		v = v + dir * f;\n"
+	"		d = v * dir;\n"
+	"		if ( d > 1000 && f > 10 ) {\n"
+	"			v = '0 0 0';\n"
+	"		}\n"
+	"		if ( ( i % 64 ) == 0 ) {\n"
+	"			s = \"bench \" + i;\n"
+	"			f = sys.sin( f );\n"
+	"		}\n"
+	"	}\n"
+	"}\n";
+
+CONSOLE_COMMAND( scriptBenchmark, "times the script interpreter: [iterations] [function]", 0 ) {
+	if ( !gameLocal.IsInGame() ) {
+		gameLocal.Printf( "scriptBenchmark needs a map to be loaded\n" );
+		return;
+	}
+
+	int iterations = 20;
+	if ( args.Argc() > 1 ) {
+		iterations = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	const char *funcName = "scriptBenchmark_loop";
+	if ( args.Argc() > 2 ) {
+		funcName = args.Argv( 2 );
+	}
+
+	const function_t *func = gameLocal.program.FindFunction( funcName );
+	if ( func == NULL && args.Argc() <= 2 ) {
+		if ( gameLocal.program.CompileText( "scriptBenchmark", scriptBenchmarkText, true ) ) {
+			func = gameLocal.program.FindFunction( funcName );
+		}
+	}
+	if ( func == NULL ) {
+		gameLocal.Printf( "Function '%s' not found\n", funcName );
+		return;
+	}
+	if ( func->eventdef != NULL || func->parmTotal != 0 ) {
+		gameLocal.Printf( "Function '%s' must be a script function without parameters\n", funcName );
+		return;
+	}
+
+	// warm up the caches before timing anything
+	ScriptBenchmark_Run( func, 1, true );
+
+	const float switchTime = ScriptBenchmark_Run( func, iterations, false );
+	const float threadedTime = ScriptBenchmark_Run( func, iterations, true );
+
+	gameLocal.Printf( "%s, %d iterations:\n", funcName, iterations );
+	gameLocal.Printf( "  switch dispatch:   %8.1f usec per call\n", switchTime );
+	gameLocal.Printf( "  threaded dispatch: %8.1f usec per call\n", threadedTime );
+	if ( threadedTime > 0.0f ) {
+		gameLocal.Printf( "  speedup:           %8.2fx\n", switchTime / threadedTime );
+	}
+}
+
+/*
+===================
+clipBenchmark
+===================
+*/
+CONSOLE_COMMAND( clipBenchmark, "times Translation and Contacts queries against the clip models of the current map: [numQueries]", 0 ) {
+	if ( !gameLocal.IsInGame() ) {
+		gameLocal.Printf( "clipBenchmark needs a map to be loaded\n" );
+		return;
+	}
+
+	int numQueries = 10000;
+	if ( args.Argc() > 1 ) {
+		numQueries = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	gameLocal.clip.Benchmark( numQueries );
+}
+
 /*
 ==================
 KillEntities
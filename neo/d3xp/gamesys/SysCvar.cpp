@@ -89,6 +89,11 @@ idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugDamage(				"g_debugDamage",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugWeapon(				"g_debugWeapon",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugScript(				"g_debugScript",			"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_parallelTraceBatches(	"g_parallelTraceBatches",	"1",			CVAR_GAME | CVAR_BOOL, "run batched clip model translations on the job threads" );
+idCVar g_traceBatchMinTraces(	"g_traceBatchMinTraces",	"8",			CVAR_GAME | CVAR_INTEGER, "minimum number of translations per trace batch job" );
+idCVar g_parallelAnimFrames(	"g_parallelAnimFrames",		"1",			CVAR_GAME | CVAR_BOOL, "create the animation frames of the animated entities in the player PVS on the job threads" );
+idCVar g_parallelAnimMinFrames(	"g_parallelAnimMinFrames",	"4",			CVAR_GAME | CVAR_INTEGER, "minimum number of animation frames per job" );
+idCVar g_scriptThreadedDispatch(	"g_scriptThreadedDispatch",	"1",			CVAR_GAME | CVAR_BOOL, "jump directly between script opcode handlers on compilers that support label addresses" );
 idCVar g_debugMover(				"g_debugMover",				"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugTriggers(				"g_debugTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_debugCinematic(			"g_debugCinematic",			"0",			CVAR_GAME | CVAR_BOOL, "" );
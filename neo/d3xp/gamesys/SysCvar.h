@@ -51,6 +51,11 @@ extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_scriptThreadedDispatch;
+extern idCVar	g_parallelTraceBatches;
+extern idCVar	g_traceBatchMinTraces;
+extern idCVar	g_parallelAnimFrames;
+extern idCVar	g_parallelAnimMinFrames;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
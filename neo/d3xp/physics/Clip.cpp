@@ -32,23 +32,32 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
-#define	MAX_SECTOR_DEPTH				12
-#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
-
-typedef struct clipSector_s {
-	int						axis;		// -1 = leaf node
-	float					dist;
-	struct clipSector_s *	children[2];
-	struct clipLink_s *		clipLinks;
-} clipSector_t;
-
-typedef struct clipLink_s {
-	idClipModel *			clipModel;
-	struct clipSector_s *	sector;
-	struct clipLink_s *		prevInSector;
-	struct clipLink_s *		nextInSector;
-	struct clipLink_s *		nextLink;
-} clipLink_t;
+#define GRID_CELL_SIZE					64.0f		// cell size of the finest grid level
+#define GRID_CELL_HASH_SIZE				4096
+#define TRACE_BATCH_GROUP_SIZE			512.0f		// translations share a broadphase query while they fit in a box this size
+#define MAX_TRACE_BATCH_GROUP			64			// maximum number of translations sharing a broadphase query
+
+// the bounds of the models in a cell are stored as six arrays of maxModels
+// floats each, so four models at a time can be tested against a query box
+enum {
+	CELL_MIN_X,
+	CELL_MIN_Y,
+	CELL_MIN_Z,
+	CELL_MAX_X,
+	CELL_MAX_Y,
+	CELL_MAX_Z,
+	CELL_BOUNDS_ARRAYS
+};
+
+typedef struct clipCell_s {
+	int						level;		// -1 = free cell
+	int						coords[3];
+	int						levelIndex;	// index in the list of cells in use on the level, or next free cell
+	int						numModels;
+	int						maxModels;
+	float *					bounds;
+	idClipModel **			models;
+} clipCell_t;
 
 typedef struct trmCache_s {
 	idTraceModel			trm;
@@ -60,7 +69,6 @@ typedef struct trmCache_s {
 
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
-idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
 
 
 /*
@@ -357,8 +365,9 @@ void idClipModel::Init() {
 	collisionModelHandle = 0;
 	renderModelHandle = -1;
 	traceModelIndex = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 }
 
 /*
@@ -433,8 +442,9 @@ idClipModel::idClipModel( const idClipModel *model ) {
 		LoadModel( *GetCachedTraceModel( model->traceModelIndex ) );
 	}
 	renderModelHandle = model->renderModelHandle;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 }
 
 /*
@@ -473,8 +483,8 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
-	savefile->WriteInt( touchCount );
+	savefile->WriteBool( linkedClip != NULL );
+	savefile->WriteInt( -1 );	// was the sector tree touch count
 }
 
 /*
@@ -509,12 +519,14 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	}
 	savefile->ReadInt( renderModelHandle );
 	savefile->ReadBool( linked );
-	savefile->ReadInt( touchCount );
+	int unusedTouchCount;
+	savefile->ReadInt( unusedTouchCount );
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	linkedClip = NULL;
+	clipCell = -1;
+	clipSlot = -1;
 
 	if ( linked ) {
 		Link( gameLocal.clip, entity, id, origin, axis, renderModelHandle );
@@ -527,7 +539,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( linkedClip ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -552,6 +564,25 @@ cmHandle_t idClipModel::Handle() const {
 	}
 }
 
+/*
+================
+idClipModel::ParallelHandle
+
+Can run on a job thread, so it leaves the warning for a clip model that is
+not a collision or trace model to the caller.
+================
+*/
+cmHandle_t idClipModel::ParallelHandle( int traceContext ) const {
+	assert( renderModelHandle == -1 );
+	if ( collisionModelHandle ) {
+		return collisionModelHandle;
+	} else if ( traceModelIndex != -1 ) {
+		return collisionModelManager->ParallelSetupTrmModel( traceContext, *GetCachedTraceModel( traceModelIndex ), material );
+	} else {
+		return -1;
+	}
+}
+
 /*
 ================
 idClipModel::GetMassProperties
@@ -574,52 +605,9 @@ idClipModel::Unlink
 ===============
 */
 void idClipModel::Unlink() {
-	clipLink_t *link;
-
-	for ( link = clipLinks; link; link = clipLinks ) {
-		clipLinks = link->nextLink;
-		if ( link->prevInSector ) {
-			link->prevInSector->nextInSector = link->nextInSector;
-		} else {
-			link->sector->clipLinks = link->nextInSector;
-		}
-		if ( link->nextInSector ) {
-			link->nextInSector->prevInSector = link->prevInSector;
-		}
-		clipLinkAllocator.Free( link );
-	}
-}
-
-/*
-===============
-idClipModel::Link_r
-===============
-*/
-void idClipModel::Link_r( struct clipSector_s *node ) {
-	clipLink_t *link;
-
-	while( node->axis != -1 ) {
-		if ( absBounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( absBounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			Link_r( node->children[0] );
-			node = node->children[1];
-		}
-	}
-
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-	if ( node->clipLinks ) {
-		node->clipLinks->prevInSector = link;
+	if ( linkedClip ) {
+		linkedClip->UnlinkClipModel( this );
 	}
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
 }
 
 /*
@@ -634,11 +622,8 @@ void idClipModel::Link( idClip &clp ) {
 		return;
 	}
 
-	if ( clipLinks ) {
-		Unlink();	// unlink from old position
-	}
-
 	if ( bounds.IsCleared() ) {
+		Unlink();
 		return;
 	}
 
@@ -657,7 +642,8 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	// stays in the same cell when it hasn't moved far
+	clp.LinkClipModel( this );
 }
 
 /*
@@ -705,62 +691,20 @@ idClip::idClip
 ===============
 */
 idClip::idClip() {
-	numClipSectors = 0;
-	clipSectors = NULL;
+	cells = NULL;
+	numCells = 0;
+	maxCells = 0;
+	firstFreeCell = -1;
+	for ( int i = 0; i < GRID_LEVELS; i++ ) {
+		levelCellSize[i] = GRID_CELL_SIZE * ( 1 << i );
+		levelInvCellSize[i] = 1.0f / levelCellSize[i];
+		levelModels[i] = 0;
+	}
 	worldBounds.Zero();
+	traceBatchJobList = NULL;
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
-/*
-===============
-idClip::CreateClipSectors_r
-
-Builds a uniformly subdivided tree for the given world size
-===============
-*/
-clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector ) {
-	int				i;
-	clipSector_t	*anode;
-	idVec3			size;
-	idBounds		front, back;
-
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
-
-	if ( depth == MAX_SECTOR_DEPTH ) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
-
-		for ( i = 0; i < 3; i++ ) {
-			if ( bounds[1][i] - bounds[0][i] > maxSector[i] ) {
-				maxSector[i] = bounds[1][i] - bounds[0][i];
-			}
-		}
-		return anode;
-	}
-
-	size = bounds[1] - bounds[0];
-	if ( size[0] >= size[1] && size[0] >= size[2] ) {
-		anode->axis = 0;
-	} else if ( size[1] >= size[0] && size[1] >= size[2] ) {
-		anode->axis = 1;
-	} else {
-		anode->axis = 2;
-	}
-
-	anode->dist = 0.5f * ( bounds[1][anode->axis] + bounds[0][anode->axis] );
-
-	front = bounds;
-	back = bounds;
-	
-	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
-	
-	anode->children[0] = CreateClipSectors_r( depth+1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth+1, back, maxSector );
-
-	return anode;
-}
-
 /*
 ===============
 idClip::Init
@@ -768,26 +712,33 @@ idClip::Init
 */
 void idClip::Init() {
 	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
+	idVec3 size;
+
+	// clear the grid
+	cells = NULL;
+	numCells = 0;
+	maxCells = 0;
+	firstFreeCell = -1;
+	cellHash.Clear( GRID_CELL_HASH_SIZE, GRID_CELL_HASH_SIZE );
+	for ( int i = 0; i < GRID_LEVELS; i++ ) {
+		levelModels[i] = 0;
+		levelCells[i].Clear();
+	}
 
-	// clear clip sectors
-	clipSectors = new (TAG_PHYSICS_CLIP) clipSector_t[MAX_SECTORS];
-	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
-	numClipSectors = 0;
-	touchCount = -1;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap" );
 	collisionModelManager->GetModelBounds( h, worldBounds );
-	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
 
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
-	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
 
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
 
+	if ( traceBatchJobList == NULL ) {
+		traceBatchJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_HIGH, CM_MAX_TRACE_CONTEXTS, 0, NULL );
+	}
+
 	// set counters to zero
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
@@ -798,8 +749,27 @@ idClip::Shutdown
 ===============
 */
 void idClip::Shutdown() {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	// models that outlive the clip must not try to unlink from it later
+	for ( int i = 0; i < numCells; i++ ) {
+		clipCell_t &cell = cells[i];
+		for ( int j = 0; j < cell.numModels; j++ ) {
+			cell.models[j]->linkedClip = NULL;
+			cell.models[j]->clipCell = -1;
+			cell.models[j]->clipSlot = -1;
+		}
+		Mem_Free16( cell.bounds );
+		Mem_Free( cell.models );
+	}
+	Mem_Free( cells );
+	cells = NULL;
+	numCells = 0;
+	maxCells = 0;
+	firstFreeCell = -1;
+	cellHash.Free();
+	for ( int i = 0; i < GRID_LEVELS; i++ ) {
+		levelModels[i] = 0;
+		levelCells[i].Clear();
+	}
 
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
@@ -813,14 +783,231 @@ void idClip::Shutdown() {
 		defaultClipModel.traceModelIndex = -1;
 	}
 
-	clipLinkAllocator.Shutdown();
+	if ( traceBatchJobList != NULL ) {
+		parallelJobManager->FreeJobList( traceBatchJobList );
+		traceBatchJobList = NULL;
+	}
 }
 
 /*
-====================
-idClip::ClipModelsTouchingBounds_r
-====================
+===============
+GridCellHashKey
+===============
 */
+static ID_INLINE int GridCellHashKey( const int level, const int coords[3] ) {
+	const unsigned int key = ( (unsigned int)coords[0] * 73856093u ) ^ ( (unsigned int)coords[1] * 19349663u ) ^ ( (unsigned int)coords[2] * 83492791u ) ^ (unsigned int)level;
+	return (int)( key & 0x7FFFFFFF );
+}
+
+/*
+===============
+idClip::GridLevelForBounds
+===============
+*/
+int idClip::GridLevelForBounds( const idBounds &absBounds ) const {
+	const idVec3 size = absBounds[1] - absBounds[0];
+	const float maxSize = Max( size[0], Max( size[1], size[2] ) );
+	for ( int i = 0; i < GRID_HUGE_LEVEL; i++ ) {
+		if ( maxSize <= levelCellSize[i] ) {
+			return i;
+		}
+	}
+	return GRID_HUGE_LEVEL;
+}
+
+/*
+===============
+idClip::GridCellForBounds
+===============
+*/
+void idClip::GridCellForBounds( const int level, const idBounds &absBounds, int coords[3] ) const {
+	if ( level == GRID_HUGE_LEVEL ) {
+		coords[0] = coords[1] = coords[2] = 0;
+		return;
+	}
+	for ( int i = 0; i < 3; i++ ) {
+		coords[i] = idMath::Ftoi( idMath::Floor( 0.5f * ( absBounds[0][i] + absBounds[1][i] ) * levelInvCellSize[level] ) );
+	}
+}
+
+/*
+===============
+idClip::FindGridCell
+===============
+*/
+int idClip::FindGridCell( const int level, const int coords[3] ) const {
+	for ( int i = cellHash.First( GridCellHashKey( level, coords ) ); i != -1; i = cellHash.Next( i ) ) {
+		const clipCell_t &cell = cells[i];
+		if ( cell.level == level && cell.coords[0] == coords[0] && cell.coords[1] == coords[1] && cell.coords[2] == coords[2] ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+===============
+idClip::AllocGridCell
+===============
+*/
+int idClip::AllocGridCell( const int level, const int coords[3] ) {
+	int cellNum;
+
+	if ( firstFreeCell != -1 ) {
+		cellNum = firstFreeCell;
+		firstFreeCell = cells[cellNum].levelIndex;
+	} else {
+		if ( numCells >= maxCells ) {
+			const int newMaxCells = Max( maxCells * 2, 256 );
+			clipCell_t *newCells = (clipCell_t *) Mem_Alloc( newMaxCells * sizeof( clipCell_t ), TAG_PHYSICS_CLIP );
+			if ( cells != NULL ) {
+				memcpy( newCells, cells, numCells * sizeof( clipCell_t ) );
+				Mem_Free( cells );
+			}
+			cells = newCells;
+			maxCells = newMaxCells;
+		}
+		cellNum = numCells++;
+		cells[cellNum].numModels = 0;
+		cells[cellNum].maxModels = 0;
+		cells[cellNum].bounds = NULL;
+		cells[cellNum].models = NULL;
+	}
+
+	// the model storage of a freed cell is kept for reuse
+	clipCell_t &cell = cells[cellNum];
+	cell.level = level;
+	cell.coords[0] = coords[0];
+	cell.coords[1] = coords[1];
+	cell.coords[2] = coords[2];
+	cell.levelIndex = levelCells[level].Append( cellNum );
+	cell.numModels = 0;
+
+	cellHash.Add( GridCellHashKey( level, coords ), cellNum );
+
+	return cellNum;
+}
+
+/*
+===============
+idClip::FreeGridCell
+===============
+*/
+void idClip::FreeGridCell( const int cellNum ) {
+	clipCell_t &cell = cells[cellNum];
+
+	assert( cell.numModels == 0 );
+
+	cellHash.Remove( GridCellHashKey( cell.level, cell.coords ), cellNum );
+
+	// move the last cell of the level into the freed spot
+	idList<int> &list = levelCells[cell.level];
+	const int last = list[list.Num() - 1];
+	list[cell.levelIndex] = last;
+	cells[last].levelIndex = cell.levelIndex;
+	list.SetNum( list.Num() - 1 );
+
+	cell.level = -1;
+	cell.levelIndex = firstFreeCell;
+	firstFreeCell = cellNum;
+}
+
+/*
+===============
+idClip::LinkClipModel
+===============
+*/
+void idClip::LinkClipModel( idClipModel *clipModel ) {
+	int coords[3];
+
+	const int level = GridLevelForBounds( clipModel->absBounds );
+	GridCellForBounds( level, clipModel->absBounds, coords );
+
+	int cellNum = -1;
+	if ( clipModel->linkedClip == this ) {
+		const clipCell_t &cell = cells[clipModel->clipCell];
+		if ( cell.level == level && cell.coords[0] == coords[0] && cell.coords[1] == coords[1] && cell.coords[2] == coords[2] ) {
+			cellNum = clipModel->clipCell;
+		}
+	}
+
+	if ( cellNum == -1 ) {
+		clipModel->Unlink();
+
+		cellNum = FindGridCell( level, coords );
+		if ( cellNum == -1 ) {
+			cellNum = AllocGridCell( level, coords );
+		}
+
+		clipCell_t &cell = cells[cellNum];
+		if ( cell.numModels >= cell.maxModels ) {
+			// keep the arrays a multiple of four for the SIMD overlap test
+			const int newMaxModels = Max( cell.maxModels * 2, 4 );
+			float *newBounds = (float *) Mem_Alloc16( CELL_BOUNDS_ARRAYS * newMaxModels * sizeof( float ), TAG_PHYSICS_CLIP );
+			idClipModel **newModels = (idClipModel **) Mem_Alloc( newMaxModels * sizeof( idClipModel * ), TAG_PHYSICS_CLIP );
+			if ( cell.bounds != NULL ) {
+				for ( int i = 0; i < CELL_BOUNDS_ARRAYS; i++ ) {
+					memcpy( newBounds + i * newMaxModels, cell.bounds + i * cell.maxModels, cell.numModels * sizeof( float ) );
+				}
+				memcpy( newModels, cell.models, cell.numModels * sizeof( idClipModel * ) );
+				Mem_Free16( cell.bounds );
+				Mem_Free( cell.models );
+			}
+			cell.bounds = newBounds;
+			cell.models = newModels;
+			cell.maxModels = newMaxModels;
+		}
+
+		clipModel->linkedClip = this;
+		clipModel->clipCell = cellNum;
+		clipModel->clipSlot = cell.numModels++;
+		cell.models[clipModel->clipSlot] = clipModel;
+		levelModels[level]++;
+	}
+
+	clipCell_t &cell = cells[cellNum];
+	const int slot = clipModel->clipSlot;
+	cell.bounds[CELL_MIN_X * cell.maxModels + slot] = clipModel->absBounds[0][0];
+	cell.bounds[CELL_MIN_Y * cell.maxModels + slot] = clipModel->absBounds[0][1];
+	cell.bounds[CELL_MIN_Z * cell.maxModels + slot] = clipModel->absBounds[0][2];
+	cell.bounds[CELL_MAX_X * cell.maxModels + slot] = clipModel->absBounds[1][0];
+	cell.bounds[CELL_MAX_Y * cell.maxModels + slot] = clipModel->absBounds[1][1];
+	cell.bounds[CELL_MAX_Z * cell.maxModels + slot] = clipModel->absBounds[1][2];
+}
+
+/*
+===============
+idClip::UnlinkClipModel
+===============
+*/
+void idClip::UnlinkClipModel( idClipModel *clipModel ) {
+	assert( clipModel->linkedClip == this );
+
+	const int cellNum = clipModel->clipCell;
+	clipCell_t &cell = cells[cellNum];
+	const int slot = clipModel->clipSlot;
+	const int last = cell.numModels - 1;
+
+	// move the last model of the cell into the freed slot
+	if ( slot != last ) {
+		for ( int i = 0; i < CELL_BOUNDS_ARRAYS; i++ ) {
+			cell.bounds[i * cell.maxModels + slot] = cell.bounds[i * cell.maxModels + last];
+		}
+		cell.models[slot] = cell.models[last];
+		cell.models[slot]->clipSlot = slot;
+	}
+	cell.numModels--;
+	levelModels[cell.level]--;
+
+	clipModel->linkedClip = NULL;
+	clipModel->clipCell = -1;
+	clipModel->clipSlot = -1;
+
+	if ( cell.numModels == 0 ) {
+		FreeGridCell( cellNum );
+	}
+}
+
 typedef struct listParms_s {
 	idBounds		bounds;
 	int				contentMask;
@@ -829,56 +1016,94 @@ typedef struct listParms_s {
 	int				maxCount;
 } listParms_t;
 
-void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
+/*
+====================
+AddTouchingClipModel
 
-	while( node->axis != -1 ) {
-		if ( parms.bounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( parms.bounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			ClipModelsTouchingBounds_r( node->children[0], parms );
-			node = node->children[1];
-		}
+Returns false when the list is full.
+====================
+*/
+static ID_INLINE bool AddTouchingClipModel( idClipModel *check, listParms_t &parms ) {
+	// if the clip model is enabled
+	if ( !check->IsEnabled() ) {
+		return true;
 	}
 
-	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
-		idClipModel	*check = link->clipModel;
+	// if the clip model does not have any contents we are looking for
+	if ( !( check->GetContents() & parms.contentMask ) ) {
+		return true;
+	}
 
-		// if the clip model is enabled
-		if ( !check->enabled ) {
-			continue;
-		}
+	if ( parms.count >= parms.maxCount ) {
+		gameLocal.Warning( "idClip::ClipModelsTouchingBounds: max count" );
+		return false;
+	}
 
-		// avoid duplicates in the list
-		if ( check->touchCount == touchCount ) {
+	parms.list[parms.count] = check;
+	parms.count++;
+	return true;
+}
+
+/*
+====================
+idClip::ClipModelsTouchingCell
+====================
+*/
+void idClip::ClipModelsTouchingCell( const clipCell_t &cell, listParms_t &parms ) const {
+	const int stride = cell.maxModels;
+	const float *minX = cell.bounds + CELL_MIN_X * stride;
+	const float *minY = cell.bounds + CELL_MIN_Y * stride;
+	const float *minZ = cell.bounds + CELL_MIN_Z * stride;
+	const float *maxX = cell.bounds + CELL_MAX_X * stride;
+	const float *maxY = cell.bounds + CELL_MAX_Y * stride;
+	const float *maxZ = cell.bounds + CELL_MAX_Z * stride;
+
+#ifdef ID_X86_SSE2_INTRIN
+
+	const __m128 queryMinX = _mm_set1_ps( parms.bounds[0][0] );
+	const __m128 queryMinY = _mm_set1_ps( parms.bounds[0][1] );
+	const __m128 queryMinZ = _mm_set1_ps( parms.bounds[0][2] );
+	const __m128 queryMaxX = _mm_set1_ps( parms.bounds[1][0] );
+	const __m128 queryMaxY = _mm_set1_ps( parms.bounds[1][1] );
+	const __m128 queryMaxZ = _mm_set1_ps( parms.bounds[1][2] );
+
+	for ( int i = 0; i < cell.numModels; i += 4 ) {
+		// the bounds overlap unless they are apart on one of the axes
+		__m128 apart = _mm_cmpgt_ps( _mm_load_ps( minX + i ), queryMaxX );
+		apart = _mm_or_ps( apart, _mm_cmplt_ps( _mm_load_ps( maxX + i ), queryMinX ) );
+		apart = _mm_or_ps( apart, _mm_cmpgt_ps( _mm_load_ps( minY + i ), queryMaxY ) );
+		apart = _mm_or_ps( apart, _mm_cmplt_ps( _mm_load_ps( maxY + i ), queryMinY ) );
+		apart = _mm_or_ps( apart, _mm_cmpgt_ps( _mm_load_ps( minZ + i ), queryMaxZ ) );
+		apart = _mm_or_ps( apart, _mm_cmplt_ps( _mm_load_ps( maxZ + i ), queryMinZ ) );
+
+		const int touching = ~_mm_movemask_ps( apart ) & 15;
+		if ( touching == 0 ) {
 			continue;
 		}
 
-		// if the clip model does not have any contents we are looking for
-		if ( !( check->contents & parms.contentMask ) ) {
-			continue;
+		// lanes past the last model hold stale data
+		const int numLanes = Min( cell.numModels - i, 4 );
+		for ( int j = 0; j < numLanes; j++ ) {
+			if ( ( touching & ( 1 << j ) ) != 0 && !AddTouchingClipModel( cell.models[i + j], parms ) ) {
+				return;
+			}
 		}
+	}
 
-		// if the bounds really do overlap
-		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] ) {
+#else
+
+	for ( int i = 0; i < cell.numModels; i++ ) {
+		if (	minX[i] > parms.bounds[1][0] || maxX[i] < parms.bounds[0][0] ||
+				minY[i] > parms.bounds[1][1] || maxY[i] < parms.bounds[0][1] ||
+				minZ[i] > parms.bounds[1][2] || maxZ[i] < parms.bounds[0][2] ) {
 			continue;
 		}
-
-		if ( parms.count >= parms.maxCount ) {
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
+		if ( !AddTouchingClipModel( cell.models[i], parms ) ) {
 			return;
 		}
-
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
 	}
+
+#endif
 }
 
 /*
@@ -888,11 +1113,12 @@ idClip::ClipModelsTouchingBounds
 */
 int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
 	listParms_t parms;
+	int mins[3], maxs[3], coords[3];
 
 	if (	bounds[0][0] > bounds[1][0] ||
 			bounds[0][1] > bounds[1][1] ||
 			bounds[0][2] > bounds[1][2] ) {
-		// we should not go through the tree for degenerate or backwards bounds
+		// we should not go through the grid for degenerate or backwards bounds
 		assert( false );
 		return 0;
 	}
@@ -904,8 +1130,53 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
-	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	for ( int level = 0; level < GRID_LEVELS; level++ ) {
+		if ( levelModels[level] == 0 ) {
+			continue;
+		}
+
+		const idList<int> &list = levelCells[level];
+
+		if ( level == GRID_HUGE_LEVEL ) {
+			for ( int i = 0; i < list.Num(); i++ ) {
+				ClipModelsTouchingCell( cells[list[i]], parms );
+			}
+			continue;
+		}
+
+		// models stick out at most half a cell from the cell they are stored in
+		const float halfCell = 0.5f * levelCellSize[level];
+		int numQueryCells = 1;
+		for ( int i = 0; i < 3; i++ ) {
+			mins[i] = idMath::Ftoi( idMath::Floor( ( parms.bounds[0][i] - halfCell ) * levelInvCellSize[level] ) );
+			maxs[i] = idMath::Ftoi( idMath::Floor( ( parms.bounds[1][i] + halfCell ) * levelInvCellSize[level] ) );
+			numQueryCells *= Min( maxs[i] - mins[i] + 1, 1024 );
+		}
+
+		if ( numQueryCells > list.Num() ) {
+			// fewer cells in use than the box covers
+			for ( int i = 0; i < list.Num(); i++ ) {
+				const clipCell_t &cell = cells[list[i]];
+				if (	cell.coords[0] < mins[0] || cell.coords[0] > maxs[0] ||
+						cell.coords[1] < mins[1] || cell.coords[1] > maxs[1] ||
+						cell.coords[2] < mins[2] || cell.coords[2] > maxs[2] ) {
+					continue;
+				}
+				ClipModelsTouchingCell( cell, parms );
+			}
+		} else {
+			for ( coords[0] = mins[0]; coords[0] <= maxs[0]; coords[0]++ ) {
+				for ( coords[1] = mins[1]; coords[1] <= maxs[1]; coords[1]++ ) {
+					for ( coords[2] = mins[2]; coords[2] <= maxs[2]; coords[2]++ ) {
+						const int cellNum = FindGridCell( level, coords );
+						if ( cellNum != -1 ) {
+							ClipModelsTouchingCell( cells[cellNum], parms );
+						}
+					}
+				}
+			}
+		}
+	}
 
 	return parms.count;
 }
@@ -941,6 +1212,38 @@ int idClip::EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idE
 	return entCount;
 }
 
+/*
+====================
+PassOwnerForEntity
+====================
+*/
+static ID_INLINE const idEntity *PassOwnerForEntity( const idEntity *passEntity ) {
+	if ( passEntity->GetPhysics()->GetNumClipModels() > 0 ) {
+		return passEntity->GetPhysics()->GetClipModel()->GetOwner();
+	}
+	return NULL;
+}
+
+/*
+====================
+IgnoreForPassEntity
+====================
+*/
+static ID_INLINE bool IgnoreForPassEntity( const idClipModel *cm, const idEntity *passEntity, const idEntity *passOwner ) {
+	if ( cm->GetEntity() == passEntity ) {
+		return true;			// don't clip against the pass entity
+	} else if ( cm->GetEntity() == passOwner ) {
+		return true;			// missiles don't clip with their owner
+	} else if ( cm->GetOwner() ) {
+		if ( cm->GetOwner() == passEntity ) {
+			return true;		// don't clip against own missiles
+		} else if ( cm->GetOwner() == passOwner ) {
+			return true;		// don't clip against other missiles from same owner
+		}
+	}
+	return false;
+}
+
 /*
 ====================
 idClip::GetTraceClipModels
@@ -954,8 +1257,7 @@ idClip::GetTraceClipModels
 */
 int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const {
 	int i, num;
-	idClipModel	*cm;
-	idEntity *passOwner;
+	const idEntity *passOwner;
 
 	num = ClipModelsTouchingBounds( bounds, contentMask, clipModelList, MAX_GENTITIES );
 
@@ -963,27 +1265,12 @@ int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const i
 		return num;
 	}
 
-	if ( passEntity->GetPhysics()->GetNumClipModels() > 0 ) {
-		passOwner = passEntity->GetPhysics()->GetClipModel()->GetOwner();
-	} else {
-		passOwner = NULL;
-	}
+	passOwner = PassOwnerForEntity( passEntity );
 
 	for ( i = 0; i < num; i++ ) {
-
-		cm = clipModelList[i];
-
 		// check if we should ignore this entity
-		if ( cm->entity == passEntity ) {
-			clipModelList[i] = NULL;			// don't clip against the pass entity
-		} else if ( cm->entity == passOwner ) {
-			clipModelList[i] = NULL;			// missiles don't clip with their owner
-		} else if ( cm->owner ) {
-			if ( cm->owner == passEntity ) {
-				clipModelList[i] = NULL;		// don't clip against own missiles
-			} else if ( cm->owner == passOwner ) {
-				clipModelList[i] = NULL;		// don't clip against other missiles from same owner
-			}
+		if ( IgnoreForPassEntity( clipModelList[i], passEntity, passOwner ) ) {
+			clipModelList[i] = NULL;
 		}
 	}
 
@@ -1207,6 +1494,339 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+===============================================================
+
+	Batched translations
+
+	Translations that are close together are put in a group that shares
+	a single broadphase query.  The groups are spread over jobs that each
+	run their collision tests in their own collision model trace context.
+	Render model traces are not thread safe so the jobs leave those to the
+	game thread, which merges them into the results in clip model order so
+	the results are the same as for a series of Translation calls.
+
+===============================================================
+*/
+
+#define TRACE_BATCH_WORLD		-1			// the trace hit the world or nothing
+#define TRACE_BATCH_DONE		-2			// the trace needs no more testing
+
+typedef struct traceBatchGroup_s {
+	int						firstTrace;
+	int						numTraces;
+	idBounds				bounds;				// bounds of all translations in the group
+	int						contentMask;		// contents of all translations in the group
+} traceBatchGroup_t;
+
+typedef struct traceBatchRenderModel_s {
+	int						trace;
+	int						order;				// index of the clip model in the clip models tested for the trace
+	idClipModel *			touch;
+} traceBatchRenderModel_t;
+
+typedef struct traceBatchJob_s {
+	const idClip *			clip;
+	const clipTranslation_t *translations;
+	trace_t *				results;
+	int *					orders;				// index of the clip model the trace hit, or one of the TRACE_BATCH_ values
+	const traceBatchGroup_t *groups;
+	int						numGroups;
+	int						traceContext;
+	int						numTranslations;
+	idList<traceBatchRenderModel_t>	renderModels;
+	idList<const idClipModel *>		invalidModels;		// warned about on the game thread
+} traceBatchJob_t;
+
+static idList<traceBatchGroup_t>	traceBatchGroups;
+static idList<int>					traceBatchOrders;
+static traceBatchJob_t				traceBatchJobs[CM_MAX_TRACE_CONTEXTS];
+
+/*
+============
+TraceBoundsForTranslation
+============
+*/
+static ID_INLINE void TraceBoundsForTranslation( idBounds &bounds, const idTraceModel *trm, const idVec3 &start, const idVec3 &end, const idMat3 &trmAxis ) {
+	if ( !trm ) {
+		bounds.FromPointTranslation( start, end - start );
+	} else {
+		bounds.FromBoundsTranslation( trm->bounds, start, trmAxis, end - start );
+	}
+}
+
+/*
+============
+idClip::TranslationBatchGroups
+
+Same as Translation for all the translations in the groups of the job but
+with one broadphase query per group.
+============
+*/
+void idClip::TranslationBatchGroups( traceBatchJob_t &job ) const {
+	int i, j, t, numCandidates;
+	idClipModel *touch, *candidates[MAX_GENTITIES];
+	const idTraceModel *trms[MAX_TRACE_BATCH_GROUP];
+	idBounds traceBounds[MAX_TRACE_BATCH_GROUP];
+	idBounds groupBounds;
+	trace_t trace;
+
+	for ( i = 0; i < job.numGroups; i++ ) {
+		const traceBatchGroup_t &group = job.groups[i];
+
+		// test the world first so the broadphase query only covers what is left of the translations
+		groupBounds.Clear();
+		for ( j = 0; j < group.numTraces; j++ ) {
+			t = group.firstTrace + j;
+			if ( job.orders[t] == TRACE_BATCH_DONE ) {
+				continue;
+			}
+
+			const clipTranslation_t &translation = job.translations[t];
+			trace_t &results = job.results[t];
+			trms[j] = TraceModelForClipModel( translation.mdl );
+
+			if ( !translation.passEntity || translation.passEntity->entityNumber != ENTITYNUM_WORLD ) {
+				job.numTranslations++;
+				collisionModelManager->ParallelTranslation( job.traceContext, &results, translation.start, translation.end, trms[j], translation.trmAxis,
+															translation.contentMask, 0, vec3_origin, mat3_default );
+				results.c.entityNum = results.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+				if ( results.fraction == 0.0f ) {
+					job.orders[t] = TRACE_BATCH_DONE;		// blocked immediately by the world
+					continue;
+				}
+			} else {
+				memset( &results, 0, sizeof( results ) );
+				results.fraction = 1.0f;
+				results.endpos = translation.end;
+				results.endAxis = translation.trmAxis;
+			}
+			job.orders[t] = TRACE_BATCH_WORLD;
+
+			TraceBoundsForTranslation( traceBounds[j], trms[j], translation.start, results.endpos, translation.trmAxis );
+			groupBounds.AddBounds( traceBounds[j] );
+			// same margin as ClipModelsTouchingBounds
+			traceBounds[j][0] -= vec3_boxEpsilon;
+			traceBounds[j][1] += vec3_boxEpsilon;
+		}
+
+		if ( groupBounds.IsCleared() ) {
+			continue;
+		}
+
+		numCandidates = ClipModelsTouchingBounds( groupBounds, group.contentMask, candidates, MAX_GENTITIES );
+
+		for ( j = 0; j < group.numTraces; j++ ) {
+			t = group.firstTrace + j;
+			if ( job.orders[t] == TRACE_BATCH_DONE ) {
+				continue;
+			}
+
+			const clipTranslation_t &translation = job.translations[t];
+			trace_t &results = job.results[t];
+			const idEntity *passOwner = translation.passEntity ? PassOwnerForEntity( translation.passEntity ) : NULL;
+			int order = 0;
+
+			for ( int k = 0; k < numCandidates; k++ ) {
+				touch = candidates[k];
+
+				// skip what the broadphase query for this translation alone would not have returned
+				if ( !( touch->GetContents() & translation.contentMask ) ) {
+					continue;
+				}
+				if ( !touch->absBounds.IntersectsBounds( traceBounds[j] ) ) {
+					continue;
+				}
+				if ( translation.passEntity && IgnoreForPassEntity( touch, translation.passEntity, passOwner ) ) {
+					continue;
+				}
+
+				if ( touch->renderModelHandle != -1 ) {
+					traceBatchRenderModel_t &renderModel = job.renderModels.Alloc();
+					renderModel.trace = t;
+					renderModel.order = order++;
+					renderModel.touch = touch;
+					continue;
+				}
+
+				cmHandle_t handle = touch->ParallelHandle( job.traceContext );
+				if ( handle == -1 ) {
+					job.invalidModels.AddUnique( touch );
+					handle = 0;
+				}
+
+				job.numTranslations++;
+				collisionModelManager->ParallelTranslation( job.traceContext, &trace, translation.start, translation.end, trms[j], translation.trmAxis,
+															translation.contentMask, handle, touch->origin, touch->axis );
+
+				if ( trace.fraction < results.fraction ) {
+					results = trace;
+					results.c.entityNum = touch->entity->entityNumber;
+					results.c.id = touch->id;
+					job.orders[t] = order;
+					if ( results.fraction == 0.0f ) {
+						break;
+					}
+				}
+				order++;
+			}
+		}
+	}
+}
+
+/*
+============
+TranslationBatchJob
+============
+*/
+static void TranslationBatchJob( traceBatchJob_t *job ) {
+	job->clip->TranslationBatchGroups( *job );
+}
+
+REGISTER_PARALLEL_JOB( TranslationBatchJob, "TranslationBatchJob" );
+
+/*
+============
+idClip::TranslationBatch
+============
+*/
+int idClip::TranslationBatch( trace_t *results, const clipTranslation_t *translations, const int numTraces ) {
+	int i, numHits;
+	trace_t trace;
+	idBounds bounds, merged;
+	traceBatchGroup_t *group;
+
+	if ( numTraces <= 0 ) {
+		return 0;
+	}
+
+	traceBatchOrders.SetNum( numTraces );
+	traceBatchGroups.SetNum( 0 );
+
+	// group translations that fit together in a small box
+	group = NULL;
+	for ( i = 0; i < numTraces; i++ ) {
+		const clipTranslation_t &translation = translations[i];
+
+		if ( TestHugeTranslation( results[i], translation.mdl, translation.start, translation.end, translation.trmAxis ) ) {
+			traceBatchOrders[i] = TRACE_BATCH_DONE;
+			continue;
+		}
+		traceBatchOrders[i] = TRACE_BATCH_WORLD;
+
+		TraceBoundsForTranslation( bounds, TraceModelForClipModel( translation.mdl ), translation.start, translation.end, translation.trmAxis );
+
+		if ( group != NULL && i - group->firstTrace < MAX_TRACE_BATCH_GROUP ) {
+			merged = group->bounds;
+			merged.AddBounds( bounds );
+			const idVec3 size = merged[1] - merged[0];
+			if ( size.x <= TRACE_BATCH_GROUP_SIZE && size.y <= TRACE_BATCH_GROUP_SIZE && size.z <= TRACE_BATCH_GROUP_SIZE ) {
+				group->bounds = merged;
+				group->contentMask |= translation.contentMask;
+				group->numTraces = i - group->firstTrace + 1;
+				continue;
+			}
+		}
+
+		group = &traceBatchGroups.Alloc();
+		group->firstTrace = i;
+		group->numTraces = 1;
+		group->bounds = bounds;
+		group->contentMask = translation.contentMask;
+	}
+
+	// spread the groups over the jobs, each job gets a trace context of its own
+	const int numGroups = traceBatchGroups.Num();
+	int numJobs = 1;
+	if ( g_parallelTraceBatches.GetBool() ) {
+		const int minTracesPerJob = Max( g_traceBatchMinTraces.GetInteger(), 1 );
+		numJobs = Min( numTraces / minTracesPerJob, numGroups );
+		numJobs = Min( numJobs, Min( parallelJobManager->GetNumProcessingUnits(), CM_MAX_TRACE_CONTEXTS ) );
+		numJobs = Max( numJobs, 1 );
+	}
+	const int tracesPerJob = ( numTraces + numJobs - 1 ) / numJobs;
+
+	int numSubmitted = 0;
+	for ( i = 0; i < numGroups; numSubmitted++ ) {
+		traceBatchJob_t &job = traceBatchJobs[numSubmitted];
+		job.clip = this;
+		job.translations = translations;
+		job.results = results;
+		job.orders = traceBatchOrders.Ptr();
+		job.groups = traceBatchGroups.Ptr() + i;
+		job.numGroups = 0;
+		job.traceContext = numSubmitted;
+		job.numTranslations = 0;
+		job.renderModels.SetNum( 0 );
+		job.invalidModels.SetNum( 0 );
+
+		const int lastTrace = ( numSubmitted + 1 ) * tracesPerJob;
+		while ( i < numGroups && ( job.numGroups == 0 || traceBatchGroups[i].firstTrace < lastTrace || numSubmitted == numJobs - 1 ) ) {
+			job.numGroups++;
+			i++;
+		}
+	}
+
+	if ( numSubmitted > 0 ) {
+		// the collision model data is only copied for the extra trace contexts once a batch is split over jobs
+		collisionModelManager->BeginParallelTranslations( numSubmitted );
+
+		if ( numSubmitted == 1 ) {
+			TranslationBatchJob( &traceBatchJobs[0] );
+		} else {
+			for ( i = 0; i < numSubmitted; i++ ) {
+				traceBatchJobList->AddJob( (jobRun_t)TranslationBatchJob, &traceBatchJobs[i] );
+			}
+			traceBatchJobList->Submit();
+			traceBatchJobList->Wait();
+		}
+
+		collisionModelManager->EndParallelTranslations();
+	}
+
+	// run the render model traces in clip model order
+	for ( i = 0; i < numSubmitted; i++ ) {
+		traceBatchJob_t &job = traceBatchJobs[i];
+		idClip::numTranslations += job.numTranslations;
+
+		for ( int j = 0; j < job.invalidModels.Num(); j++ ) {
+			const idClipModel *invalid = job.invalidModels[j];
+			gameLocal.Warning( "idClipModel::ParallelHandle: clip model %d on '%s' (%x) is not a collision or trace model", invalid->GetId(), invalid->GetEntity()->name.c_str(), invalid->GetEntity()->entityNumber );
+		}
+
+		for ( int j = 0; j < job.renderModels.Num(); j++ ) {
+			const traceBatchRenderModel_t &renderModel = job.renderModels[j];
+			const clipTranslation_t &translation = translations[renderModel.trace];
+			trace_t &traceResults = results[renderModel.trace];
+			int &order = traceBatchOrders[renderModel.trace];
+
+			// the translation would have stopped at an earlier clip model
+			if ( traceResults.fraction == 0.0f && order < renderModel.order ) {
+				continue;
+			}
+
+			const idTraceModel *trm = TraceModelForClipModel( translation.mdl );
+			idClip::numRenderModelTraces++;
+			TraceRenderModel( trace, translation.start, translation.end, trm ? trm->bounds.GetRadius() : 0.0f, translation.trmAxis, renderModel.touch );
+
+			if ( trace.fraction < traceResults.fraction || ( trace.fraction < 1.0f && trace.fraction == traceResults.fraction && renderModel.order < order ) ) {
+				traceResults = trace;
+				traceResults.c.entityNum = renderModel.touch->entity->entityNumber;
+				traceResults.c.id = renderModel.touch->id;
+				order = renderModel.order;
+			}
+		}
+	}
+
+	numHits = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( results[i].fraction < 1.0f ) {
+			numHits++;
+		}
+	}
+	return numHits;
+}
+
 /*
 ============
 idClip::Rotation
@@ -1694,6 +2314,171 @@ void idClip::PrintStatistics() {
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
+/*
+============
+idClip::PrintGridStatistics
+============
+*/
+void idClip::PrintGridStatistics() const {
+	int totalCells = 0, totalModels = 0;
+
+	gameLocal.Printf( "level  cell size  cells  models  max per cell\n" );
+	for ( int level = 0; level < GRID_LEVELS; level++ ) {
+		int maxPerCell = 0;
+		for ( int i = 0; i < levelCells[level].Num(); i++ ) {
+			maxPerCell = Max( maxPerCell, cells[levelCells[level][i]].numModels );
+		}
+		if ( level == GRID_HUGE_LEVEL ) {
+			gameLocal.Printf( "%5d  %9s  %5d  %6d  %12d\n", level, "huge", levelCells[level].Num(), levelModels[level], maxPerCell );
+		} else {
+			gameLocal.Printf( "%5d  %9.0f  %5d  %6d  %12d\n", level, levelCellSize[level], levelCells[level].Num(), levelModels[level], maxPerCell );
+		}
+		totalCells += levelCells[level].Num();
+		totalModels += levelModels[level];
+	}
+	gameLocal.Printf( "%d clip models in %d cells, %d cells allocated\n", totalModels, totalCells, numCells );
+}
+
+/*
+============
+idClip::Benchmark
+
+Sweeps and contact tests every linked trace model in random directions and
+times the broadphase on its own and the full Translation and Contacts
+queries.  The broadphase results are checked against a scan of all models
+and the TranslationBatch results against the Translation results.
+============
+*/
+void idClip::Benchmark( int numQueries ) {
+	idList<idClipModel *> models;
+	idList<idClipModel *> sources;
+	idClipModel *clipModelList[MAX_GENTITIES];
+	contactInfo_t contacts[10];
+	idRandom random( 0 );
+	idClipModel *clipModel;
+	int i, j;
+
+	for ( i = 0; i < numCells; i++ ) {
+		for ( j = 0; j < cells[i].numModels; j++ ) {
+			idClipModel *clipModel = cells[i].models[j];
+			models.Append( clipModel );
+			if ( clipModel->IsTraceModel() && clipModel->GetEntity() != NULL ) {
+				sources.Append( clipModel );
+			}
+		}
+	}
+
+	if ( sources.Num() == 0 ) {
+		gameLocal.Printf( "no linked trace models to test with\n" );
+		return;
+	}
+
+	// build the queries up front so every pass uses the same ones, runs of
+	// queries start at the same model like the traces of an AI movement test
+	idList<idClipModel *> queryModels;
+	idList<idVec3> queryEnds;
+	idList<idBounds> queryBounds;
+	queryModels.SetNum( numQueries );
+	queryEnds.SetNum( numQueries );
+	queryBounds.SetNum( numQueries );
+	clipModel = NULL;
+	for ( i = 0; i < numQueries; i++ ) {
+		if ( ( i & 7 ) == 0 ) {
+			clipModel = sources[random.RandomInt( sources.Num() )];
+		}
+		idVec3 dir( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() );
+		dir.Normalize();
+		queryModels[i] = clipModel;
+		queryEnds[i] = clipModel->GetOrigin() + dir * 256.0f;
+		queryBounds[i].FromBoundsTranslation( clipModel->GetBounds(), clipModel->GetOrigin(), clipModel->GetAxis(), queryEnds[i] - clipModel->GetOrigin() );
+	}
+
+	// check the grid against a scan of all linked models
+	int numMismatches = 0;
+	for ( i = 0; i < numQueries; i++ ) {
+		const idBounds expanded( queryBounds[i][0] - vec3_boxEpsilon, queryBounds[i][1] + vec3_boxEpsilon );
+		int numExpected = 0;
+		for ( j = 0; j < models.Num(); j++ ) {
+			if ( models[j]->IsEnabled() && ( models[j]->GetContents() & MASK_ALL ) && models[j]->GetAbsBounds().IntersectsBounds( expanded ) ) {
+				numExpected++;
+			}
+		}
+		if ( ClipModelsTouchingBounds( queryBounds[i], MASK_ALL, clipModelList, MAX_GENTITIES ) != numExpected ) {
+			numMismatches++;
+		}
+	}
+
+	const int savedTranslations = numTranslations;
+	const int savedRenderModelTraces = numRenderModelTraces;
+	const int savedContacts = numContacts;
+
+	uint64 start = Sys_Microseconds();
+	int numTouched = 0;
+	for ( i = 0; i < numQueries; i++ ) {
+		numTouched += ClipModelsTouchingBounds( queryBounds[i], MASK_MONSTERSOLID, clipModelList, MAX_GENTITIES );
+	}
+	const uint64 broadphaseTime = Sys_Microseconds() - start;
+
+	idList<trace_t> serialTraces;
+	serialTraces.SetNum( numQueries );
+	start = Sys_Microseconds();
+	for ( i = 0; i < numQueries; i++ ) {
+		clipModel = queryModels[i];
+		Translation( serialTraces[i], clipModel->GetOrigin(), queryEnds[i], clipModel, clipModel->GetAxis(), MASK_MONSTERSOLID, clipModel->GetEntity() );
+	}
+	const uint64 translationTime = Sys_Microseconds() - start;
+
+	idList<clipTranslation_t> translations;
+	idList<trace_t> batchTraces;
+	translations.SetNum( numQueries );
+	batchTraces.SetNum( numQueries );
+	for ( i = 0; i < numQueries; i++ ) {
+		clipModel = queryModels[i];
+		translations[i].start = clipModel->GetOrigin();
+		translations[i].end = queryEnds[i];
+		translations[i].mdl = clipModel;
+		translations[i].trmAxis = clipModel->GetAxis();
+		translations[i].contentMask = MASK_MONSTERSOLID;
+		translations[i].passEntity = clipModel->GetEntity();
+	}
+	start = Sys_Microseconds();
+	TranslationBatch( batchTraces.Ptr(), translations.Ptr(), numQueries );
+	const uint64 batchTime = Sys_Microseconds() - start;
+
+	int numBatchMismatches = 0;
+	for ( i = 0; i < numQueries; i++ ) {
+		if ( batchTraces[i].fraction != serialTraces[i].fraction || batchTraces[i].c.entityNum != serialTraces[i].c.entityNum ) {
+			numBatchMismatches++;
+		}
+	}
+
+	start = Sys_Microseconds();
+	for ( i = 0; i < numQueries; i++ ) {
+		clipModel = queryModels[i];
+		idVec3 dir = queryEnds[i] - clipModel->GetOrigin();
+		dir.Normalize();
+		Contacts( contacts, 10, clipModel->GetOrigin(), idVec6( dir.x, dir.y, dir.z, 0.0f, 0.0f, 0.0f ), 1.0f, clipModel, clipModel->GetAxis(), MASK_MONSTERSOLID, clipModel->GetEntity() );
+	}
+	const uint64 contactsTime = Sys_Microseconds() - start;
+
+	numTranslations = savedTranslations;
+	numRenderModelTraces = savedRenderModelTraces;
+	numContacts = savedContacts;
+
+	PrintGridStatistics();
+	gameLocal.Printf( "%d queries from %d trace models, %d linked models\n", numQueries, sources.Num(), models.Num() );
+	gameLocal.Printf( "  broadphase:  %8.2f usec per query, %.1f models touched\n", (float)broadphaseTime / numQueries, (float)numTouched / numQueries );
+	gameLocal.Printf( "  Translation: %8.2f usec per query\n", (float)translationTime / numQueries );
+	gameLocal.Printf( "  batched:     %8.2f usec per query\n", (float)batchTime / numQueries );
+	gameLocal.Printf( "  Contacts:    %8.2f usec per query\n", (float)contactsTime / numQueries );
+	if ( numMismatches ) {
+		gameLocal.Warning( "%d broadphase queries didn't match a scan of all models", numMismatches );
+	}
+	if ( numBatchMismatches ) {
+		gameLocal.Warning( "%d batched translations didn't match the Translation results", numBatchMismatches );
+	}
+}
+
 /*
 ============
 idClip::DrawClipModels
@@ -72,7 +72,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink();						// unlink from sectors
+	void					Unlink();						// unlink from the broadphase
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -98,6 +98,7 @@ public:
 	bool					IsEnabled() const;			// returns true if enabled for collision detection
 	bool					IsEqual( const idTraceModel &trm ) const;
 	cmHandle_t				Handle() const;				// returns handle used to collide vs this model
+	cmHandle_t				ParallelHandle( int traceContext ) const;	// returns handle used to collide vs this model in a parallel translation, -1 if it is not a collision or trace model
 	const idTraceModel *	GetTraceModel() const;
 	void					GetMassProperties( const float density, float &mass, idVec3 &centerOfMass, idMat3 &inertiaTensor ) const;
 
@@ -123,11 +124,11 @@ private:
 	int						traceModelIndex;		// trace model used for collision detection
 	int						renderModelHandle;		// render model def handle
 
-	struct clipLink_s *		clipLinks;				// links into sectors
-	int						touchCount;
+	idClip *				linkedClip;				// clip the model is linked into
+	int						clipCell;				// broadphase cell the model is stored in
+	int						clipSlot;				// index of the model in the cell
 
 	void					Init();			// initialize
-	void					Link_r( struct clipSector_s *node );
 
 	static int				AllocTraceModel( const idTraceModel &trm, bool persistantThroughSaves = true );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -221,7 +222,7 @@ ID_INLINE bool idClipModel::IsTraceModel() const {
 }
 
 ID_INLINE bool idClipModel::IsLinked() const {
-	return ( clipLinks != NULL );
+	return ( linkedClip != NULL );
 }
 
 ID_INLINE bool idClipModel::IsEnabled() const {
@@ -246,6 +247,16 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel() const {
 //
 //===============================================================
 
+// one translation of a batch
+typedef struct clipTranslation_s {
+	idVec3					start;
+	idVec3					end;
+	const idClipModel *		mdl;					// NULL for a point trace
+	idMat3					trmAxis;
+	int						contentMask;
+	const idEntity *		passEntity;
+} clipTranslation_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -292,6 +303,11 @@ public:
 	void					TranslationEntities( trace_t &results, const idVec3 &start, const idVec3 &end,
 								const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity );
 
+	// same as Translation for each translation in the batch, returns the number of translations that hit something
+	int						TranslationBatch( trace_t *results, const clipTranslation_t *translations, const int numTraces );
+							// runs the groups of a TranslationBatch job, called from the job threads
+	void					TranslationBatchGroups( struct traceBatchJob_s &job ) const;
+
 	// get a contact feature
 	bool					GetModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, idFixedWinding &winding ) const;
 
@@ -304,16 +320,35 @@ public:
 
 							// stats and debug drawing
 	void					PrintStatistics();
+	void					PrintGridStatistics() const;
+	void					Benchmark( int numQueries );
 	void					DrawClipModels( const idVec3 &eye, const float radius, const idEntity *passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, int lifetime ) const;
 
 private:
-	int						numClipSectors;
-	struct clipSector_s *	clipSectors;
+	// Clip models are kept in a loose hierarchical grid.  Each model is stored
+	// in exactly one cell: the cell that contains its center on the finest
+	// level whose cell size is at least the largest extent of the model.  A
+	// cell can therefore hold models that stick out up to half a cell on each
+	// side, which queries account for.  The last level has a single cell for
+	// models too large for any of the others.
+	static const int		GRID_LEVELS = 9;
+	static const int		GRID_HUGE_LEVEL = GRID_LEVELS - 1;
+
+	struct clipCell_s *		cells;
+	int						numCells;
+	int						maxCells;
+	int						firstFreeCell;
+	idHashIndex				cellHash;
+	float					levelCellSize[GRID_LEVELS];
+	float					levelInvCellSize[GRID_LEVELS];
+	int						levelModels[GRID_LEVELS];
+	idList<int>				levelCells[GRID_LEVELS];	// cells in use on each level
+
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
-	mutable int				touchCount;
+	idParallelJobList *		traceBatchJobList;
 							// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -323,8 +358,14 @@ private:
 	int						numContacts;
 
 private:
-	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
-	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	int						GridLevelForBounds( const idBounds &absBounds ) const;
+	void					GridCellForBounds( const int level, const idBounds &absBounds, int coords[3] ) const;
+	int						FindGridCell( const int level, const int coords[3] ) const;
+	int						AllocGridCell( const int level, const int coords[3] );
+	void					FreeGridCell( const int cellNum );
+	void					LinkClipModel( idClipModel *clipModel );
+	void					UnlinkClipModel( idClipModel *clipModel );
+	void					ClipModelsTouchingCell( const struct clipCell_s &cell, struct listParms_s &parms ) const;
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
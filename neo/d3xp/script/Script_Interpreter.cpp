@@ -935,17 +935,50 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	popParms = 0;
 }
 
+// GCC and clang can take the address of a label, so each opcode handler ends
+// with its own indirect jump to the next handler instead of every opcode
+// going back through the single branch at the top of the switch
+#if defined( __GNUC__ )
+#define ID_SCRIPT_THREADED_DISPATCH
+#endif
+
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+// the label addresses in the static dispatch table are only valid for one copy of Execute
+#if defined( __clang__ )
+#define ID_SCRIPT_EXECUTE_ATTRIBUTES	__attribute__((noinline))
+#else
+#define ID_SCRIPT_EXECUTE_ATTRIBUTES	__attribute__((noinline, noclone))
+#endif
+#define SCRIPT_OP( op )		case op: label_##op
+#define SCRIPT_OP_DEFAULT	default: label_default
+#define SCRIPT_NEXT																	\
+	if ( threadedDispatch && !doneProcessing && !threadDying ) {					\
+		instructionPointer++;														\
+		if ( !--runaway ) {															\
+			Error( "runaway loop error" );											\
+		}																			\
+		st = &gameLocal.program.GetLoweredStatement( instructionPointer );			\
+		goto *dispatchTable[ st->op ];												\
+	}																				\
+	continue
+#else
+#define ID_SCRIPT_EXECUTE_ATTRIBUTES
+#define SCRIPT_OP( op )		case op
+#define SCRIPT_OP_DEFAULT	default
+#define SCRIPT_NEXT			continue
+#endif
+
 /*
 ====================
 idInterpreter::Execute
 ====================
 */
-bool idInterpreter::Execute() {
+ID_SCRIPT_EXECUTE_ATTRIBUTES bool idInterpreter::Execute() {
 	varEval_t	var_a;
 	varEval_t	var_b;
 	varEval_t	var_c;
 	varEval_t	var;
-	statement_t	*st;
+	const loweredStatement_t *st;
 	int 		runaway;
 	idThread	*newThread;
 	float		floatVal;
@@ -963,6 +996,139 @@ bool idInterpreter::Execute() {
 
 	runaway = 5000000;
 
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+	static void *dispatchTable[ NUM_OPCODES ];
+	if ( dispatchTable[ OP_RETURN ] == NULL ) {
+		for( int i = 0; i < NUM_OPCODES; i++ ) {
+			dispatchTable[ i ] = &&label_default;
+		}
+		dispatchTable[ OP_RETURN ] = &&label_OP_RETURN;
+		dispatchTable[ OP_THREAD ] = &&label_OP_THREAD;
+		dispatchTable[ OP_OBJTHREAD ] = &&label_OP_OBJTHREAD;
+		dispatchTable[ OP_CALL ] = &&label_OP_CALL;
+		dispatchTable[ OP_EVENTCALL ] = &&label_OP_EVENTCALL;
+		dispatchTable[ OP_OBJECTCALL ] = &&label_OP_OBJECTCALL;
+		dispatchTable[ OP_SYSCALL ] = &&label_OP_SYSCALL;
+		dispatchTable[ OP_IFNOT ] = &&label_OP_IFNOT;
+		dispatchTable[ OP_IF ] = &&label_OP_IF;
+		dispatchTable[ OP_GOTO ] = &&label_OP_GOTO;
+		dispatchTable[ OP_ADD_F ] = &&label_OP_ADD_F;
+		dispatchTable[ OP_ADD_V ] = &&label_OP_ADD_V;
+		dispatchTable[ OP_ADD_S ] = &&label_OP_ADD_S;
+		dispatchTable[ OP_ADD_FS ] = &&label_OP_ADD_FS;
+		dispatchTable[ OP_ADD_SF ] = &&label_OP_ADD_SF;
+		dispatchTable[ OP_ADD_VS ] = &&label_OP_ADD_VS;
+		dispatchTable[ OP_ADD_SV ] = &&label_OP_ADD_SV;
+		dispatchTable[ OP_SUB_F ] = &&label_OP_SUB_F;
+		dispatchTable[ OP_SUB_V ] = &&label_OP_SUB_V;
+		dispatchTable[ OP_MUL_F ] = &&label_OP_MUL_F;
+		dispatchTable[ OP_MUL_V ] = &&label_OP_MUL_V;
+		dispatchTable[ OP_MUL_FV ] = &&label_OP_MUL_FV;
+		dispatchTable[ OP_MUL_VF ] = &&label_OP_MUL_VF;
+		dispatchTable[ OP_DIV_F ] = &&label_OP_DIV_F;
+		dispatchTable[ OP_MOD_F ] = &&label_OP_MOD_F;
+		dispatchTable[ OP_BITAND ] = &&label_OP_BITAND;
+		dispatchTable[ OP_BITOR ] = &&label_OP_BITOR;
+		dispatchTable[ OP_GE ] = &&label_OP_GE;
+		dispatchTable[ OP_LE ] = &&label_OP_LE;
+		dispatchTable[ OP_GT ] = &&label_OP_GT;
+		dispatchTable[ OP_LT ] = &&label_OP_LT;
+		dispatchTable[ OP_AND ] = &&label_OP_AND;
+		dispatchTable[ OP_AND_BOOLF ] = &&label_OP_AND_BOOLF;
+		dispatchTable[ OP_AND_FBOOL ] = &&label_OP_AND_FBOOL;
+		dispatchTable[ OP_AND_BOOLBOOL ] = &&label_OP_AND_BOOLBOOL;
+		dispatchTable[ OP_OR ] = &&label_OP_OR;
+		dispatchTable[ OP_OR_BOOLF ] = &&label_OP_OR_BOOLF;
+		dispatchTable[ OP_OR_FBOOL ] = &&label_OP_OR_FBOOL;
+		dispatchTable[ OP_OR_BOOLBOOL ] = &&label_OP_OR_BOOLBOOL;
+		dispatchTable[ OP_NOT_BOOL ] = &&label_OP_NOT_BOOL;
+		dispatchTable[ OP_NOT_F ] = &&label_OP_NOT_F;
+		dispatchTable[ OP_NOT_V ] = &&label_OP_NOT_V;
+		dispatchTable[ OP_NOT_S ] = &&label_OP_NOT_S;
+		dispatchTable[ OP_NOT_ENT ] = &&label_OP_NOT_ENT;
+		dispatchTable[ OP_NEG_F ] = &&label_OP_NEG_F;
+		dispatchTable[ OP_NEG_V ] = &&label_OP_NEG_V;
+		dispatchTable[ OP_INT_F ] = &&label_OP_INT_F;
+		dispatchTable[ OP_EQ_F ] = &&label_OP_EQ_F;
+		dispatchTable[ OP_EQ_V ] = &&label_OP_EQ_V;
+		dispatchTable[ OP_EQ_S ] = &&label_OP_EQ_S;
+		dispatchTable[ OP_EQ_E ] = &&label_OP_EQ_E;
+		dispatchTable[ OP_EQ_EO ] = &&label_OP_EQ_EO;
+		dispatchTable[ OP_EQ_OE ] = &&label_OP_EQ_OE;
+		dispatchTable[ OP_EQ_OO ] = &&label_OP_EQ_OO;
+		dispatchTable[ OP_NE_F ] = &&label_OP_NE_F;
+		dispatchTable[ OP_NE_V ] = &&label_OP_NE_V;
+		dispatchTable[ OP_NE_S ] = &&label_OP_NE_S;
+		dispatchTable[ OP_NE_E ] = &&label_OP_NE_E;
+		dispatchTable[ OP_NE_EO ] = &&label_OP_NE_EO;
+		dispatchTable[ OP_NE_OE ] = &&label_OP_NE_OE;
+		dispatchTable[ OP_NE_OO ] = &&label_OP_NE_OO;
+		dispatchTable[ OP_UADD_F ] = &&label_OP_UADD_F;
+		dispatchTable[ OP_UADD_V ] = &&label_OP_UADD_V;
+		dispatchTable[ OP_USUB_F ] = &&label_OP_USUB_F;
+		dispatchTable[ OP_USUB_V ] = &&label_OP_USUB_V;
+		dispatchTable[ OP_UMUL_F ] = &&label_OP_UMUL_F;
+		dispatchTable[ OP_UMUL_V ] = &&label_OP_UMUL_V;
+		dispatchTable[ OP_UDIV_F ] = &&label_OP_UDIV_F;
+		dispatchTable[ OP_UDIV_V ] = &&label_OP_UDIV_V;
+		dispatchTable[ OP_UMOD_F ] = &&label_OP_UMOD_F;
+		dispatchTable[ OP_UOR_F ] = &&label_OP_UOR_F;
+		dispatchTable[ OP_UAND_F ] = &&label_OP_UAND_F;
+		dispatchTable[ OP_UINC_F ] = &&label_OP_UINC_F;
+		dispatchTable[ OP_UINCP_F ] = &&label_OP_UINCP_F;
+		dispatchTable[ OP_UDEC_F ] = &&label_OP_UDEC_F;
+		dispatchTable[ OP_UDECP_F ] = &&label_OP_UDECP_F;
+		dispatchTable[ OP_COMP_F ] = &&label_OP_COMP_F;
+		dispatchTable[ OP_STORE_F ] = &&label_OP_STORE_F;
+		dispatchTable[ OP_STORE_ENT ] = &&label_OP_STORE_ENT;
+		dispatchTable[ OP_STORE_BOOL ] = &&label_OP_STORE_BOOL;
+		dispatchTable[ OP_STORE_OBJENT ] = &&label_OP_STORE_OBJENT;
+		dispatchTable[ OP_STORE_OBJ ] = &&label_OP_STORE_OBJ;
+		dispatchTable[ OP_STORE_ENTOBJ ] = &&label_OP_STORE_ENTOBJ;
+		dispatchTable[ OP_STORE_S ] = &&label_OP_STORE_S;
+		dispatchTable[ OP_STORE_V ] = &&label_OP_STORE_V;
+		dispatchTable[ OP_STORE_FTOS ] = &&label_OP_STORE_FTOS;
+		dispatchTable[ OP_STORE_BTOS ] = &&label_OP_STORE_BTOS;
+		dispatchTable[ OP_STORE_VTOS ] = &&label_OP_STORE_VTOS;
+		dispatchTable[ OP_STORE_FTOBOOL ] = &&label_OP_STORE_FTOBOOL;
+		dispatchTable[ OP_STORE_BOOLTOF ] = &&label_OP_STORE_BOOLTOF;
+		dispatchTable[ OP_STOREP_F ] = &&label_OP_STOREP_F;
+		dispatchTable[ OP_STOREP_ENT ] = &&label_OP_STOREP_ENT;
+		dispatchTable[ OP_STOREP_FLD ] = &&label_OP_STOREP_FLD;
+		dispatchTable[ OP_STOREP_BOOL ] = &&label_OP_STOREP_BOOL;
+		dispatchTable[ OP_STOREP_S ] = &&label_OP_STOREP_S;
+		dispatchTable[ OP_STOREP_V ] = &&label_OP_STOREP_V;
+		dispatchTable[ OP_STOREP_FTOS ] = &&label_OP_STOREP_FTOS;
+		dispatchTable[ OP_STOREP_BTOS ] = &&label_OP_STOREP_BTOS;
+		dispatchTable[ OP_STOREP_VTOS ] = &&label_OP_STOREP_VTOS;
+		dispatchTable[ OP_STOREP_FTOBOOL ] = &&label_OP_STOREP_FTOBOOL;
+		dispatchTable[ OP_STOREP_BOOLTOF ] = &&label_OP_STOREP_BOOLTOF;
+		dispatchTable[ OP_STOREP_OBJ ] = &&label_OP_STOREP_OBJ;
+		dispatchTable[ OP_STOREP_OBJENT ] = &&label_OP_STOREP_OBJENT;
+		dispatchTable[ OP_ADDRESS ] = &&label_OP_ADDRESS;
+		dispatchTable[ OP_INDIRECT_F ] = &&label_OP_INDIRECT_F;
+		dispatchTable[ OP_INDIRECT_ENT ] = &&label_OP_INDIRECT_ENT;
+		dispatchTable[ OP_INDIRECT_BOOL ] = &&label_OP_INDIRECT_BOOL;
+		dispatchTable[ OP_INDIRECT_S ] = &&label_OP_INDIRECT_S;
+		dispatchTable[ OP_INDIRECT_V ] = &&label_OP_INDIRECT_V;
+		dispatchTable[ OP_INDIRECT_OBJ ] = &&label_OP_INDIRECT_OBJ;
+		dispatchTable[ OP_PUSH_F ] = &&label_OP_PUSH_F;
+		dispatchTable[ OP_PUSH_FTOS ] = &&label_OP_PUSH_FTOS;
+		dispatchTable[ OP_PUSH_BTOF ] = &&label_OP_PUSH_BTOF;
+		dispatchTable[ OP_PUSH_FTOB ] = &&label_OP_PUSH_FTOB;
+		dispatchTable[ OP_PUSH_VTOS ] = &&label_OP_PUSH_VTOS;
+		dispatchTable[ OP_PUSH_BTOS ] = &&label_OP_PUSH_BTOS;
+		dispatchTable[ OP_PUSH_ENT ] = &&label_OP_PUSH_ENT;
+		dispatchTable[ OP_PUSH_S ] = &&label_OP_PUSH_S;
+		dispatchTable[ OP_PUSH_V ] = &&label_OP_PUSH_V;
+		dispatchTable[ OP_PUSH_OBJ ] = &&label_OP_PUSH_OBJ;
+		dispatchTable[ OP_PUSH_OBJENT ] = &&label_OP_PUSH_OBJENT;
+		dispatchTable[ OP_BREAK ] = &&label_OP_BREAK;
+		dispatchTable[ OP_CONTINUE ] = &&label_OP_CONTINUE;
+	}
+	const bool threadedDispatch = g_scriptThreadedDispatch.GetBool();
+#endif
+
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying ) {
 		instructionPointer++;
@@ -972,28 +1138,35 @@ bool idInterpreter::Execute() {
 		}
 
 		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+		st = &gameLocal.program.GetLoweredStatement( instructionPointer );
+
+#ifdef ID_SCRIPT_THREADED_DISPATCH
+		if ( threadedDispatch ) {
+			assert( st->op < NUM_OPCODES );
+			goto *dispatchTable[ st->op ];
+		}
+#endif
 
 		switch( st->op ) {
-		case OP_RETURN:
-			LeaveFunction( st->a );
-			break;
+		SCRIPT_OP( OP_RETURN ):
+			LeaveFunction( gameLocal.program.GetStatement( instructionPointer ).a );
+			SCRIPT_NEXT;
 
-		case OP_THREAD:
-			newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
+		SCRIPT_OP( OP_THREAD ):
+			newThread = new idThread( this, st->operands[ OPERAND_A ].functionPtr, st->operands[ OPERAND_B ].argSize );
 			newThread->Start();
 
 			// return the thread number to the script
 			gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
-			PopParms( st->b->value.argSize );
-			break;
+			PopParms( st->operands[ OPERAND_B ].argSize );
+			SCRIPT_NEXT;
 
-		case OP_OBJTHREAD:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_OBJTHREAD ):
+			var_a = GetVariable( st, OPERAND_A );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
-				assert( st->c->value.argSize == func->parmTotal );
+				func = obj->GetTypeDef()->GetFunction( st->operands[ OPERAND_B ].virtualFunction );
+				assert( st->operands[ OPERAND_C ].argSize == func->parmTotal );
 				newThread = new idThread( this, GetEntity( *var_a.entityNumberPtr ), func, func->parmTotal );
 				newThread->Start();
 
@@ -1003,142 +1176,142 @@ bool idInterpreter::Execute() {
 				// return a null thread to the script
 				gameLocal.program.ReturnFloat( 0.0f );
 			}
-			PopParms( st->c->value.argSize );
-			break;
+			PopParms( st->operands[ OPERAND_C ].argSize );
+			SCRIPT_NEXT;
 
-		case OP_CALL:
-			EnterFunction( st->a->value.functionPtr, false );
-			break;
+		SCRIPT_OP( OP_CALL ):
+			EnterFunction( st->operands[ OPERAND_A ].functionPtr, false );
+			SCRIPT_NEXT;
 
-		case OP_EVENTCALL:
-			CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+		SCRIPT_OP( OP_EVENTCALL ):
+			CallEvent( st->operands[ OPERAND_A ].functionPtr, st->operands[ OPERAND_B ].argSize );
+			SCRIPT_NEXT;
 
-		case OP_OBJECTCALL:	
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_OBJECTCALL ):	
+			var_a = GetVariable( st, OPERAND_A );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				func = obj->GetTypeDef()->GetFunction( st->b->value.virtualFunction );
+				func = obj->GetTypeDef()->GetFunction( st->operands[ OPERAND_B ].virtualFunction );
 				EnterFunction( func, false );
 			} else {
 				// return a 'safe' value
 				gameLocal.program.ReturnVector( vec3_zero );
 				gameLocal.program.ReturnString( "" );
-				PopParms( st->c->value.argSize );
+				PopParms( st->operands[ OPERAND_C ].argSize );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_SYSCALL:
-			CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-			break;
+		SCRIPT_OP( OP_SYSCALL ):
+			CallSysEvent( st->operands[ OPERAND_A ].functionPtr, st->operands[ OPERAND_B ].argSize );
+			SCRIPT_NEXT;
 
-		case OP_IFNOT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_IFNOT ):
+			var_a = GetVariable( st, OPERAND_A );
 			if ( *var_a.intPtr == 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + st->operands[ OPERAND_B ].jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_IF:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_IF ):
+			var_a = GetVariable( st, OPERAND_A );
 			if ( *var_a.intPtr != 0 ) {
-				NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				NextInstruction( instructionPointer + st->operands[ OPERAND_B ].jumpOffset );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GOTO:
-			NextInstruction( instructionPointer + st->a->value.jumpOffset );
-			break;
+		SCRIPT_OP( OP_GOTO ):
+			NextInstruction( instructionPointer + st->operands[ OPERAND_A ].jumpOffset );
+			SCRIPT_NEXT;
 
-		case OP_ADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADD_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_ADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADD_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-			break;
-
-		case OP_ADD_S:
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_FS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, FloatToString( *var_a.floatPtr ) );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SF:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-			break;
-
-		case OP_ADD_VS:
-			var_a = GetVariable( st->a );
-			SetString( st->c, var_a.vectorPtr->ToString() );
-			AppendString( st->c, GetString( st->b ) );
-			break;
-
-		case OP_ADD_SV:
-			var_b = GetVariable( st->b );
-			SetString( st->c, GetString( st->a ) );
-			AppendString( st->c, var_b.vectorPtr->ToString() );
-			break;
-
-		case OP_SUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_ADD_S ):
+			SetString( st, OPERAND_C, GetString( st, OPERAND_A ) );
+			AppendString( st, OPERAND_C, GetString( st, OPERAND_B ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_ADD_FS ):
+			var_a = GetVariable( st, OPERAND_A );
+			SetString( st, OPERAND_C, FloatToString( *var_a.floatPtr ) );
+			AppendString( st, OPERAND_C, GetString( st, OPERAND_B ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_ADD_SF ):
+			var_b = GetVariable( st, OPERAND_B );
+			SetString( st, OPERAND_C, GetString( st, OPERAND_A ) );
+			AppendString( st, OPERAND_C, FloatToString( *var_b.floatPtr ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_ADD_VS ):
+			var_a = GetVariable( st, OPERAND_A );
+			SetString( st, OPERAND_C, var_a.vectorPtr->ToString() );
+			AppendString( st, OPERAND_C, GetString( st, OPERAND_B ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_ADD_SV ):
+			var_b = GetVariable( st, OPERAND_B );
+			SetString( st, OPERAND_C, GetString( st, OPERAND_A ) );
+			AppendString( st, OPERAND_C, var_b.vectorPtr->ToString() );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_SUB_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_SUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_SUB_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = *var_a.floatPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = *var_a.vectorPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_FV:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_FV ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.vectorPtr = *var_a.floatPtr * *var_b.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MUL_VF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_MUL_VF ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.vectorPtr = *var_a.vectorPtr * *var_b.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_DIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_DIV_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1146,12 +1319,12 @@ bool idInterpreter::Execute() {
 			} else {
 				*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_MOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable ( st->c );
+		SCRIPT_OP( OP_MOD_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 
 			if ( *var_b.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1159,252 +1332,252 @@ bool idInterpreter::Execute() {
 			} else {
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BITAND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_BITAND ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BITOR:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_BITOR ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_GE ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_LE:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_LE ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_GT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_GT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_LT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_LT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_BOOLF ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_FBOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_AND_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_AND_BOOLBOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR:	
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR ):	
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR_BOOLF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_BOOLF ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_OR_FBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_FBOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 			
-		case OP_OR_BOOLBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_OR_BOOLBOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-			break;
+			SCRIPT_NEXT;
 			
-		case OP_NOT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_BOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.intPtr == 0 );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NOT_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-			break;
+		SCRIPT_OP( OP_NOT_S ):
+			var_c = GetVariable( st, OPERAND_C );
+			*var_c.floatPtr = ( strlen( GetString( st, OPERAND_A ) ) == 0 );
+			SCRIPT_NEXT;
 
-		case OP_NOT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NOT_ENT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NEG_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NEG_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = -*var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NEG_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NEG_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.vectorPtr = -*var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INT_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_EQ_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_EQ_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_EQ_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_EQ_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-			break;
-
-		case OP_EQ_S:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-			break;
-
-		case OP_EQ_E:
-		case OP_EQ_EO:
-		case OP_EQ_OE:
-		case OP_EQ_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_EQ_S ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( st, OPERAND_A ), GetString( st, OPERAND_B ) ) == 0 );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_EQ_E ):
+		SCRIPT_OP( OP_EQ_EO ):
+		SCRIPT_OP( OP_EQ_OE ):
+		SCRIPT_OP( OP_EQ_OO ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NE_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_NE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_NE_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-			break;
-
-		case OP_NE_S:
-			var_c = GetVariable( st->c );
-			*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-			break;
-
-		case OP_NE_E:
-		case OP_NE_EO:
-		case OP_NE_OE:
-		case OP_NE_OO:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
-			var_c = GetVariable( st->c );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_NE_S ):
+			var_c = GetVariable( st, OPERAND_C );
+			*var_c.floatPtr = ( idStr::Cmp( GetString( st, OPERAND_A ), GetString( st, OPERAND_B ) ) != 0 );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_NE_E ):
+		SCRIPT_OP( OP_NE_EO ):
+		SCRIPT_OP( OP_NE_OE ):
+		SCRIPT_OP( OP_NE_OO ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UADD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UADD_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr += *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UADD_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UADD_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.vectorPtr += *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_USUB_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_USUB_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr -= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_USUB_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_USUB_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.vectorPtr -= *var_a.vectorPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMUL_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMUL_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMUL_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMUL_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.vectorPtr *= *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDIV_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UDIV_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1412,11 +1585,11 @@ bool idInterpreter::Execute() {
 			} else {
 				*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDIV_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UDIV_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1424,11 +1597,11 @@ bool idInterpreter::Execute() {
 			} else {
 				*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UMOD_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UMOD_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 
 			if ( *var_a.floatPtr == 0.0f ) {
 				Warning( "Divide by zero" );
@@ -1436,241 +1609,241 @@ bool idInterpreter::Execute() {
 			} else {
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UOR_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UOR_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UAND_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_UAND_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UINC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UINC_F ):
+			var_a = GetVariable( st, OPERAND_A );
 			( *var_a.floatPtr )++;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UINCP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UINCP_F ):
+			var_a = GetVariable( st, OPERAND_A );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				( *var.floatPtr )++;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDEC_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UDEC_F ):
+			var_a = GetVariable( st, OPERAND_A );
 			( *var_a.floatPtr )--;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_UDECP_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_UDECP_F ):
+			var_a = GetVariable( st, OPERAND_A );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				( *var.floatPtr )--;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_COMP_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_COMP_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_F:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr = *var_a.floatPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_ENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_ENT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_BOOL:	
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_BOOL ):	
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.intPtr = *var_a.intPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_OBJENT:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_OBJENT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_b.entityNumberPtr = 0;
-			} else if ( !obj->GetTypeDef()->Inherits( st->b->TypeDef() ) ) {
-				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->b->TypeDef()->Name() );
+			} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).b->TypeDef() ) ) {
+				//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), gameLocal.program.GetStatement( instructionPointer ).b->TypeDef()->Name() );
 				*var_b.entityNumberPtr = 0;
 			} else {
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_OBJ:
-		case OP_STORE_ENTOBJ:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_OBJ ):
+		SCRIPT_OP( OP_STORE_ENTOBJ ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_S:
-			SetString( st->b, GetString( st->a ) );
-			break;
+		SCRIPT_OP( OP_STORE_S ):
+			SetString( st, OPERAND_B, GetString( st, OPERAND_A ) );
+			SCRIPT_NEXT;
 
-		case OP_STORE_V:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.vectorPtr = *var_a.vectorPtr;
-			break;
-
-		case OP_STORE_FTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, FloatToString( *var_a.floatPtr ) );
-			break;
-
-		case OP_STORE_BTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, *var_a.intPtr ? "true" : "false" );
-			break;
-
-		case OP_STORE_VTOS:
-			var_a = GetVariable( st->a );
-			SetString( st->b, var_a.vectorPtr->ToString() );
-			break;
-
-		case OP_STORE_FTOBOOL:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_STORE_FTOS ):
+			var_a = GetVariable( st, OPERAND_A );
+			SetString( st, OPERAND_B, FloatToString( *var_a.floatPtr ) );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_STORE_BTOS ):
+			var_a = GetVariable( st, OPERAND_A );
+			SetString( st, OPERAND_B, *var_a.intPtr ? "true" : "false" );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_STORE_VTOS ):
+			var_a = GetVariable( st, OPERAND_A );
+			SetString( st, OPERAND_B, var_a.vectorPtr->ToString() );
+			SCRIPT_NEXT;
+
+		SCRIPT_OP( OP_STORE_FTOBOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			if ( *var_a.floatPtr != 0.0f ) {
 				*var_b.intPtr = 1;
 			} else {
 				*var_b.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STORE_BOOLTOF:
-			var_a = GetVariable( st->a );
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STORE_BOOLTOF ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_b = GetVariable( st, OPERAND_B );
 			*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_F:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_F ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_ENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_ENT ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_FLD:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FLD ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BOOL ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->intPtr = *var_a.intPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_S:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_S ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
+				idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st, OPERAND_A ), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_V:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_V ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->vectorPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 		
-		case OP_STOREP_FTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FTOS ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BTOS ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				if ( *var_a.floatPtr != 0.0f ) {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "true", MAX_STRING_LEN );
 				} else {
 					idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_VTOS:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_VTOS ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->stringPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_FTOBOOL:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_FTOBOOL ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->intPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				if ( *var_a.floatPtr != 0.0f ) {
 					*var_b.evalPtr->intPtr = 1;
 				} else {
 					*var_b.evalPtr->intPtr = 0;
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_BOOLTOF:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_BOOLTOF ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->floatPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_OBJ:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_OBJ ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_STOREP_OBJENT:
-			var_b = GetVariable( st->b );
+		SCRIPT_OP( OP_STOREP_OBJENT ):
+			var_b = GetVariable( st, OPERAND_B );
 			if ( var_b.evalPtr && var_b.evalPtr->entityNumberPtr ) {
-				var_a = GetVariable( st->a );
+				var_a = GetVariable( st, OPERAND_A );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if ( !obj ) {
 					*var_b.evalPtr->entityNumberPtr = 0;
@@ -1678,163 +1851,168 @@ bool idInterpreter::Execute() {
 				// st->b points to type_pointer, which is just a temporary that gets its type reassigned, so we store the real type in st->c
 				// so that we can do a type check during run time since we don't know what type the script object is at compile time because it
 				// comes from an entity
-				} else if ( !obj->GetTypeDef()->Inherits( st->c->TypeDef() ) ) {
-					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), st->c->TypeDef()->Name() );
+				} else if ( !obj->GetTypeDef()->Inherits( gameLocal.program.GetStatement( instructionPointer ).c->TypeDef() ) ) {
+					//Warning( "object '%s' cannot be converted to '%s'", obj->GetTypeName(), gameLocal.program.GetStatement( instructionPointer ).c->TypeDef()->Name() );
 					*var_b.evalPtr->entityNumberPtr = 0;
 				} else {
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_ADDRESS:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_ADDRESS ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var_c.evalPtr->bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var_c.evalPtr->bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 			} else {
 				var_c.evalPtr->bytePtr = NULL;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_F:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_F ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				*var_c.floatPtr = *var.floatPtr;
 			} else {
 				*var_c.floatPtr = 0.0f;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_ENT:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_ENT ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			} else {
 				*var_c.entityNumberPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_BOOL:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_BOOL ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				*var_c.intPtr = *var.intPtr;
 			} else {
 				*var_c.intPtr = 0;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_S:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_INDIRECT_S ):
+			var_a = GetVariable( st, OPERAND_A );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
-				SetString( st->c, var.stringPtr );
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
+				SetString( st, OPERAND_C, var.stringPtr );
 			} else {
-				SetString( st->c, "" );
+				SetString( st, OPERAND_C, "" );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_V:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_V ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( obj ) {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				*var_c.vectorPtr = *var.vectorPtr;
 			} else {
 				var_c.vectorPtr->Zero();
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_INDIRECT_OBJ:
-			var_a = GetVariable( st->a );
-			var_c = GetVariable( st->c );
+		SCRIPT_OP( OP_INDIRECT_OBJ ):
+			var_a = GetVariable( st, OPERAND_A );
+			var_c = GetVariable( st, OPERAND_C );
 			obj = GetScriptObject( *var_a.entityNumberPtr );
 			if ( !obj ) {
 				*var_c.entityNumberPtr = 0;
 			} else {
-				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				var.bytePtr = &obj->data[ st->operands[ OPERAND_B ].ptrOffset ];
 				*var_c.entityNumberPtr = *var.entityNumberPtr;
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_F:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_F ):
+			var_a = GetVariable( st, OPERAND_A );
 			Push( *var_a.intPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_FTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_FTOS ):
+			var_a = GetVariable( st, OPERAND_A );
 			PushString( FloatToString( *var_a.floatPtr ) );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_BTOF:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_BTOF ):
+			var_a = GetVariable( st, OPERAND_A );
 			floatVal = *var_a.intPtr;
 			Push( *reinterpret_cast<int *>( &floatVal ) );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_FTOB:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_FTOB ):
+			var_a = GetVariable( st, OPERAND_A );
 			if ( *var_a.floatPtr != 0.0f ) {
 				Push( 1 );
 			} else {
 				Push( 0 );
 			}
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_VTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_VTOS ):
+			var_a = GetVariable( st, OPERAND_A );
 			PushString( var_a.vectorPtr->ToString() );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_BTOS:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_BTOS ):
+			var_a = GetVariable( st, OPERAND_A );
 			PushString( *var_a.intPtr ? "true" : "false" );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_ENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_ENT ):
+			var_a = GetVariable( st, OPERAND_A );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_S:
-			PushString( GetString( st->a ) );
-			break;
+		SCRIPT_OP( OP_PUSH_S ):
+			PushString( GetString( st, OPERAND_A ) );
+			SCRIPT_NEXT;
 
-		case OP_PUSH_V:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_V ):
+			var_a = GetVariable( st, OPERAND_A );
 			PushVector( *var_a.vectorPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_OBJ:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_OBJ ):
+			var_a = GetVariable( st, OPERAND_A );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_PUSH_OBJENT:
-			var_a = GetVariable( st->a );
+		SCRIPT_OP( OP_PUSH_OBJENT ):
+			var_a = GetVariable( st, OPERAND_A );
 			Push( *var_a.entityNumberPtr );
-			break;
+			SCRIPT_NEXT;
 
-		case OP_BREAK:
-		case OP_CONTINUE:
-		default:
+		SCRIPT_OP( OP_BREAK ):
+		SCRIPT_OP( OP_CONTINUE ):
+		SCRIPT_OP_DEFAULT:
 			Error( "Bad opcode %i", st->op );
-			break;
+			SCRIPT_NEXT;
 		}
 	}
 
 	return threadDying;
 }
+
+#undef ID_SCRIPT_EXECUTE_ATTRIBUTES
+#undef SCRIPT_OP
+#undef SCRIPT_OP_DEFAULT
+#undef SCRIPT_NEXT
@@ -67,6 +67,10 @@ private:
 	void				SetString( idVarDef *def, const char *from );
 	const char			*GetString( idVarDef *def );
 	varEval_t			GetVariable( idVarDef *def );
+	void				AppendString( const loweredStatement_t *st, int operand, const char *from );
+	void				SetString( const loweredStatement_t *st, int operand, const char *from );
+	const char			*GetString( const loweredStatement_t *st, int operand );
+	varEval_t			GetVariable( const loweredStatement_t *st, int operand );
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
@@ -240,6 +244,60 @@ ID_INLINE varEval_t idInterpreter::GetVariable( idVarDef *def ) {
 	}
 }
 
+/*
+====================
+idInterpreter::AppendString
+====================
+*/
+ID_INLINE void idInterpreter::AppendString( const loweredStatement_t *st, int operand, const char *from ) {
+	if ( st->stackBits & BIT( operand ) ) {
+		idStr::Append( ( char * )&localstack[ localstackBase + st->operands[ operand ].stackOffset ], MAX_STRING_LEN, from );
+	} else {
+		idStr::Append( st->operands[ operand ].stringPtr, MAX_STRING_LEN, from );
+	}
+}
+
+/*
+====================
+idInterpreter::SetString
+====================
+*/
+ID_INLINE void idInterpreter::SetString( const loweredStatement_t *st, int operand, const char *from ) {
+	if ( st->stackBits & BIT( operand ) ) {
+		idStr::Copynz( ( char * )&localstack[ localstackBase + st->operands[ operand ].stackOffset ], from, MAX_STRING_LEN );
+	} else {
+		idStr::Copynz( st->operands[ operand ].stringPtr, from, MAX_STRING_LEN );
+	}
+}
+
+/*
+====================
+idInterpreter::GetString
+====================
+*/
+ID_INLINE const char *idInterpreter::GetString( const loweredStatement_t *st, int operand ) {
+	if ( st->stackBits & BIT( operand ) ) {
+		return ( char * )&localstack[ localstackBase + st->operands[ operand ].stackOffset ];
+	} else {
+		return st->operands[ operand ].stringPtr;
+	}
+}
+
+/*
+====================
+idInterpreter::GetVariable
+====================
+*/
+ID_INLINE varEval_t idInterpreter::GetVariable( const loweredStatement_t *st, int operand ) {
+	if ( st->stackBits & BIT( operand ) ) {
+		varEval_t val;
+		val.intPtr = ( int * )&localstack[ localstackBase + st->operands[ operand ].stackOffset ];
+		return val;
+	} else {
+		return st->operands[ operand ];
+	}
+}
+
 /*
 ================
 idInterpreter::GetEntity
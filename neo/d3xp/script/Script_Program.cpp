@@ -32,6 +32,12 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
+idCVar binaryLoadScripts( "binaryLoadScripts", "1", 0, "enable binary load/write of the compiled default script" );
+
+static const byte B_SCRIPT_VERSION = 100;
+static const unsigned int B_SCRIPT_MAGIC = ( 'B' << 24 ) | ( 'S' << 16 ) | ( 'C' << 8 ) | B_SCRIPT_VERSION;
+#define SCRIPT_BINARYFILE_EXT	"bscript"
+
 // simple types.  function types are dynamically allocated
 idTypeDef	type_void( ev_void, &def_void, "void", 0, NULL );
 idTypeDef	type_scriptevent( ev_scriptevent, &def_scriptevent, "scriptevent", sizeof( intptr_t ), NULL );
@@ -1737,6 +1743,9 @@ void idProgram::FinishCompilation() {
 	top_defs		= varDefs.Num();
 	top_files		= fileList.Num();
 
+	// the binary load path never goes through CompileText
+	LowerStatements();
+
 	variableDefaults.Clear();
 	variableDefaults.SetNum( numVariables );
 
@@ -1745,6 +1754,44 @@ void idProgram::FinishCompilation() {
 	}
 }
 
+/*
+==============
+idProgram::LowerStatements
+
+Resolves the operands of any statements added since the last call.  Every
+def referenced by a statement is final by the time its text has compiled.
+==============
+*/
+void idProgram::LowerStatements() {
+	int i, j;
+
+	i = loweredStatements.Num();
+	if ( i > statements.Num() ) {
+		i = statements.Num();
+	}
+	loweredStatements.SetNum( statements.Num() );
+
+	for( ; i < statements.Num(); i++ ) {
+		const statement_t &statement = statements[ i ];
+		loweredStatement_t &lowered = loweredStatements[ i ];
+
+		lowered.op = statement.op;
+		lowered.stackBits = 0;
+
+		const idVarDef *defs[ 3 ] = { statement.a, statement.b, statement.c };
+		for( j = 0; j < 3; j++ ) {
+			memset( &lowered.operands[ j ], 0, sizeof( lowered.operands[ j ] ) );
+			if ( defs[ j ] == NULL ) {
+				continue;
+			}
+			lowered.operands[ j ] = defs[ j ]->value;
+			if ( defs[ j ]->initialized == idVarDef::stackVariable ) {
+				lowered.stackBits |= BIT( j );
+			}
+		}
+	}
+}
+
 /*
 ==============
 idProgram::CompileStats
@@ -1787,6 +1834,7 @@ void idProgram::CompileStats() {
 	memallocated = funcMem + memused + sizeof( idProgram );
 
 	memused += statements.MemoryUsed();
+	memused += loweredStatements.MemoryUsed();
 	memused += functions.MemoryUsed();	// name and filename of functions are shared, so no need to include them
 	memused += sizeof( variables );
 
@@ -1839,6 +1887,8 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 		}
 	};
 
+	LowerStatements();
+
 	if ( !console ) {
 		CompileStats();
 	}
@@ -1927,6 +1977,7 @@ void idProgram::FreeData() {
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	loweredStatements.Clear();
 	functions.Clear();
 
 	top_functions	= 0;
@@ -1938,6 +1989,584 @@ void idProgram::FreeData() {
 	filename = "";
 }
 
+/*
+================
+ScriptSourceChecksum
+
+Covers everything the default script can include and the script events built into the
+game, since the compiled program stores event and type information for both.
+================
+*/
+static unsigned int ScriptSourceChecksum( bool checkTimeStamps ) {
+	unsigned int checksum;
+	CRC32_InitChecksum( checksum );
+
+	const int pointerSize = sizeof( intptr_t );
+	CRC32_UpdateChecksum( checksum, &pointerSize, sizeof( pointerSize ) );
+
+	for ( int i = 0; i < idEventDef::NumEventCommands(); i++ ) {
+		const idEventDef *ev = idEventDef::GetEventCommand( i );
+		const char returnType = ev->GetReturnType();
+		CRC32_UpdateChecksum( checksum, ev->GetName(), idStr::Length( ev->GetName() ) );
+		CRC32_UpdateChecksum( checksum, ev->GetArgFormat(), idStr::Length( ev->GetArgFormat() ) );
+		CRC32_UpdateChecksum( checksum, &returnType, sizeof( returnType ) );
+	}
+
+	if ( checkTimeStamps ) {
+		idFileList *files = fileSystem->ListFilesTree( "script", ".script", true );
+		for ( int i = 0; i < files->GetNumFiles(); i++ ) {
+			const char *name = files->GetFile( i );
+			ID_TIME_T timeStamp = fileSystem->GetTimestamp( name );
+			CRC32_UpdateChecksum( checksum, name, idStr::Length( name ) );
+			CRC32_UpdateChecksum( checksum, &timeStamp, sizeof( timeStamp ) );
+		}
+		fileSystem->FreeFileList( files );
+	}
+
+	CRC32_FinishChecksum( checksum );
+	return checksum;
+}
+
+// the simple types and their defs are static, the binary refers to them by their position here
+static idTypeDef * const builtinTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef * const builtinDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int NUM_BUILTIN_TYPES = sizeof( builtinTypes ) / sizeof( builtinTypes[ 0 ] );
+static const int NUM_BUILTIN_DEFS = sizeof( builtinDefs ) / sizeof( builtinDefs[ 0 ] );
+
+// references are -1 for NULL, the index in the program, or -2 - the builtin index
+static const int SCRIPT_REF_NULL = -1;
+static const int SCRIPT_REF_INVALID = 0x7fffffff;
+
+// what the value union of a var def holds
+enum {
+	SCRIPT_VALUE_INT,			// stack offset, field offset, jump offset, ...
+	SCRIPT_VALUE_VARIABLE,		// offset into the global variables
+	SCRIPT_VALUE_FUNCTION		// function index
+};
+
+/*
+================
+TypePointerHash
+================
+*/
+static ID_INLINE int TypePointerHash( const idTypeDef *type ) {
+	return (int)( ( (intptr_t)type ) >> 4 );
+}
+
+/*
+================
+idProgram::TypeIndex
+================
+*/
+int idProgram::TypeIndex( const idTypeDef *type, const idHashIndex &typeIndexHash ) const {
+	if ( type == NULL ) {
+		return SCRIPT_REF_NULL;
+	}
+	for ( int i = typeIndexHash.First( TypePointerHash( type ) ); i != -1; i = typeIndexHash.Next( i ) ) {
+		if ( types[ i ] == type ) {
+			return i;
+		}
+	}
+	for ( int i = 0; i < NUM_BUILTIN_TYPES; i++ ) {
+		if ( builtinTypes[ i ] == type ) {
+			return -2 - i;
+		}
+	}
+	return SCRIPT_REF_INVALID;
+}
+
+/*
+================
+idProgram::ReadTypeRef
+
+Returns false if the reference is truncated or doesn't name a loaded or builtin type
+================
+*/
+bool idProgram::ReadTypeRef( idFile *file, idTypeDef *&type ) const {
+	int index = SCRIPT_REF_INVALID;
+	file->ReadBig( index );
+	type = NULL;
+	if ( index == SCRIPT_REF_NULL ) {
+		return true;
+	}
+	if ( index < 0 ) {
+		if ( -2 - index >= NUM_BUILTIN_TYPES ) {
+			return false;
+		}
+		type = builtinTypes[ -2 - index ];
+		return true;
+	}
+	if ( index >= types.Num() ) {
+		return false;
+	}
+	type = types[ index ];
+	return true;
+}
+
+/*
+================
+idProgram::DefIndex
+================
+*/
+int idProgram::DefIndex( const idVarDef *def ) const {
+	if ( def == NULL ) {
+		return SCRIPT_REF_NULL;
+	}
+	if ( def->num >= 0 && def->num < varDefs.Num() && varDefs[ def->num ] == def ) {
+		return def->num;
+	}
+	for ( int i = 0; i < NUM_BUILTIN_DEFS; i++ ) {
+		if ( builtinDefs[ i ] == def ) {
+			return -2 - i;
+		}
+	}
+	return SCRIPT_REF_INVALID;
+}
+
+/*
+================
+idProgram::ReadDefRef
+
+Returns false if the reference is truncated or doesn't name a loaded or builtin def
+================
+*/
+bool idProgram::ReadDefRef( idFile *file, idVarDef *&def ) const {
+	int index = SCRIPT_REF_INVALID;
+	file->ReadBig( index );
+	def = NULL;
+	if ( index == SCRIPT_REF_NULL ) {
+		return true;
+	}
+	if ( index < 0 ) {
+		if ( -2 - index >= NUM_BUILTIN_DEFS ) {
+			return false;
+		}
+		def = builtinDefs[ -2 - index ];
+		return true;
+	}
+	if ( index >= varDefs.Num() ) {
+		return false;
+	}
+	def = varDefs[ index ];
+	return true;
+}
+
+/*
+================
+ReadBinaryCount
+
+Every counted entry takes at least one byte, so a count larger than what's left of the file is garbage
+================
+*/
+static bool ReadBinaryCount( idFile *file, int &count, int maxCount ) {
+	count = -1;
+	file->ReadBig( count );
+	return ( count >= 0 && count <= maxCount && count <= file->Length() - file->Tell() );
+}
+
+/*
+================
+ReadBinaryString
+
+Checks the length prefix so a damaged file can't make ReadString allocate a huge buffer
+================
+*/
+static bool ReadBinaryString( idFile *file, idStr &str ) {
+	int len = -1;
+	file->ReadInt( len );
+	if ( len < 0 || len > file->Length() - file->Tell() ) {
+		return false;
+	}
+	str.Fill( ' ', len );
+	return ( file->Read( &str[ 0 ], len ) == len );
+}
+
+/*
+================
+idProgram::LoadBinary
+
+Replaces the program with a compiled binary, returns false if the binary is missing, out of date or damaged
+================
+*/
+bool idProgram::LoadBinary( idFile *file, unsigned int sourceChecksum ) {
+	if ( file == NULL ) {
+		return false;
+	}
+
+	unsigned int magic = 0;
+	file->ReadBig( magic );
+	if ( magic != B_SCRIPT_MAGIC ) {
+		return false;
+	}
+
+	unsigned int loadedChecksum = 0;
+	file->ReadBig( loadedChecksum );
+	if ( loadedChecksum != sourceChecksum ) {
+		return false;
+	}
+
+	FreeData();
+
+	if ( !ReadBinaryProgram( file ) ) {
+		gameLocal.Warning( "Script binary '%s' is damaged, recompiling", file->GetName() );
+		FreeData();
+		return false;
+	}
+
+	return true;
+}
+
+/*
+================
+idProgram::ReadBinaryProgram
+
+Reads everything after the header, returns false as soon as a count, index or string doesn't fit
+================
+*/
+bool idProgram::ReadBinaryProgram( idFile *file ) {
+	int i, j, num;
+
+	int numTypes, numDefs, numFunctions, numStatements;
+	if ( !ReadBinaryCount( file, numTypes, INT_MAX ) || !ReadBinaryCount( file, numDefs, INT_MAX ) ||
+		!ReadBinaryCount( file, numFunctions, MAX_FUNCS ) || !ReadBinaryCount( file, numStatements, MAX_STATEMENTS ) ) {
+		return false;
+	}
+
+	// allocate everything first so references can be resolved as they are read
+	for ( i = 0; i < numTypes; i++ ) {
+		types.Append( new (TAG_SCRIPT) idTypeDef( ev_void, NULL, "", 0, NULL ) );
+	}
+	for ( i = 0; i < numDefs; i++ ) {
+		idVarDef *def = new (TAG_SCRIPT) idVarDef( NULL );
+		def->num = varDefs.Append( def );
+	}
+	functions.SetNum( numFunctions );
+	for ( i = 0; i < numFunctions; i++ ) {
+		functions[ i ].Clear();
+		functions[ i ].parmSize.SetGranularity( 1 );
+	}
+	statements.SetNum( numStatements );
+
+	if ( !ReadBinaryCount( file, num, INT_MAX ) ) {
+		return false;
+	}
+	fileList.SetNum( num );
+	for ( i = 0; i < num; i++ ) {
+		if ( !ReadBinaryString( file, fileList[ i ] ) ) {
+			return false;
+		}
+	}
+
+	if ( !ReadBinaryCount( file, numVariables, MAX_GLOBALS ) ) {
+		return false;
+	}
+	if ( file->Read( variables, numVariables ) != numVariables ) {
+		return false;
+	}
+
+	idStr str;
+	int ref;
+	for ( i = 0; i < numTypes; i++ ) {
+		idTypeDef *type = types[ i ];
+
+		num = -1;
+		file->ReadBig( num );
+		if ( num < ev_void || num > ev_boolean ) {
+			return false;
+		}
+		type->type = (etype_t)num;
+		if ( !ReadBinaryString( file, type->name ) ) {
+			return false;
+		}
+		file->ReadBig( type->size );
+		if ( !ReadTypeRef( file, type->auxType ) || !ReadDefRef( file, type->def ) ) {
+			return false;
+		}
+
+		if ( !ReadBinaryCount( file, num, INT_MAX ) ) {
+			return false;
+		}
+		type->parmTypes.SetNum( num );
+		type->parmNames.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			if ( !ReadTypeRef( file, type->parmTypes[ j ] ) || !ReadBinaryString( file, type->parmNames[ j ] ) ) {
+				return false;
+			}
+		}
+
+		if ( !ReadBinaryCount( file, num, MAX_FUNCS ) ) {
+			return false;
+		}
+		type->functions.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			ref = -1;
+			file->ReadBig( ref );
+			if ( ref < 0 || ref >= numFunctions ) {
+				return false;
+			}
+			type->functions[ j ] = &functions[ ref ];
+		}
+
+		typesHash.Add( idStr::Hash( type->Name() ), i );
+	}
+
+	for ( i = 0; i < numDefs; i++ ) {
+		idVarDef *def = varDefs[ i ];
+
+		if ( !ReadBinaryString( file, str ) ) {
+			return false;
+		}
+		idTypeDef *type;
+		if ( !ReadTypeRef( file, type ) || type == NULL ) {
+			return false;
+		}
+		def->SetTypeDef( type );
+		if ( !ReadDefRef( file, def->scope ) ) {
+			return false;
+		}
+		file->ReadBig( def->numUsers );
+		num = -1;
+		file->ReadBig( num );
+		if ( num < idVarDef::uninitialized || num > idVarDef::stackVariable ) {
+			return false;
+		}
+		def->initialized = (idVarDef::initialized_t)num;
+
+		int valueType = -1, value = -1;
+		file->ReadBig( valueType );
+		file->ReadBig( value );
+		if ( valueType == SCRIPT_VALUE_VARIABLE ) {
+			if ( value < 0 || value >= MAX_GLOBALS ) {
+				return false;
+			}
+			def->value.bytePtr = &variables[ value ];
+		} else if ( valueType == SCRIPT_VALUE_FUNCTION ) {
+			if ( value < 0 || value >= numFunctions ) {
+				return false;
+			}
+			def->value.functionPtr = &functions[ value ];
+		} else if ( valueType == SCRIPT_VALUE_INT ) {
+			def->value.ptrOffset = value;
+		} else {
+			return false;
+		}
+
+		// defs are added in the order they were allocated so the name lists match the compiled program
+		AddDefToNameList( def, str );
+	}
+
+	for ( i = 0; i < numFunctions; i++ ) {
+		function_t &func = functions[ i ];
+
+		if ( !ReadBinaryString( file, str ) ) {
+			return false;
+		}
+		func.SetName( str );
+		if ( !ReadBinaryString( file, str ) ) {
+			return false;
+		}
+		if ( str.Length() ) {
+			func.eventdef = idEventDef::FindEvent( str );
+			if ( func.eventdef == NULL ) {
+				return false;
+			}
+		}
+		idTypeDef *funcType;
+		if ( !ReadDefRef( file, func.def ) || !ReadTypeRef( file, funcType ) ) {
+			return false;
+		}
+		func.type = funcType;
+		func.firstStatement = -1;
+		func.numStatements = -1;
+		func.filenum = -1;
+		file->ReadBig( func.firstStatement );
+		file->ReadBig( func.numStatements );
+		file->ReadBig( func.parmTotal );
+		file->ReadBig( func.locals );
+		file->ReadBig( func.filenum );
+		if ( func.firstStatement < 0 || func.numStatements < 0 || func.numStatements > numStatements - func.firstStatement ) {
+			return false;
+		}
+		if ( func.filenum < 0 || ( func.filenum >= fileList.Num() && func.filenum != 0 ) ) {
+			return false;
+		}
+		if ( !ReadBinaryCount( file, num, INT_MAX ) ) {
+			return false;
+		}
+		func.parmSize.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			file->ReadBig( func.parmSize[ j ] );
+		}
+	}
+
+	for ( i = 0; i < numStatements; i++ ) {
+		statement_t &statement = statements[ i ];
+
+		statement.op = NUM_OPCODES;
+		file->ReadBig( statement.op );
+		if ( statement.op >= NUM_OPCODES ) {
+			return false;
+		}
+		if ( !ReadDefRef( file, statement.a ) || !ReadDefRef( file, statement.b ) || !ReadDefRef( file, statement.c ) ) {
+			return false;
+		}
+		file->ReadBig( statement.linenumber );
+		file->ReadBig( statement.file );
+		if ( statement.file >= fileList.Num() && statement.file != 0 ) {
+			return false;
+		}
+	}
+
+	if ( !ReadDefRef( file, returnDef ) || !ReadDefRef( file, returnStringDef ) || !ReadDefRef( file, sysDef ) ) {
+		return false;
+	}
+
+	unsigned int endMagic = 0;
+	file->ReadBig( endMagic );
+	return ( endMagic == B_SCRIPT_MAGIC );
+}
+
+/*
+================
+idProgram::WriteBinary
+
+Returns false if the program refers to something that can't be written, the file should be discarded then
+================
+*/
+bool idProgram::WriteBinary( idFile *file, unsigned int sourceChecksum ) const {
+	int i, j;
+
+	if ( file == NULL ) {
+		return false;
+	}
+
+	idHashIndex typeIndexHash( 4096, types.Num() );
+	for ( i = 0; i < types.Num(); i++ ) {
+		typeIndexHash.Add( TypePointerHash( types[ i ] ), i );
+	}
+
+	bool valid = true;
+
+	file->WriteBig( B_SCRIPT_MAGIC );
+	file->WriteBig( sourceChecksum );
+
+	file->WriteBig( types.Num() );
+	file->WriteBig( varDefs.Num() );
+	file->WriteBig( functions.Num() );
+	file->WriteBig( statements.Num() );
+
+	file->WriteBig( fileList.Num() );
+	for ( i = 0; i < fileList.Num(); i++ ) {
+		file->WriteString( fileList[ i ] );
+	}
+
+	file->WriteBig( numVariables );
+	file->Write( variables, numVariables );
+
+	int ref;
+	for ( i = 0; i < types.Num(); i++ ) {
+		const idTypeDef *type = types[ i ];
+
+		file->WriteBig( (int)type->type );
+		file->WriteString( type->name );
+		file->WriteBig( type->size );
+		file->WriteBig( ref = TypeIndex( type->auxType, typeIndexHash ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( ref = DefIndex( type->def ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+
+		file->WriteBig( type->parmTypes.Num() );
+		for ( j = 0; j < type->parmTypes.Num(); j++ ) {
+			file->WriteBig( ref = TypeIndex( type->parmTypes[ j ], typeIndexHash ) );
+			valid &= ( ref != SCRIPT_REF_INVALID );
+			file->WriteString( type->parmNames[ j ] );
+		}
+
+		file->WriteBig( type->functions.Num() );
+		for ( j = 0; j < type->functions.Num(); j++ ) {
+			file->WriteBig( functions.IndexOf( type->functions[ j ] ) );
+		}
+	}
+
+	const byte *variablesEnd = variables + sizeof( variables );
+	const function_t *functionsStart = functions.Ptr();
+	const function_t *functionsEnd = functionsStart + functions.Num();
+	for ( i = 0; i < varDefs.Num(); i++ ) {
+		const idVarDef *def = varDefs[ i ];
+
+		file->WriteString( def->Name() );
+		file->WriteBig( ref = TypeIndex( def->TypeDef(), typeIndexHash ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( ref = DefIndex( def->scope ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( def->numUsers );
+		file->WriteBig( (int)def->initialized );
+
+		if ( def->value.bytePtr >= variables && def->value.bytePtr < variablesEnd ) {
+			file->WriteBig( (int)SCRIPT_VALUE_VARIABLE );
+			file->WriteBig( (int)( def->value.bytePtr - variables ) );
+		} else if ( def->value.functionPtr >= functionsStart && def->value.functionPtr < functionsEnd ) {
+			file->WriteBig( (int)SCRIPT_VALUE_FUNCTION );
+			file->WriteBig( (int)( def->value.functionPtr - functionsStart ) );
+		} else {
+			// anything else has to be one of the integer members
+			valid &= ( (uintptr_t)def->value.bytePtr == (uintptr_t)(unsigned int)def->value.ptrOffset );
+			file->WriteBig( (int)SCRIPT_VALUE_INT );
+			file->WriteBig( def->value.ptrOffset );
+		}
+	}
+
+	for ( i = 0; i < functions.Num(); i++ ) {
+		const function_t &func = functions[ i ];
+
+		file->WriteString( func.Name() );
+		file->WriteString( ( func.eventdef != NULL ) ? func.eventdef->GetName() : "" );
+		file->WriteBig( ref = DefIndex( func.def ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( ref = TypeIndex( func.type, typeIndexHash ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( func.firstStatement );
+		file->WriteBig( func.numStatements );
+		file->WriteBig( func.parmTotal );
+		file->WriteBig( func.locals );
+		file->WriteBig( func.filenum );
+		file->WriteBig( func.parmSize.Num() );
+		for ( j = 0; j < func.parmSize.Num(); j++ ) {
+			file->WriteBig( func.parmSize[ j ] );
+		}
+	}
+
+	for ( i = 0; i < statements.Num(); i++ ) {
+		const statement_t &statement = statements[ i ];
+
+		file->WriteBig( statement.op );
+		file->WriteBig( ref = DefIndex( statement.a ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( ref = DefIndex( statement.b ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( ref = DefIndex( statement.c ) );
+		valid &= ( ref != SCRIPT_REF_INVALID );
+		file->WriteBig( statement.linenumber );
+		file->WriteBig( statement.file );
+	}
+
+	file->WriteBig( DefIndex( returnDef ) );
+	file->WriteBig( DefIndex( returnStringDef ) );
+	file->WriteBig( DefIndex( sysDef ) );
+
+	file->WriteBig( B_SCRIPT_MAGIC );
+
+	return valid;
+}
+
 /*
 ================
 idProgram::Startup
@@ -1949,6 +2578,29 @@ void idProgram::Startup( const char *defaultScript ) {
 	// make sure all data is freed up
 	idThread::Restart();
 
+	const bool useBinary = binaryLoadScripts.GetBool() && defaultScript != NULL && *defaultScript != '\0';
+
+	idStr generatedFileName;
+	unsigned int sourceChecksum = 0;
+	if ( useBinary ) {
+		generatedFileName = "generated/";
+		generatedFileName.AppendPath( defaultScript );
+		generatedFileName.SetFileExtension( SCRIPT_BINARYFILE_EXT );
+
+		// source timestamps aren't reliable once everything is in resource files
+		sourceChecksum = ScriptSourceChecksum( !fileSystem->InProductionMode() );
+
+		idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+		if ( LoadBinary( file, sourceChecksum ) ) {
+			gameLocal.Printf( "Loaded '%s'\n", generatedFileName.c_str() );
+			FinishCompilation();
+			if ( g_disasm.GetBool() ) {
+				Disassemble();
+			}
+			return;
+		}
+	}
+
 	// get ready for loading scripts
 	BeginCompilation();
 
@@ -1958,6 +2610,16 @@ void idProgram::Startup( const char *defaultScript ) {
 	}
 
 	FinishCompilation();
+
+	if ( useBinary ) {
+		idFile_Memory memFile;
+		if ( WriteBinary( &memFile, sourceChecksum ) ) {
+			gameLocal.Printf( "Writing %s\n", generatedFileName.c_str() );
+			fileSystem->WriteFile( generatedFileName, memFile.GetDataPtr(), memFile.Length(), "fs_basepath" );
+		} else {
+			gameLocal.Warning( "Couldn't write '%s', the program refers to data outside of it", generatedFileName.c_str() );
+		}
+	}
 }
 
 /*
@@ -2122,6 +2784,7 @@ void idProgram::Restart() {
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	loweredStatements.SetNum( top_statements );
 	fileList.SetNum( top_files );
 	filename.Clear();
 	
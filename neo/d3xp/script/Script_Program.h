@@ -91,6 +91,8 @@ Contains type information for variables and functions.
 ***********************************************************************/
 
 class idTypeDef {
+	friend class idProgram;
+
 private:
 	etype_t						type;
 	idStr 						name;
@@ -422,6 +424,20 @@ typedef struct statement_s {
 	unsigned short	file;
 } statement_t;
 
+enum {
+	OPERAND_A,
+	OPERAND_B,
+	OPERAND_C
+};
+
+// statement with its operands resolved to the values the interpreter uses,
+// so that the inner loop doesn't have to chase the idVarDef pointers
+typedef struct loweredStatement_s {
+	varEval_t		operands[ 3 ];
+	unsigned short	op;
+	unsigned short	stackBits;		// bit set for each operand that is an offset into the local stack
+} loweredStatement_t;
+
 /***********************************************************************
 
 idProgram
@@ -444,6 +460,7 @@ private:
 	idStaticList<byte,MAX_GLOBALS>				variableDefaults;
 	idStaticList<function_t,MAX_FUNCS>			functions;
 	idStaticList<statement_t,MAX_STATEMENTS>	statements;
+	idStaticList<loweredStatement_t,MAX_STATEMENTS>	loweredStatements;
 	idList<idTypeDef *, TAG_SCRIPT>				types;
 	idHashIndex									typesHash;
 	idList<idVarDefName *, TAG_SCRIPT>			varDefNames;
@@ -459,6 +476,16 @@ private:
 	int											top_files;
 
 	void										CompileStats();
+	void										LowerStatements();
+
+	// generated binary of the default script
+	int											TypeIndex( const idTypeDef *type, const idHashIndex &typeIndexHash ) const;
+	bool										ReadTypeRef( idFile *file, idTypeDef *&type ) const;
+	int											DefIndex( const idVarDef *def ) const;
+	bool										ReadDefRef( idFile *file, idVarDef *&def ) const;
+	bool										LoadBinary( idFile *file, unsigned int sourceChecksum );
+	bool										ReadBinaryProgram( idFile *file );
+	bool										WriteBinary( idFile *file, unsigned int sourceChecksum ) const;
 	byte										*ReserveMem( int size );
 	idVarDef									*AllocVarDef( idTypeDef *type, const char *name, idVarDef *scope );
 
@@ -513,6 +540,7 @@ public:
 
 	statement_t									*AllocStatement();
 	statement_t									&GetStatement( int index );
+	const loweredStatement_t					&GetLoweredStatement( int index ) const;
 	int											NumStatements() { return statements.Num(); }
 
 	int 										GetReturnedInteger();
@@ -535,6 +563,15 @@ ID_INLINE statement_t &idProgram::GetStatement( int index ) {
 	return statements[ index ];
 }
 
+/*
+================
+idProgram::GetLoweredStatement
+================
+*/
+ID_INLINE const loweredStatement_t &idProgram::GetLoweredStatement( int index ) const {
+	return loweredStatements[ index ];
+}
+
 /*
 ================
 idProgram::GetFunction
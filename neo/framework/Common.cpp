@@ -171,6 +171,7 @@ idCommonLocal::idCommonLocal() :
 	syncNextGameFrame = true;
 	mapSpawned = false;
 	aviCaptureMode = false;
+	traceCaptureFrames = 0;
 	timeDemo = TD_NO;
 
 	nextSnapshotSendTime = 0;
@@ -1022,6 +1023,8 @@ void idCommonLocal::Init( int argc, const char * const * argv, const char *cmdli
 		// init the parallel job manager
 		parallelJobManager->Init();
 
+		idFile_SaveGamePipelined::InitParallelJobList();
+
 		// exec the startup scripts
 		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "exec default.cfg\n" );
 
@@ -1309,6 +1312,9 @@ void idCommonLocal::Shutdown() {
 	printf( "UnloadGameDLL();\n" );
 	UnloadGameDLL();
 
+	printf( "idFile_SaveGamePipelined::ShutdownParallelJobList();\n" );
+	idFile_SaveGamePipelined::ShutdownParallelJobList();
+
 	printf( "saveFile.Clear( true );\n" );
 	saveFile.Clear( true );
 	printf( "stringsFile.Clear( true );\n" );
@@ -1534,7 +1540,7 @@ bool idCommonLocal::ProcessEvent( const sysEvent_t *event ) {
 
 			DoomLib::SetPlayer( 0 );
 			
-			extern Globals * g;
+			extern thread_local Globals * g;
 			if ( g != NULL ) {
 				classicEvent.data1 =  DoomLib::RemapControl( event->GetKey() );
 											
@@ -1696,12 +1702,23 @@ CONSOLE_COMMAND( showStringMemory, "shows memory used by strings", NULL ) {
 CONSOLE_COMMAND( showDictMemory, "shows memory used by dictionaries", NULL ) {
 	idDict::ShowMemoryUsage_f( args );
 }
+CONSOLE_COMMAND( memTagStats, "shows live and peak memory per allocation tag, 'classes' also lists heap pages", NULL ) {
+	Mem_ShowTagStats_f( args );
+}
 CONSOLE_COMMAND( listDictKeys, "lists all keys used by dictionaries", NULL ) {
 	idDict::ListKeys_f( args );
 }
 CONSOLE_COMMAND( listDictValues, "lists all values used by dictionaries", NULL ) {
 	idDict::ListValues_f( args );
 }
+CONSOLE_COMMAND( traceCapture, "writes a Chrome trace event file with profile events and jobs of the next frames", NULL ) {
+	if ( args.Argc() < 2 ) {
+		commonLocal.Printf( "usage: traceCapture <frames> [file]\n" );
+		return;
+	}
+	const char * fileName = ( args.Argc() > 2 ) ? args.Argv( 2 ) : va( "traces/trace_%d", idLib::frameNumber );
+	commonLocal.StartTraceCapture( atoi( args.Argv( 1 ) ), fileName );
+}
 CONSOLE_COMMAND( testSIMD, "test SIMD code", NULL ) {
 	idSIMD::Test_f( args );
 }
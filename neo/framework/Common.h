@@ -82,8 +82,17 @@ ID_INLINE void BeginProfileNamedEvent( VERIFY_FORMAT_STRING const char * szName
 
 class idScopedProfileEvent {
 public:
-	idScopedProfileEvent( const char * name ) { BeginProfileNamedEvent( name ); }
-	~idScopedProfileEvent() { EndProfileNamedEvent(); }
+	idScopedProfileEvent( const char * name ) : name( name ), startTime( idTraceCapture::IsCapturing() ? Sys_Microseconds() : 0 ) { BeginProfileNamedEvent( name ); }
+	~idScopedProfileEvent() {
+		EndProfileNamedEvent();
+		if ( startTime != 0 ) {
+			idTraceCapture::AddEvent( name, "profile", startTime, Sys_Microseconds() );
+		}
+	}
+
+private:
+	const char *	name;
+	uint64			startTime;	// only set while a trace is being captured
 };
 
 #define SCOPED_PROFILE_EVENT( x ) idScopedProfileEvent scopedProfileEvent_##__LINE__( x )
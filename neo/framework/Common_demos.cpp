@@ -31,6 +31,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Common_local.h"
 
+idCVar com_benchmarkOutput( "com_benchmarkOutput", "benchmarks/demos", CVAR_SYSTEM, "base name of the .json and .csv files written by benchmarkDemos" );
+
 /*
 ================
 FindUnusedFileName
@@ -241,6 +243,182 @@ void idCommonLocal::TimeRenderDemo( const char *demoName, bool twice, bool quit
 	}
 }
 
+/*
+================
+idCommonLocal::BenchmarkRenderDemos
+
+Plays the demos back to back as fast as possible and writes the times of every
+frame to <com_benchmarkOutput>.csv and percentiles of them to <com_benchmarkOutput>.json.
+The back end, shadow and gpu times reported by a swap are for the frame before it,
+so the last frame of every demo is left out.
+================
+*/
+void idCommonLocal::BenchmarkRenderDemos( const idStrList & demoNames, bool quit ) {
+	enum {
+		BENCHMARK_FRAME,
+		BENCHMARK_DEMO,
+		BENCHMARK_FRONTEND,
+		BENCHMARK_BACKEND,
+		BENCHMARK_SHADOWS,
+		BENCHMARK_GPU,
+		BENCHMARK_JOBS,
+		BENCHMARK_JOB_WAIT,
+		NUM_BENCHMARK_TIMES
+	};
+	static const char * timeNames[NUM_BENCHMARK_TIMES] = { "frame", "demo", "frontend", "backend", "shadows", "gpu", "jobs", "jobWait" };
+	static const int percentiles[] = { 50, 90, 95, 99 };
+
+	idStr outputName = com_benchmarkOutput.GetString();
+	idFile * csvFile = fileSystem->OpenFileWrite( outputName + ".csv" );
+	idFile * jsonFile = fileSystem->OpenFileWrite( outputName + ".json" );
+	if ( csvFile == NULL || jsonFile == NULL ) {
+		common->Printf( "couldn't open %s for writing\n", outputName.c_str() );
+		delete csvFile;
+		delete jsonFile;
+		return;
+	}
+
+	csvFile->Printf( "demo,frame" );
+	for ( int i = 0; i < NUM_BENCHMARK_TIMES; i++ ) {
+		csvFile->Printf( ",%s_ms", timeNames[i] );
+	}
+	csvFile->Printf( "\n" );
+
+	jsonFile->Printf( "{\n\t\"version\": \"%s\",\n\t\"demos\": [", cvarSystem->GetCVarString( "si_version" ) );
+
+	idList< int > times[NUM_BENCHMARK_TIMES];
+	int numBenchmarked = 0;
+
+	for ( int d = 0; d < demoNames.Num(); d++ ) {
+		idStr demoName = demoNames[d];
+		demoName.DefaultFileExtension( ".demo" );
+
+		StartPlayingRenderDemo( demoName );
+		if ( readDemo == NULL ) {
+			continue;
+		}
+
+		for ( int i = 0; i < NUM_BENCHMARK_TIMES; i++ ) {
+			times[i].SetNum( 0 );
+		}
+
+		const uint64 demoStartTime = Sys_Microseconds();
+		bool finished = false;
+		while ( !finished ) {
+			const uint64 frameStartTime = Sys_Microseconds();
+
+			// read the demo up to the next view
+			const int lastDemoFrames = numDemoFrames;
+			while ( numDemoFrames == lastDemoFrames ) {
+				if ( !AdvanceRenderDemo( true ) ) {
+					finished = true;
+					break;
+				}
+			}
+			if ( finished ) {
+				break;
+			}
+			const uint64 demoTime = Sys_Microseconds() - frameStartTime;
+
+			const bool captureToImage = false;
+			UpdateScreen( captureToImage );
+
+			const uint64 frameTime = Sys_Microseconds() - frameStartTime;
+
+			// job lists that were waited on during the frame
+			uint64 jobTime = 0;
+			uint64 jobWaitTime = 0;
+			for ( int i = 0; i < parallelJobManager->GetNumJobLists(); i++ ) {
+				const idParallelJobList * jobList = parallelJobManager->GetJobList( i );
+				if ( jobList->GetSubmitTimeMicroSec() >= frameStartTime ) {
+					jobTime += jobList->GetTotalProcessingTimeMicroSec();
+					jobWaitTime += jobList->GetWaitTimeMicroSec();
+				}
+			}
+
+			const int lastFrame = times[BENCHMARK_FRAME].Num() - 1;
+			if ( lastFrame >= 0 ) {
+				times[BENCHMARK_BACKEND][lastFrame] = (int)time_backend;
+				times[BENCHMARK_SHADOWS][lastFrame] = (int)time_shadows;
+				times[BENCHMARK_GPU][lastFrame] = (int)time_gpu;
+			}
+
+			times[BENCHMARK_FRAME].Append( (int)frameTime );
+			times[BENCHMARK_DEMO].Append( (int)demoTime );
+			times[BENCHMARK_FRONTEND].Append( (int)time_frontend );
+			times[BENCHMARK_BACKEND].Append( 0 );
+			times[BENCHMARK_SHADOWS].Append( 0 );
+			times[BENCHMARK_GPU].Append( 0 );
+			times[BENCHMARK_JOBS].Append( (int)jobTime );
+			times[BENCHMARK_JOB_WAIT].Append( (int)jobWaitTime );
+		}
+		const float demoSeconds = ( Sys_Microseconds() - demoStartTime ) * 0.000001f;
+
+		// a single frame demo is replayed until it is stopped
+		if ( readDemo != NULL ) {
+			StopPlayingRenderDemo();
+		}
+
+		for ( int i = 0; i < NUM_BENCHMARK_TIMES; i++ ) {
+			if ( times[i].Num() > 0 ) {
+				times[i].RemoveIndex( times[i].Num() - 1 );
+			}
+		}
+		const int numFrames = times[BENCHMARK_FRAME].Num();
+
+		idStr jsonName = demoName;
+		jsonName.BackSlashesToSlashes();
+		jsonName.Replace( "\"", "'" );
+
+		for ( int f = 0; f < numFrames; f++ ) {
+			csvFile->Printf( "%s,%d", jsonName.c_str(), f );
+			for ( int i = 0; i < NUM_BENCHMARK_TIMES; i++ ) {
+				csvFile->Printf( ",%.3f", times[i][f] * 0.001f );
+			}
+			csvFile->Printf( "\n" );
+		}
+
+		jsonFile->Printf( "%s\n\t\t{\n", ( numBenchmarked > 0 ) ? "," : "" );
+		jsonFile->Printf( "\t\t\t\"name\": \"%s\",\n", jsonName.c_str() );
+		jsonFile->Printf( "\t\t\t\"frames\": %d,\n", numFrames );
+		jsonFile->Printf( "\t\t\t\"seconds\": %.3f,\n", demoSeconds );
+		jsonFile->Printf( "\t\t\t\"fps\": %.2f,\n", ( demoSeconds > 0.0f ) ? numFrames / demoSeconds : 0.0f );
+		jsonFile->Printf( "\t\t\t\"times\": {" );
+		for ( int i = 0; i < NUM_BENCHMARK_TIMES; i++ ) {
+			idList< int > & sorted = times[i];
+			sorted.SortWithTemplate( idSort_QuickDefault< int >() );
+
+			int64 sum = 0;
+			for ( int f = 0; f < numFrames; f++ ) {
+				sum += sorted[f];
+			}
+
+			jsonFile->Printf( "%s\n\t\t\t\t\"%s\": { \"mean\": %.3f", ( i > 0 ) ? "," : "", timeNames[i], ( numFrames > 0 ) ? sum * 0.001f / numFrames : 0.0f );
+			for ( int p = 0; p < sizeof( percentiles ) / sizeof( percentiles[0] ); p++ ) {
+				// nearest rank
+				const int index = Max( ( percentiles[p] * numFrames + 99 ) / 100 - 1, 0 );
+				jsonFile->Printf( ", \"p%d\": %.3f", percentiles[p], ( numFrames > 0 ) ? sorted[index] * 0.001f : 0.0f );
+			}
+			jsonFile->Printf( ", \"max\": %.3f }", ( numFrames > 0 ) ? sorted[numFrames - 1] * 0.001f : 0.0f );
+		}
+		jsonFile->Printf( "\n\t\t\t}\n\t\t}" );
+
+		common->Printf( "%s: %i frames in %3.1f seconds = %3.1f fps\n", demoName.c_str(), numFrames, demoSeconds, ( demoSeconds > 0.0f ) ? numFrames / demoSeconds : 0.0f );
+		numBenchmarked++;
+	}
+
+	jsonFile->Printf( "\n\t]\n}\n" );
+
+	common->Printf( "wrote %s.json and %s.csv for %i demos\n", outputName.c_str(), outputName.c_str(), numBenchmarked );
+
+	delete csvFile;
+	delete jsonFile;
+
+	if ( quit ) {
+		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+	}
+}
+
 
 /*
 ================
@@ -387,9 +565,11 @@ void idCommonLocal::CompressDemoFile( const char *scheme, const char *demoName )
 /*
 ===============
 idCommonLocal::AdvanceRenderDemo
+
+Returns false when the end of the demo is reached.
 ===============
 */
-void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly ) {
+bool idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly ) {
 	int	ds = DS_FINISHED;
 	readDemo->ReadInt( ds );
 
@@ -401,7 +581,7 @@ void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly ) {
 			Stop();
 			StartMenu();
 		}
-		return;
+		return false;
 	case DS_RENDER:
 		if ( renderWorld->ProcessDemoCommand( readDemo, &currentDemoRenderView, &demoTimeOffset ) ) {
 			// a view is ready to render
@@ -414,6 +594,7 @@ void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly ) {
 	default:
 		common->Error( "Bad render demo token" );
 	}
+	return true;
 }
 
 /*
@@ -459,6 +640,105 @@ CONSOLE_COMMAND( compressDemo, "compresses a demo file", idCmdSystem::ArgComplet
 	}
 }
 
+/*
+================
+Common_BenchmarkDemoCompression_f
+
+Runs a demo through every com_compressDemos scheme with the int sized reads and
+writes that make up most of the demo traffic.
+================
+*/
+CONSOLE_COMMAND( benchmarkDemoCompression, "compares the demo compression schemes on a demo file", idCmdSystem::ArgCompletion_DemoName ) {
+	static const struct {
+		const char *	name;
+		idCompressor *	(*alloc)();
+	} schemes[] = {
+		{ "None",		idCompressor::AllocNoCompression },
+		{ "LZW",		idCompressor::AllocLZW },
+		{ "LZSS",		idCompressor::AllocLZSS },
+		{ "Huffman",	idCompressor::AllocHuffman },
+		{ "LZ4",		idCompressor::AllocLZ4 },
+	};
+
+	if ( args.Argc() != 2 ) {
+		common->Printf( "use: benchmarkDemoCompression <file>\n" );
+		return;
+	}
+
+	idStr fullDemoName = "demos/";
+	fullDemoName += args.Argv(1);
+	fullDemoName.DefaultFileExtension( ".demo" );
+
+	idDemoFile demoread;
+	if ( !demoread.OpenForReading( fullDemoName ) ) {
+		common->Printf( "Could not open %s for reading\n", fullDemoName.c_str() );
+		return;
+	}
+
+	static const int bufferSize = 65536;
+	byte buffer[bufferSize];
+	int bytesRead;
+	idList< byte > demoData;
+	while ( 0 != ( bytesRead = demoread.Read( buffer, bufferSize ) ) ) {
+		const int offset = demoData.Num();
+		// the demo may be compressed so the final size is not known up front, grow geometrically
+		if ( offset + bytesRead > demoData.NumAllocated() ) {
+			demoData.Resize( Max( offset + bytesRead, demoData.NumAllocated() * 2 ) );
+		}
+		demoData.SetNum( offset + bytesRead );
+		memcpy( demoData.Ptr() + offset, buffer, bytesRead );
+	}
+	demoread.Close();
+
+	const int length = demoData.Num();
+	if ( length == 0 ) {
+		common->Printf( "%s is empty\n", fullDemoName.c_str() );
+		return;
+	}
+	common->Printf( "%s: %i bytes uncompressed\n", fullDemoName.c_str(), length );
+
+	idList< byte > readData;
+	readData.SetNum( length );
+
+	for ( int i = 0; i < sizeof( schemes ) / sizeof( schemes[0] ); i++ ) {
+		idFile_Memory * compressedFile = new (TAG_IDFILE) idFile_Memory( "benchmarkDemoCompression" );
+
+		idCompressor * compressor = schemes[i].alloc();
+		compressor->Init( compressedFile, true, 8 );
+
+		const uint64 startCompress = Sys_Microseconds();
+		for ( int j = 0; j < length; j += sizeof( int ) ) {
+			compressor->Write( demoData.Ptr() + j, Min( length - j, (int)sizeof( int ) ) );
+		}
+		compressor->FinishCompress();
+		const uint64 compressMicroseconds = Max( Sys_Microseconds() - startCompress, (uint64)1 );
+		delete compressor;
+
+		const int compressedLength = compressedFile->Length();
+		idFile_Memory * readFile = new (TAG_IDFILE) idFile_Memory( "benchmarkDemoCompression", compressedFile->GetDataPtr(), compressedLength );
+
+		compressor = schemes[i].alloc();
+		compressor->Init( readFile, false, 8 );
+
+		const uint64 startDecompress = Sys_Microseconds();
+		int decompressedLength = 0;
+		for ( int j = 0; j < length; j += sizeof( int ) ) {
+			decompressedLength += compressor->Read( readData.Ptr() + j, Min( length - j, (int)sizeof( int ) ) );
+		}
+		const uint64 decompressMicroseconds = Max( Sys_Microseconds() - startDecompress, (uint64)1 );
+		delete compressor;
+
+		const bool matches = ( decompressedLength == length && memcmp( readData.Ptr(), demoData.Ptr(), length ) == 0 );
+
+		common->Printf( "%i: %-8s %10i bytes %5.1f%%  compress %7.1f MB/s  decompress %7.1f MB/s%s\n",
+			i, schemes[i].name, compressedLength, compressedLength * 100.0f / length,
+			(float)length / compressMicroseconds, (float)length / decompressMicroseconds, matches ? "" : "  MISMATCH" );
+
+		delete readFile;
+		delete compressedFile;
+	}
+}
+
 /*
 ================
 Common_StopRecordingDemo_f
@@ -499,6 +779,36 @@ CONSOLE_COMMAND( timeDemoQuit, "times a demo and quits", idCmdSystem::ArgComplet
 	commonLocal.TimeRenderDemo( va( "demos/%s", args.Argv(1) ), true );
 }
 
+/*
+================
+Common_BenchmarkDemos_f
+================
+*/
+static void Common_BenchmarkDemos( const idCmdArgs & args, bool quit ) {
+	if ( args.Argc() < 2 ) {
+		common->Printf( "use: %s <demo> [demo ...]\nwithout a GPU, run with +set r_skipBackEnd 1 on a software OpenGL driver\n", args.Argv(0) );
+		return;
+	}
+	idStrList demoNames;
+	for ( int i = 1; i < args.Argc(); i++ ) {
+		demoNames.Append( va( "demos/%s", args.Argv(i) ) );
+	}
+	commonLocal.BenchmarkRenderDemos( demoNames, quit );
+}
+
+CONSOLE_COMMAND( benchmarkDemos, "times every frame of a list of demos and writes the results to com_benchmarkOutput", idCmdSystem::ArgCompletion_DemoName ) {
+	Common_BenchmarkDemos( args, false );
+}
+
+/*
+================
+Common_BenchmarkDemosQuit_f
+================
+*/
+CONSOLE_COMMAND( benchmarkDemosQuit, "benchmarks a list of demos and quits", idCmdSystem::ArgCompletion_DemoName ) {
+	Common_BenchmarkDemos( args, true );
+}
+
 /*
 ================
 Common_AVIDemo_f
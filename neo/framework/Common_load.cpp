@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Common_local.h"
 #include "../sys/sys_lobby_backend.h"
+#include "../renderer/Image.h"
 
 
 #define LAUNCH_TITLE_DOOM_EXECUTABLE		"doom1.exe"
@@ -378,6 +379,86 @@ void idCommonLocal::LoadLoadingGui( const char *mapName, bool & hellMap ) {
 	}
 }
 
+/*
+===============
+GetPreloadFileNames
+
+Lists the generated files for the resources in a preload manifest in the order
+the loaders will ask for them, sorted by their offset in the resource files.
+===============
+*/
+static void GetPreloadFileNames( const idPreloadManifest & manifest, idStrList & fileNames ) {
+	// sounds and models are loaded by Preload, collision models and anims while
+	// spawning the map, and images at the end of the level load
+	const int loadOrder[] = { PRELOAD_SAMPLE, PRELOAD_MODEL, PRELOAD_PARTICLE, PRELOAD_COLLISION, PRELOAD_ANIM, PRELOAD_IMAGE };
+
+	idStrList generatedNames;
+	generatedNames.SetNum( manifest.NumResources() );
+
+	for ( int i = 0; i < manifest.NumResources(); i++ ) {
+		const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
+		idStr & filename = generatedNames[ i ];
+		switch ( p.resType ) {
+			case PRELOAD_IMAGE: {
+				idStr imageName = p.resourceName;
+				idImage::GetGeneratedName( imageName, ( textureUsage_t )p.imgData.usage, ( cubeFiles_t )p.imgData.cubeMap );
+				idBinaryImage::GetGeneratedFileName( filename, imageName );
+				break;
+			}
+			case PRELOAD_MODEL: {
+				filename = "generated/rendermodels/";
+				filename += p.resourceName;
+				idStrStatic< 16 > ext;
+				filename.ExtractFileExtension( ext );
+				filename.SetFileExtension( va( "b%s", ext.c_str() ) );
+				break;
+			}
+			case PRELOAD_SAMPLE:
+				// voice overs are language specific and not preloaded by the sound system
+				if ( p.resourceName.Find( "/vo/", false ) < 0 ) {
+					filename = "generated/";
+					filename += p.resourceName;
+					filename.SetFileExtension( "idwav" );
+				}
+				break;
+			case PRELOAD_ANIM:
+				filename = "generated/anim/";
+				filename.AppendPath( p.resourceName );
+				filename.SetFileExtension( ".bMD5anim" );
+				break;
+			case PRELOAD_COLLISION:
+				filename = "generated/collision/";
+				filename.AppendPath( p.resourceName );
+				filename.SetFileExtension( "bcmodel" );
+				break;
+			case PRELOAD_PARTICLE:
+				filename = "generated/particles/";
+				filename += p.resourceName;
+				filename += ".bprt";
+				break;
+		}
+	}
+
+	fileNames.Clear();
+	fileNames.Resize( manifest.NumResources() );
+	for ( int order = 0; order < ( int )( sizeof( loadOrder ) / sizeof( loadOrder[0] ) ); order++ ) {
+		idList< preloadSort_t > preloadSort;
+		for ( int i = 0; i < manifest.NumResources(); i++ ) {
+			idResourceCacheEntry rc;
+			if ( manifest.GetPreloadByIndex( i ).resType == loadOrder[ order ] && !generatedNames[ i ].IsEmpty() && fileSystem->GetResourceCacheEntry( generatedNames[ i ], rc ) ) {
+				preloadSort_t ps = {};
+				ps.idx = i;
+				ps.ofs = rc.offset;
+				preloadSort.Append( ps );
+			}
+		}
+		preloadSort.SortWithTemplate( idSort_Preload() );
+		for ( int i = 0; i < preloadSort.Num(); i++ ) {
+			fileNames.Append( generatedNames[ preloadSort[ i ].idx ] );
+		}
+	}
+}
+
 /*
 ===============
 idCommonLocal::ExecuteMapChange
@@ -491,6 +572,12 @@ void idCommonLocal::ExecuteMapChange() {
 		manifestName += ".preload";
 		idPreloadManifest manifest;
 		manifest.LoadManifest( manifestName );
+
+		// stream the resources in the background while they are loaded, until EndLevelLoad
+		idStrList preloadFiles;
+		GetPreloadFileNames( manifest, preloadFiles );
+		fileSystem->StartPreload( preloadFiles );
+
 		renderSystem->Preload( manifest, currentMapName );
 		soundSystem->Preload( manifest );
 		game->Preload( manifest );
@@ -577,6 +664,7 @@ void idCommonLocal::ExecuteMapChange() {
 	soundSystem->EndLevelLoad();
 	declManager->EndLevelLoad();
 	uiManager->EndLevelLoad( currentMapName );
+	fileSystem->StopPreload();
 	fileSystem->EndLevelLoad();
 
 	if ( !mapSpawnData.savegameFile && !IsMultiplayer() ) {
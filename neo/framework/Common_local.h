@@ -123,6 +123,9 @@ public:
 	virtual void				Quit();
 	virtual bool				IsInitialized() const;
 	virtual void				Frame();
+
+	void						StartTraceCapture( int numFrames, const char * fileName );
+	void						UpdateTraceCapture();
 	virtual void				UpdateScreen( bool captureToImage );
 	virtual void				UpdateLevelLoadPacifier();
 	virtual void				StartupVariable( const char * match );
@@ -233,6 +236,7 @@ public:	// These are public because they are called directly by static functions
 	void	StopPlayingRenderDemo();
 	void	CompressDemoFile( const char *scheme, const char *name );
 	void	TimeRenderDemo( const char *name, bool twice = false, bool quit = false );
+	void	BenchmarkRenderDemos( const idStrList & demoNames, bool quit = false );
 	void	AVIRenderDemo( const char *name );
 	void	AVIGame( const char *name );
 
@@ -364,6 +368,9 @@ private:
 	idStr				aviDemoShortName;	// 
 	int					aviDemoFrameCount;
 
+	int					traceCaptureFrames;	// frames left before the trace capture is written
+	idStr				traceCaptureFileName;
+
 	enum timeDemo_t {
 		TD_NO,
 		TD_YES,
@@ -451,7 +458,7 @@ private:
 	void	BeginAVICapture( const char *name );
 	void	EndAVICapture();
 
-	void	AdvanceRenderDemo( bool singleFrameOnly );
+	bool	AdvanceRenderDemo( bool singleFrameOnly );
 
 	void	ProcessGameReturn( const gameReturn_t & ret );
 
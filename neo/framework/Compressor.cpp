@@ -2485,6 +2485,413 @@ void idCompressor_LZW::DecompressBlock() {
 	blockSize = Min( writeByte, LZW_BLOCK_SIZE );
 }
 
+/*
+=================================================================================
+
+	idCompressor_LZ4
+
+	Fast LZ77 compression in the LZ4 block format.
+
+	The data is buffered and compressed in independent blocks of up to
+	LZ4_BLOCK_SIZE bytes so the compressor and decompressor work on whole
+	blocks instead of single bytes.  Every block is stored as the uncompressed
+	length, the compressed length and the compressed data.  A block that does
+	not get smaller is stored as is with a compressed length equal to the
+	uncompressed length.
+
+	A sequence starts with a token byte, the high four bits hold the number of
+	literals and the low four bits hold the match length minus LZ4_MIN_MATCH.
+	A value of 15 is continued with extra bytes that are added until a byte
+	that is not 255.  The literals follow, then the match offset as two bytes
+	in little endian order.  The last sequence of a block only has literals.
+
+=================================================================================
+*/
+
+class idCompressor_LZ4 : public idCompressor_None {
+public:
+					idCompressor_LZ4() {}
+
+	void			Init( idFile *f, bool compress, int wordLength );
+	void			FinishCompress();
+	float			GetCompressionRatio() const;
+
+	int				Write( const void *inData, int inLength );
+	int				Read( void *outData, int outLength );
+
+protected:
+	static const int LZ4_BLOCK_SIZE = 65536;
+	static const int LZ4_MAX_COMPRESSED_SIZE = LZ4_BLOCK_SIZE + LZ4_BLOCK_SIZE / 255 + 16;
+	static const int LZ4_HASH_BITS = 14;
+	static const int LZ4_HASH_SIZE = 1 << LZ4_HASH_BITS;
+	static const int LZ4_MIN_MATCH = 4;
+	static const int LZ4_LAST_LITERALS = 5;		// the last bytes of a block are always literals
+	static const int LZ4_MATCH_FIND_LIMIT = 12;	// no match starts this close to the end of a block
+
+	// Block data
+	byte			block[LZ4_BLOCK_SIZE];
+	int				blockSize;
+	int				blockIndex;
+
+	byte			compressed[LZ4_MAX_COMPRESSED_SIZE];
+	unsigned short	hashTable[LZ4_HASH_SIZE];
+
+	int				uncompressedTotalBytes;
+	int				compressedTotalBytes;
+
+protected:
+	void			CompressBlock();
+	void			DecompressBlock();
+
+	int				Compress( const byte *src, int srcLength, byte *dest );
+	static int		Decompress( const byte *src, int srcLength, byte *dest, int destLength );
+};
+
+/*
+================
+LZ4_Read32
+================
+*/
+static ID_INLINE unsigned int LZ4_Read32( const byte *p ) {
+	unsigned int value;
+	memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+/*
+================
+LZ4_WriteLength
+================
+*/
+static ID_INLINE byte *LZ4_WriteLength( byte *op, int length ) {
+	for ( ; length >= 255; length -= 255 ) {
+		*op++ = 255;
+	}
+	*op++ = (byte) length;
+	return op;
+}
+
+/*
+================
+LZ4_ReadLength
+
+Returns false if the length runs past the end of the input.
+================
+*/
+static ID_INLINE bool LZ4_ReadLength( const byte *&ip, const byte *ipEnd, int &length ) {
+	int s;
+	do {
+		if ( ip >= ipEnd ) {
+			return false;
+		}
+		s = *ip++;
+		length += s;
+	} while ( s == 255 );
+	return true;
+}
+
+/*
+================
+idCompressor_LZ4::Init
+================
+*/
+void idCompressor_LZ4::Init( idFile *f, bool compress, int wordLength ) {
+	idCompressor_None::Init( f, compress, wordLength );
+
+	blockSize = 0;
+	blockIndex = 0;
+
+	uncompressedTotalBytes = 0;
+	compressedTotalBytes = 0;
+}
+
+/*
+================
+idCompressor_LZ4::Compress
+
+Greedy parse with a hash table of the last position of every four byte sequence.
+================
+*/
+int idCompressor_LZ4::Compress( const byte *src, int srcLength, byte *dest ) {
+	const byte *ip = src;
+	const byte *anchor = src;
+	const byte *end = src + srcLength;
+	const byte *matchLimit = end - LZ4_LAST_LITERALS;
+	const byte *findLimit = end - LZ4_MATCH_FIND_LIMIT;
+	byte *op = dest;
+
+	memset( hashTable, 0, sizeof( hashTable ) );
+
+	if ( srcLength >= LZ4_MATCH_FIND_LIMIT ) {
+		int misses = 0;
+
+		for ( ip++; ip < findLimit; ) {
+			const unsigned int sequence = LZ4_Read32( ip );
+			const int hash = ( sequence * 2654435761U ) >> ( 32 - LZ4_HASH_BITS );
+			const byte *ref = src + hashTable[hash];
+			hashTable[hash] = (unsigned short)( ip - src );
+
+			if ( ref >= ip || LZ4_Read32( ref ) != sequence ) {
+				// skip faster through data that doesn't compress
+				ip += 1 + ( misses++ >> 6 );
+				continue;
+			}
+			misses = 0;
+
+			// extend the match backwards into the pending literals
+			while ( ip > anchor && ref > src && ip[-1] == ref[-1] ) {
+				ip--;
+				ref--;
+			}
+
+			const byte *matchEnd = ip + LZ4_MIN_MATCH;
+			for ( const byte *r = ref + LZ4_MIN_MATCH; matchEnd < matchLimit && *matchEnd == *r; r++ ) {
+				matchEnd++;
+			}
+
+			const int literalLength = ip - anchor;
+			const int matchLength = matchEnd - ip - LZ4_MIN_MATCH;
+			const int offset = ip - ref;
+
+			byte *token = op++;
+			*token = (byte)( ( Min( literalLength, 15 ) << 4 ) | Min( matchLength, 15 ) );
+			if ( literalLength >= 15 ) {
+				op = LZ4_WriteLength( op, literalLength - 15 );
+			}
+			memcpy( op, anchor, literalLength );
+			op += literalLength;
+
+			*op++ = (byte)( offset & 0xFF );
+			*op++ = (byte)( offset >> 8 );
+			if ( matchLength >= 15 ) {
+				op = LZ4_WriteLength( op, matchLength - 15 );
+			}
+
+			ip = anchor = matchEnd;
+		}
+	}
+
+	// the last literals
+	const int literalLength = end - anchor;
+	*op++ = (byte)( Min( literalLength, 15 ) << 4 );
+	if ( literalLength >= 15 ) {
+		op = LZ4_WriteLength( op, literalLength - 15 );
+	}
+	memcpy( op, anchor, literalLength );
+	op += literalLength;
+
+	assert( op - dest <= LZ4_MAX_COMPRESSED_SIZE );
+	return op - dest;
+}
+
+/*
+================
+idCompressor_LZ4::Decompress
+
+Returns the number of decompressed bytes or -1 if the data is corrupt.
+================
+*/
+int idCompressor_LZ4::Decompress( const byte *src, int srcLength, byte *dest, int destLength ) {
+	const byte *ip = src;
+	const byte *ipEnd = src + srcLength;
+	byte *op = dest;
+	byte *opEnd = dest + destLength;
+
+	while ( ip < ipEnd ) {
+		const int token = *ip++;
+
+		int length = token >> 4;
+		if ( length == 15 && !LZ4_ReadLength( ip, ipEnd, length ) ) {
+			return -1;
+		}
+		if ( length > ipEnd - ip || length > opEnd - op ) {
+			return -1;
+		}
+		memcpy( op, ip, length );
+		op += length;
+		ip += length;
+
+		// the last sequence has no match
+		if ( ip >= ipEnd ) {
+			break;
+		}
+
+		if ( ipEnd - ip < 2 ) {
+			return -1;
+		}
+		const int offset = ip[0] | ( ip[1] << 8 );
+		ip += 2;
+		if ( offset == 0 || offset > op - dest ) {
+			return -1;
+		}
+
+		length = token & 15;
+		if ( length == 15 && !LZ4_ReadLength( ip, ipEnd, length ) ) {
+			return -1;
+		}
+		length += LZ4_MIN_MATCH;
+		if ( length > opEnd - op ) {
+			return -1;
+		}
+
+		const byte *ref = op - offset;
+		if ( offset >= length ) {
+			memcpy( op, ref, length );
+			op += length;
+		} else {
+			// the match overlaps the data it creates
+			for ( int i = 0; i < length; i++ ) {
+				*op++ = *ref++;
+			}
+		}
+	}
+
+	return op - dest;
+}
+
+/*
+================
+idCompressor_LZ4::CompressBlock
+================
+*/
+void idCompressor_LZ4::CompressBlock() {
+	if ( blockSize == 0 ) {
+		return;
+	}
+
+	int compressedSize = Compress( block, blockSize, compressed );
+
+	file->WriteInt( blockSize );
+	if ( compressedSize >= blockSize ) {
+		// store the block if it doesn't get any smaller
+		compressedSize = blockSize;
+		file->WriteInt( compressedSize );
+		file->Write( block, blockSize );
+	} else {
+		file->WriteInt( compressedSize );
+		file->Write( compressed, compressedSize );
+	}
+
+	uncompressedTotalBytes += blockSize;
+	compressedTotalBytes += compressedSize + 2 * sizeof( int );
+
+	blockSize = 0;
+}
+
+/*
+================
+idCompressor_LZ4::DecompressBlock
+================
+*/
+void idCompressor_LZ4::DecompressBlock() {
+	int uncompressedSize, compressedSize;
+
+	blockSize = 0;
+	blockIndex = 0;
+
+	if ( file->ReadInt( uncompressedSize ) != sizeof( int ) || file->ReadInt( compressedSize ) != sizeof( int ) ) {
+		return;
+	}
+	if ( uncompressedSize <= 0 || uncompressedSize > LZ4_BLOCK_SIZE || compressedSize <= 0 || compressedSize > uncompressedSize ) {
+		common->Warning( "idCompressor_LZ4: bad block in %s", file->GetName() );
+		return;
+	}
+
+	if ( compressedSize == uncompressedSize ) {
+		if ( file->Read( block, uncompressedSize ) != uncompressedSize ) {
+			return;
+		}
+	} else {
+		if ( file->Read( compressed, compressedSize ) != compressedSize ) {
+			return;
+		}
+		if ( Decompress( compressed, compressedSize, block, uncompressedSize ) != uncompressedSize ) {
+			common->Warning( "idCompressor_LZ4: corrupt block in %s", file->GetName() );
+			return;
+		}
+	}
+
+	uncompressedTotalBytes += uncompressedSize;
+	compressedTotalBytes += compressedSize + 2 * sizeof( int );
+
+	blockSize = uncompressedSize;
+}
+
+/*
+================
+idCompressor_LZ4::FinishCompress
+================
+*/
+void idCompressor_LZ4::FinishCompress() {
+	if ( compress == false ) {
+		return;
+	}
+	CompressBlock();
+}
+
+/*
+================
+idCompressor_LZ4::GetCompressionRatio
+================
+*/
+float idCompressor_LZ4::GetCompressionRatio() const {
+	if ( uncompressedTotalBytes == 0 ) {
+		return 0.0f;
+	}
+	return ( uncompressedTotalBytes - compressedTotalBytes ) * 100.0f / uncompressedTotalBytes;
+}
+
+/*
+================
+idCompressor_LZ4::Write
+================
+*/
+int idCompressor_LZ4::Write( const void *inData, int inLength ) {
+	int i, n;
+
+	if ( compress == false || inLength <= 0 ) {
+		return 0;
+	}
+
+	for ( i = 0; i < inLength; i += n ) {
+		n = Min( inLength - i, LZ4_BLOCK_SIZE - blockSize );
+		memcpy( block + blockSize, ((const byte *)inData) + i, n );
+		blockSize += n;
+		if ( blockSize == LZ4_BLOCK_SIZE ) {
+			CompressBlock();
+		}
+	}
+
+	return inLength;
+}
+
+/*
+================
+idCompressor_LZ4::Read
+================
+*/
+int idCompressor_LZ4::Read( void *outData, int outLength ) {
+	int i, n;
+
+	if ( compress == true || outLength <= 0 ) {
+		return 0;
+	}
+
+	for ( i = 0; i < outLength; i += n ) {
+		if ( blockIndex == blockSize ) {
+			DecompressBlock();
+			if ( blockSize == 0 ) {
+				return i;
+			}
+		}
+		n = Min( outLength - i, blockSize - blockIndex );
+		memcpy( ((byte *)outData) + i, block + blockIndex, n );
+		blockIndex += n;
+	}
+
+	return outLength;
+}
+
 /*
 =================================================================================
 
@@ -2573,3 +2980,12 @@ idCompressor::AllocLZW
 idCompressor * idCompressor::AllocLZW() {
 	return new (TAG_IDFILE) idCompressor_LZW();
 }
+
+/*
+================
+idCompressor::AllocLZ4
+================
+*/
+idCompressor * idCompressor::AllocLZ4() {
+	return new (TAG_IDFILE) idCompressor_LZ4();
+}
@@ -51,6 +51,7 @@ public:
 	static idCompressor *	AllocLZSS();
 	static idCompressor *	AllocLZSS_WordAligned();
 	static idCompressor *	AllocLZW();
+	static idCompressor *	AllocLZ4();
 
 							// initialization
 	virtual void			Init( idFile *f, bool compress, int wordLength ) = 0;
@@ -1616,6 +1616,7 @@ idFile_InnerResource::idFile_InnerResource( const char *_name, idFile *rezFile,
 	resourceFile = rezFile;
 	internalFilePos = 0;
 	resourceBuffer = NULL;
+	mappedData = NULL;
 }
 
 /*
@@ -1648,7 +1649,10 @@ int idFile_InnerResource::Read( void *buffer, int len ) {
 	int read = 0; //fileSystem->ReadFromBGL( resourceFile, (byte*)buffer, offset + internalFilePos, len );
 
 	if ( read != len ) {
-		if ( resourceBuffer != NULL ) {
+		if ( mappedData != NULL ) {
+			memcpy( buffer, &mappedData[ internalFilePos ], len );
+			read = len;
+		} else if ( resourceBuffer != NULL ) {
 			memcpy( buffer, &resourceBuffer[ internalFilePos ], len );
 			read = len;
 		} else {
@@ -328,6 +328,9 @@ public:
 		resourceBuffer = buf;
 		internalFilePos = 0;
 	}
+	// points into the memory mapped resource file, NULL if it isn't mapped
+	const byte *			GetDataPtr() const { return mappedData; }
+	void					SetMappedData( const byte * data ) { mappedData = data; }
 
 private:
 	idStr				name;				// name of the file in the pak
@@ -336,6 +339,7 @@ private:
 	idFile *			resourceFile;		// actual file
 	int					internalFilePos;	// seek offset
 	byte *				resourceBuffer;		// if using the temp save memory
+	const byte *		mappedData;			// if the resource file is memory mapped
 };
 #endif
 /*
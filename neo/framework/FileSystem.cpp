@@ -124,6 +124,41 @@ struct searchpath_t {
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_RETURN_FILE_MEM	( 1 << 1 )
 
+// the preload thread reads in chunks so other reads from the resource files aren't held up
+#define PRELOAD_READ_CHUNK_SIZE	( 256 * 1024 )
+
+enum resourcePreloadState_t {
+	PRELOAD_PENDING,		// waiting for the preload thread
+	PRELOAD_READING,		// being read by the preload thread
+	PRELOAD_READY,			// in the preload cache
+	PRELOAD_USED,			// handed to a loader
+	PRELOAD_SKIPPED			// opened before the preload thread got to it, or couldn't be read
+};
+
+struct resourcePreload_t {
+	int						containerIndex;
+	int						offset;
+	int						length;
+	byte *					data;
+	resourcePreloadState_t	state;
+};
+
+class idFileSystemLocal;
+
+/*
+================================================
+idResourcePreloadThread
+
+Streams the resources listed by StartPreload into memory ahead of the loaders.
+================================================
+*/
+class idResourcePreloadThread : public idSysThread {
+public:
+	idFileSystemLocal *		fileSystem;
+
+	virtual int				Run();
+};
+
 class idFileSystemLocal : public idFileSystem {
 public:
 							idFileSystemLocal();
@@ -139,6 +174,7 @@ public:
 	virtual const char *	RelativePathToOSPath( const char *relativePath, const char *basePath );
 	virtual const char *	BuildOSPath( const char *base, const char *game, const char *relativePath );
 	virtual const char *	BuildOSPath( const char *base, const char *relativePath );
+	void					BuildOSPath( const char *base, const char *game, const char *relativePath, idStr & osPath );
 	virtual void			CreateOSPath( const char *OSPath );
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp );
 	virtual void			FreeFile( void *buffer );
@@ -180,11 +216,13 @@ public:
 	virtual void			StartPreload( const idStrList &_preload );
 	virtual void			StopPreload();
 	idFile *				GetResourceFile( const char *fileName, bool memFile );
+	idFile *				GetPreloadedFile( const idResourceCacheEntry & rc );
+	int						FindPreload( const idResourceCacheEntry & rc );
 	bool					GetResourceCacheEntry( const char *fileName, idResourceCacheEntry &rc );
 	virtual int				ReadFromBGL( idFile *_resourceFile, void * _buffer, int _offset, int _len );
 	virtual bool			IsBinaryModel( const idStr & resName ) const;
 	virtual bool			IsSoundSample( const idStr & resName ) const;
-	virtual void			FreeResourceBuffer() { resourceBufferAvailable = resourceBufferSize; }
+	virtual void			FreeResourceBuffer() { idScopedCriticalSection lock( resourceMutex ); resourceBufferAvailable = resourceBufferSize; }
 	virtual void			AddImagePreload( const char *resName, int _filter, int _repeat, int _usage, int _cube ) {
 		preloadList.AddImage( resName, _filter, _repeat, _usage, _cube );
 	}
@@ -219,6 +257,8 @@ public:
 
 	void					BuildOrderedStartupContainer();
 private:
+	friend class idResourcePreloadThread;
+
 	idList<searchpath_t>	searchPaths;
 	int						loadCount;			// total files read
 	int						loadStack;			// total files in memory
@@ -241,6 +281,25 @@ private:
 	byte *	resourceBufferPtr;
 	int		resourceBufferSize;
 	int		resourceBufferAvailable;
+
+	// resource files are shared by every file opened from them and may be read from job threads
+	idSysMutex	resourceMutex;
+
+	// background preloading of resources into a bounded cache
+	idResourcePreloadThread		preloadThread;
+	idList< resourcePreload_t >	preloadEntries;
+	idHashIndex				preloadHash;
+	idSysMutex				preloadMutex;
+	idSysSignal				preloadSpaceAvailable;
+	int						preloadCacheBytes;
+	int						preloadReadBytes;
+	int						preloadStartTime;
+	volatile bool			preloadCancel;
+
+	static idCVar			fs_preload;
+	static idCVar			fs_preloadCacheSize;
+
+	void					PreloadResources();
 	int		numFilesOpenedAsCached;
 
 private:
@@ -285,6 +344,9 @@ idCVar	idFileSystemLocal::fs_buildResources( "fs_buildresources", "0", CVAR_SYST
 idCVar	idFileSystemLocal::fs_game( "fs_game", "", CVAR_SYSTEM | CVAR_INIT | CVAR_SERVERINFO, "mod path" );
 idCVar  idFileSystemLocal::fs_game_base( "fs_game_base", "", CVAR_SYSTEM | CVAR_INIT | CVAR_SERVERINFO, "alternate mod path, searched after the main fs_game path, before the basedir" );
 
+idCVar	idFileSystemLocal::fs_preload( "fs_preload", "1", CVAR_SYSTEM | CVAR_BOOL, "stream the resources in a map's preload manifest on a background thread during level load" );
+idCVar	idFileSystemLocal::fs_preloadCacheSize( "fs_preloadCacheSize", "64", CVAR_SYSTEM | CVAR_INTEGER, "maximum megabytes of preloaded resources held before they are opened", 1, 1024 );
+
 idCVar	fs_steampath( "fs_steampath", "", CVAR_SYSTEM | CVAR_INIT, "" );
 idCVar	fs_basepath( "fs_basepath", "", CVAR_SYSTEM | CVAR_INIT, "" );
 idCVar	fs_savepath( "fs_savepath", "", CVAR_SYSTEM | CVAR_INIT, "" );
@@ -300,26 +362,233 @@ idFileSystemLocal::ReadFromBGL
 ================
 */
 int idFileSystemLocal::ReadFromBGL( idFile *_resourceFile, void * _buffer, int _offset, int _len ) {
+	idScopedCriticalSection lock( resourceMutex );
 	if ( _resourceFile->Tell() != _offset ) {
 		_resourceFile->Seek( _offset, FS_SEEK_SET );
 	}
 	return _resourceFile->Read( _buffer, _len );
 }
 
+/*
+================
+idResourcePreloadThread::Run
+================
+*/
+int idResourcePreloadThread::Run() {
+	fileSystem->PreloadResources();
+	return 0;
+}
+
 /*
 ================
 idFileSystemLocal::StartPreload
+
+Starts reading the given resource files into memory on the preload thread,
+in the order they are listed. Files that aren't in a resource container are
+ignored. Opening a preloaded file takes its buffer without another read.
 ================
 */
 void idFileSystemLocal::StartPreload( const idStrList & _preload ) {
+	StopPreload();
+
+	if ( !fs_preload.GetBool() || resourceFiles.Num() == 0 || _preload.Num() == 0 ) {
+		return;
+	}
+
+	const int cacheSize = fs_preloadCacheSize.GetInteger() * 1024 * 1024;
+
+	preloadEntries.Resize( _preload.Num() );
+	for ( int i = 0; i < _preload.Num(); i++ ) {
+		idResourceCacheEntry rc;
+		if ( !GetResourceCacheEntry( _preload[ i ], rc ) ) {
+			continue;
+		}
+		if ( rc.length <= 0 || rc.length > cacheSize || FindPreload( rc ) >= 0 ) {
+			continue;
+		}
+		// mapped containers are read in place and paged in by the OS
+		if ( resourceFiles[ rc.containerIndex ]->GetMappedData() != NULL ) {
+			continue;
+		}
+		resourcePreload_t & p = preloadEntries.Alloc();
+		p.containerIndex = rc.containerIndex;
+		p.offset = rc.offset;
+		p.length = rc.length;
+		p.data = NULL;
+		p.state = PRELOAD_PENDING;
+		preloadHash.Add( preloadHash.GenerateKey( rc.filename, false ), preloadEntries.Num() - 1 );
+	}
+
+	if ( preloadEntries.Num() == 0 ) {
+		return;
+	}
+
+	preloadCacheBytes = 0;
+	preloadReadBytes = 0;
+	preloadStartTime = Sys_Milliseconds();
+	preloadCancel = false;
+
+	if ( !preloadThread.IsRunning() ) {
+		preloadThread.StartWorkerThread( "ResourcePreload", CORE_ANY, THREAD_LOW );
+	}
+	preloadThread.SignalWork();
 }
 
 /*
 ================
 idFileSystemLocal::StopPreload
+
+Stops the preload thread and frees everything that wasn't opened.
 ================
 */
 void idFileSystemLocal::StopPreload() {
+	if ( preloadEntries.Num() == 0 ) {
+		return;
+	}
+
+	preloadCancel = true;
+	preloadSpaceAvailable.Raise();
+	preloadThread.WaitForThread();
+
+	int numUsed = 0;
+	int unusedBytes = 0;
+	for ( int i = 0; i < preloadEntries.Num(); i++ ) {
+		resourcePreload_t & p = preloadEntries[ i ];
+		if ( p.state == PRELOAD_USED ) {
+			numUsed++;
+		} else if ( p.state == PRELOAD_READY ) {
+			unusedBytes += p.length;
+			Mem_Free( p.data );
+			p.data = NULL;
+		}
+	}
+
+	common->Printf( "%05d of %05d preloaded resources used, %d kb read ahead, %d kb unused in %5.1f seconds\n", numUsed, preloadEntries.Num(), preloadReadBytes >> 10, unusedBytes >> 10, ( Sys_Milliseconds() - preloadStartTime ) * 0.001f );
+
+	preloadEntries.Clear();
+	preloadHash.Clear();
+	preloadCacheBytes = 0;
+	preloadCancel = false;
+}
+
+/*
+================
+idFileSystemLocal::PreloadResources
+
+Runs on the preload thread. Stalls whenever the cache is full until the
+loaders open some of the preloaded files.
+================
+*/
+void idFileSystemLocal::PreloadResources() {
+	const int cacheSize = fs_preloadCacheSize.GetInteger() * 1024 * 1024;
+
+	for ( int i = 0; i < preloadEntries.Num() && !preloadCancel; i++ ) {
+		resourcePreload_t & p = preloadEntries[ i ];
+
+		preloadMutex.Lock();
+		while ( p.state == PRELOAD_PENDING && preloadCacheBytes > 0 && preloadCacheBytes + p.length > cacheSize && !preloadCancel ) {
+			preloadMutex.Unlock();
+			preloadSpaceAvailable.Wait( 100 );
+			preloadMutex.Lock();
+		}
+		if ( p.state != PRELOAD_PENDING || preloadCancel ) {
+			preloadMutex.Unlock();
+			continue;
+		}
+		p.state = PRELOAD_READING;
+		preloadCacheBytes += p.length;
+		preloadMutex.Unlock();
+
+		idFile * resourceFile = resourceFiles[ p.containerIndex ]->resourceFile;
+		byte * data = ( byte * )Mem_Alloc( p.length, TAG_RESOURCE );
+		int read = 0;
+		while ( read < p.length ) {
+			const int len = ReadFromBGL( resourceFile, data + read, p.offset + read, Min( p.length - read, PRELOAD_READ_CHUNK_SIZE ) );
+			if ( len <= 0 ) {
+				break;
+			}
+			read += len;
+		}
+
+		preloadMutex.Lock();
+		if ( read == p.length ) {
+			p.data = data;
+			p.state = PRELOAD_READY;
+			preloadReadBytes += p.length;
+		} else {
+			Mem_Free( data );
+			p.state = PRELOAD_SKIPPED;
+			preloadCacheBytes -= p.length;
+		}
+		preloadMutex.Unlock();
+	}
+}
+
+/*
+================
+idFileSystemLocal::FindPreload
+
+Returns -1 if the resource isn't being preloaded
+================
+*/
+int idFileSystemLocal::FindPreload( const idResourceCacheEntry & rc ) {
+	const int key = preloadHash.GenerateKey( rc.filename, false );
+	for ( int i = preloadHash.First( key ); i != idHashIndex::NULL_INDEX; i = preloadHash.Next( i ) ) {
+		if ( preloadEntries[ i ].containerIndex == rc.containerIndex && preloadEntries[ i ].offset == rc.offset ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idFileSystemLocal::GetPreloadedFile
+
+Returns NULL if the resource wasn't preloaded. If the preload thread
+is reading it at the moment this waits for the read to finish.
+================
+*/
+idFile * idFileSystemLocal::GetPreloadedFile( const idResourceCacheEntry & rc ) {
+	if ( preloadEntries.Num() == 0 ) {
+		return NULL;
+	}
+
+	byte * data = NULL;
+
+	preloadMutex.Lock();
+	const int index = FindPreload( rc );
+	if ( index >= 0 ) {
+		resourcePreload_t & p = preloadEntries[ index ];
+		while ( p.state == PRELOAD_READING ) {
+			preloadMutex.Unlock();
+			Sys_Yield();
+			preloadMutex.Lock();
+		}
+		if ( p.state == PRELOAD_READY ) {
+			data = p.data;
+			p.data = NULL;
+			p.state = PRELOAD_USED;
+			preloadCacheBytes -= p.length;
+			preloadSpaceAvailable.Raise();
+		} else if ( p.state == PRELOAD_PENDING ) {
+			// the loader got here first, so don't read it twice
+			p.state = PRELOAD_SKIPPED;
+		}
+	}
+	preloadMutex.Unlock();
+
+	if ( data == NULL ) {
+		return NULL;
+	}
+
+	if ( fs_debugResources.GetBool() ) {
+		idLib::Printf( "RES: preloaded file %s\n", rc.filename.c_str() );
+	}
+
+	idFile_Memory * file = new (TAG_IDFILE) idFile_Memory( rc.filename, ( const char * )data, rc.length );
+	file->TakeDataOwnership();
+	return file;
 }
 
 /*
@@ -334,6 +603,11 @@ idFileSystemLocal::idFileSystemLocal() {
 	resourceBufferSize = 0;
 	resourceBufferAvailable = 0;
 	numFilesOpenedAsCached = 0;
+	preloadThread.fileSystem = this;
+	preloadCacheBytes = 0;
+	preloadReadBytes = 0;
+	preloadStartTime = 0;
+	preloadCancel = false;
 }
 
 /*
@@ -1430,13 +1704,30 @@ const char *idFileSystemLocal::BuildOSPath( const char *base, const char *game,
 		return relativePath;
 	}
 
+	BuildOSPath( base, game, relativePath, newPath );
+	idStr::Copynz( OSPath, newPath, sizeof( OSPath ) );
+	return OSPath;
+}
+
+/*
+===================
+idFileSystemLocal::BuildOSPath
+
+Doesn't use a static buffer, so this can be called from any thread
+===================
+*/
+void idFileSystemLocal::BuildOSPath( const char *base, const char *game, const char *relativePath, idStr & osPath ) {
+	// handle case of this already being an OS path
+	if ( IsOSPath( relativePath ) ) {
+		osPath = relativePath;
+		return;
+	}
+
 	idStr strBase = base;
 	strBase.StripTrailing( '/' );
 	strBase.StripTrailing( '\\' );
-	sprintf( newPath, "%s/%s/%s", strBase.c_str(), game, relativePath );
-	ReplaceSeparators( newPath );
-	idStr::Copynz( OSPath, newPath, sizeof( OSPath ) );
-	return OSPath;
+	sprintf( osPath, "%s/%s/%s", strBase.c_str(), game, relativePath );
+	ReplaceSeparators( osPath );
 }
 
 /*
@@ -2649,6 +2940,9 @@ Frees all resources and closes all files
 ================
 */
 void idFileSystemLocal::Shutdown( bool reloading ) {
+	StopPreload();
+	preloadThread.StopThread();
+
 	gameFolder.Clear();
 	searchPaths.Clear();
 
@@ -2730,18 +3024,38 @@ idFile * idFileSystemLocal::GetResourceFile( const char *fileName, bool memFile
 		return NULL;
 	}
 
-	static idResourceCacheEntry rc;
+	idResourceCacheEntry rc;
 	if ( GetResourceCacheEntry( fileName, rc ) ) {
+		const byte * mappedData = resourceFiles[ rc.containerIndex ]->GetMappedData();
+		if ( mappedData != NULL ) {
+			if ( fs_debugResources.GetBool() ) {
+				idLib::Printf( "RES: mapping file %s\n", rc.filename.c_str() );
+			}
+			// the data is used in place, memory files become a read only view of the mapping
+			if ( memFile ) {
+				return new (TAG_IDFILE) idFile_Memory( rc.filename, ( const char * )mappedData + rc.offset, rc.length );
+			}
+			idFile_InnerResource *file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
+			file->SetMappedData( mappedData + rc.offset );
+			return file;
+		}
+		idFile * preloadedFile = GetPreloadedFile( rc );
+		if ( preloadedFile != NULL ) {
+			return preloadedFile;
+		}
 		if ( fs_debugResources.GetBool() ) {
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
 		idFile_InnerResource *file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
 		if ( file != NULL && ( memFile || rc.length <= resourceBufferAvailable ) || rc.length < 8 * 1024 * 1024 ) {
 			byte *buf = NULL;
+			resourceMutex.Lock();
 			if ( rc.length < resourceBufferAvailable ) {
 				buf = resourceBufferPtr;
 				resourceBufferAvailable = 0;
-			} else {
+			}
+			resourceMutex.Unlock();
+			if ( buf == NULL ) {
 		if ( fs_debugResources.GetBool() ) {
 				idLib::Printf( "MEM: Allocating %05d bytes for a resource load\n", rc.length );
 }
@@ -2829,7 +3143,8 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 				}
 			}
 
-			idStr netpath = BuildOSPath( searchPaths[sp].path, searchPaths[sp].gamedir, relativePath );
+			idStr netpath;
+			BuildOSPath( searchPaths[sp].path, searchPaths[sp].gamedir, relativePath, netpath );
 			idFileHandle fp = OpenOSFile( netpath, FS_READ );
 			if ( !fp ) {
 				continue;
@@ -2850,7 +3165,7 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 
 				idStr copypath;
 				idStr name;
-				copypath = BuildOSPath( fs_savepath.GetString(), searchPaths[sp].gamedir, relativePath );
+				BuildOSPath( fs_savepath.GetString(), searchPaths[sp].gamedir, relativePath, copypath );
 				netpath.ExtractFileName( name );
 				copypath.StripFilename();
 				copypath += PATHSEPARATOR_STR;
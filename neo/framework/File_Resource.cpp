@@ -29,6 +29,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "../idlib/precompiled.h"
 #pragma hdrstop
 
+idCVar fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_INIT | CVAR_BOOL, "memory map the resource files so their inner files are read without copying or seeking" );
+
 /*
 ================================================================================================
 
@@ -45,6 +47,38 @@ idResourceContainer::ReOpen
 void idResourceContainer::ReOpen() {
 	delete resourceFile;
 	resourceFile = fileSystem->OpenFileRead( fileName );
+	MapFile();
+}
+
+/*
+========================
+idResourceContainer::MapFile
+
+Maps the container if it was opened from disk so the inner files can be
+read without seeking the shared file handle.
+========================
+*/
+void idResourceContainer::MapFile() {
+	Sys_UnmapFile( mappedData, mappedLength );
+	mappedData = NULL;
+	mappedLength = 0;
+
+	if ( !fs_mapResources.GetBool() ) {
+		return;
+	}
+	idFile_Permanent * osFile = dynamic_cast< idFile_Permanent * >( resourceFile );
+	if ( osFile == NULL ) {
+		return;
+	}
+	mappedData = Sys_MapFile( osFile->GetFullPath(), mappedLength );
+	if ( mappedData != NULL && mappedLength != osFile->Length() ) {
+		Sys_UnmapFile( mappedData, mappedLength );
+		mappedData = NULL;
+		mappedLength = 0;
+	}
+	if ( mappedData == NULL ) {
+		idLib::Warning( "Unable to map resource file %s", fileName.c_str() );
+	}
 }
 
 /*
@@ -54,7 +88,8 @@ idResourceContainer::Init
 */ 
 bool idResourceContainer::Init( const char *_fileName, uint8 containerIndex ) {
 
-	if ( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 ) {
+	// the ordered startup resources are read entirely into memory unless they can be mapped
+	if ( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 && !fs_mapResources.GetBool() ) {
 		resourceFile = fileSystem->OpenFileReadMemory( _fileName );
 	} else {
 		resourceFile = fileSystem->OpenFileRead( _fileName );
@@ -72,6 +107,8 @@ bool idResourceContainer::Init( const char *_fileName, uint8 containerIndex ) {
 
 	fileName = _fileName;
 
+	MapFile();
+
 	resourceFile->ReadBig( tableOffset );
 	resourceFile->ReadBig( tableLength );
 	// read this into a memory buffer with a single read
@@ -74,12 +74,15 @@ class idResourceContainer {
 public:
 	idResourceContainer() {
 		resourceFile = NULL;
+		mappedData = NULL;
+		mappedLength = 0;
 		tableOffset = 0;
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
 	}
 	~idResourceContainer() {
+		Sys_UnmapFile( mappedData, mappedLength );
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -93,9 +96,15 @@ public:
 	const char * GetFileName() const { return fileName.c_str(); }
 	void SetContainerIndex( const int & _idx );
 	void ReOpen();
+	// NULL unless the container is memory mapped, the inner files then point straight into the mapping
+	const byte * GetMappedData() const { return mappedData; }
 private:
+	void MapFile();
+
 	idStrStatic< 256 > fileName;
 	idFile *	resourceFile;			// open file handle
+	const byte *	mappedData;			// read only mapping of the whole file
+	int		mappedLength;
 	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
 	// a DVD layer, so it isn't a retail limitation.
 	int		tableOffset;			// table offset
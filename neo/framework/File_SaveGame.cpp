@@ -61,8 +61,15 @@ idCVar sgf_testCorruption( "sgf_testCorruption", "-1", CVAR_INTEGER, "test corru
 
 // this is supposed to get faster going from -15 to -9, but it gets slower as well as worse compression
 idCVar sgf_windowBits( "sgf_windowBits", "-15", CVAR_INTEGER, "zlib window bits" );
+idCVar sgf_parallelBlocks( "sgf_parallelBlocks", "1", CVAR_BOOL, "write save games as independently compressed blocks that are compressed and decompressed in parallel" );
+
+// The first byte of a raw deflate stream never has both block type bits set, which is
+// how files with parallel blocks are told apart from files that are a single zlib stream.
+static const uint32 SGF_PARALLEL_MAGIC = ( 'B' << 24 ) | ( 'L' << 16 ) | ( 'K' << 8 ) | 0x07;
 
 bool idFile_SaveGamePipelined::cancelToTerminate = false;
+idParallelJobList * idFile_SaveGamePipelined::parallelJobList = NULL;
+idSysMutex idFile_SaveGamePipelined::parallelJobListMutex;
 
 class idSGFcompressThread : public idSysThread {
 public:
@@ -93,8 +100,13 @@ idFile_SaveGamePipelined::idFile_SaveGamePipelined
 idFile_SaveGamePipelined::idFile_SaveGamePipelined() :
 		mode( CLOSED ),
 		compressedLength( 0 ),
+		parallelBlocks( false ),
+		formatChecked( false ),
 		uncompressedProducedBytes( 0 ),
 		uncompressedConsumedBytes( 0 ),
+		uncompressedBuffer( uncompressed ),
+		uncompressedBufferSize( UNCOMPRESSED_BUFFER_SIZE ),
+		uncompressedFlushSize( UNCOMPRESSED_BLOCK_SIZE ),
 		compressedProducedBytes( 0 ),
 		compressedConsumedBytes( 0 ),
 		dataZlib( NULL ),
@@ -104,6 +116,9 @@ idFile_SaveGamePipelined::idFile_SaveGamePipelined() :
 		zLibFlushType( Z_NO_FLUSH ),
 		zStreamEndHit( false ),
 		numChecksums( 0 ),
+		parallelBuffer( NULL ),
+		parallelCompressed( NULL ),
+		parallelCompressedSize( 0 ),
 		nativeFile( NULL ),
 		nativeFileEndHit( false ),
 		finished( false ),
@@ -118,6 +133,7 @@ idFile_SaveGamePipelined::idFile_SaveGamePipelined() :
 	memset( &zStream, 0, sizeof( zStream ) );
 	memset( compressed, 0, sizeof( compressed ) );
 	memset( uncompressed, 0, sizeof( uncompressed ) );
+	memset( parallelJobs, 0, sizeof( parallelJobs ) );
 	zStream.zalloc = ZlibAlloc;
 	zStream.zfree = ZlibFree;
 }
@@ -148,6 +164,8 @@ idFile_SaveGamePipelined::~idFile_SaveGamePipelined() {
 		writeThread = NULL;
 	}
 
+	FreeParallelBlocks();
+
 	// close the native file
 /*	if ( nativeFile != NULL ) {
 		delete nativeFile;
@@ -324,22 +342,29 @@ bool idFile_SaveGamePipelined::OpenForWriting( const char * const filename, bool
 		}
 	}
 
-	// raw deflate with no header / checksum
-	// use max memory for fastest compression
-	// optimize for higher speed
-	//mem.PushHeap();
-	int status = deflateInit2( &zStream, Z_BEST_SPEED, Z_DEFLATED, sgf_windowBits.GetInteger(), 9, Z_DEFAULT_STRATEGY );
-	//mem.PopHeap();
-	if ( status != Z_OK ) {
-		idLib::FatalError( "idFile_SaveGamePipelined::OpenForWriting: deflateInit2() error %i", status );
-	}
+	if ( sgf_parallelBlocks.GetBool() ) {
+		// every block gets a zlib stream of its own
+		InitParallelBlocks();
+		const uint32 magic = LittleLong( SGF_PARALLEL_MAGIC );
+		WriteCompressed( &magic, sizeof( magic ) );
+	} else {
+		// raw deflate with no header / checksum
+		// use max memory for fastest compression
+		// optimize for higher speed
+		//mem.PushHeap();
+		int status = deflateInit2( &zStream, Z_BEST_SPEED, Z_DEFLATED, sgf_windowBits.GetInteger(), 9, Z_DEFAULT_STRATEGY );
+		//mem.PopHeap();
+		if ( status != Z_OK ) {
+			idLib::FatalError( "idFile_SaveGamePipelined::OpenForWriting: deflateInit2() error %i", status );
+		}
 
-	// initial buffer setup
-	zStream.avail_out = COMPRESSED_BLOCK_SIZE;
-	zStream.next_out = (Bytef * )compressed;
+		// initial buffer setup
+		zStream.avail_out = COMPRESSED_BLOCK_SIZE;
+		zStream.next_out = (Bytef * )compressed;
 
-	if ( sgf_checksums.GetBool() ) {
-		zStream.avail_out -= sizeof( uint32 );
+		if ( sgf_checksums.GetBool() ) {
+			zStream.avail_out -= sizeof( uint32 );
+		}
 	}
 
 	if ( sgf_threads.GetInteger() >= 1 ) {
@@ -375,22 +400,29 @@ bool idFile_SaveGamePipelined::OpenForWriting( idFile * file )  {
 	numChecksums = 0;
 
 
-	// raw deflate with no header / checksum
-	// use max memory for fastest compression
-	// optimize for higher speed
-	//mem.PushHeap();
-	int status = deflateInit2( &zStream, Z_BEST_SPEED, Z_DEFLATED, sgf_windowBits.GetInteger(), 9, Z_DEFAULT_STRATEGY );
-	//mem.PopHeap();
-	if ( status != Z_OK ) {
-		idLib::FatalError( "idFile_SaveGamePipelined::OpenForWriting: deflateInit2() error %i", status );
-	}
+	if ( sgf_parallelBlocks.GetBool() ) {
+		// every block gets a zlib stream of its own
+		InitParallelBlocks();
+		const uint32 magic = LittleLong( SGF_PARALLEL_MAGIC );
+		WriteCompressed( &magic, sizeof( magic ) );
+	} else {
+		// raw deflate with no header / checksum
+		// use max memory for fastest compression
+		// optimize for higher speed
+		//mem.PushHeap();
+		int status = deflateInit2( &zStream, Z_BEST_SPEED, Z_DEFLATED, sgf_windowBits.GetInteger(), 9, Z_DEFAULT_STRATEGY );
+		//mem.PopHeap();
+		if ( status != Z_OK ) {
+			idLib::FatalError( "idFile_SaveGamePipelined::OpenForWriting: deflateInit2() error %i", status );
+		}
 
-	// initial buffer setup
-	zStream.avail_out = COMPRESSED_BLOCK_SIZE;
-	zStream.next_out = (Bytef * )compressed;
+		// initial buffer setup
+		zStream.avail_out = COMPRESSED_BLOCK_SIZE;
+		zStream.next_out = (Bytef * )compressed;
 
-	if ( sgf_checksums.GetBool() ) {
-		zStream.avail_out -= sizeof( uint32 );
+		if ( sgf_checksums.GetBool() ) {
+			zStream.avail_out -= sizeof( uint32 );
+		}
 	}
 
 	if ( sgf_threads.GetInteger() >= 1 ) {
@@ -527,6 +559,11 @@ Modifies:
 ============================
 */
 void idFile_SaveGamePipelined::CompressBlock() {
+	if ( parallelBlocks ) {
+		CompressParallelBlocks();
+		return;
+	}
+
 	zStream.next_in = (Bytef * )dataZlib;
 	zStream.avail_in = (uInt) bytesZlib;
 
@@ -601,7 +638,7 @@ void idFile_SaveGamePipelined::FlushUncompressedBlock() {
 	}
 
 	// prepare the next block to be consumed by Zlib
-	dataZlib = &uncompressed[ uncompressedConsumedBytes & ( UNCOMPRESSED_BUFFER_SIZE - 1 ) ];
+	dataZlib = &uncompressedBuffer[ uncompressedConsumedBytes & ( uncompressedBufferSize - 1 ) ];
 	bytesZlib = uncompressedProducedBytes - uncompressedConsumedBytes;
 	uncompressedConsumedBytes = uncompressedProducedBytes;
 
@@ -641,12 +678,12 @@ int idFile_SaveGamePipelined::Write( const void * buffer, int length ) {
 	size_t lengthRemaining = length;
 	const byte * buffer_p = (const byte *)buffer;
 	while ( lengthRemaining > 0 ) {
-		const size_t ofsInBuffer = uncompressedProducedBytes & ( UNCOMPRESSED_BUFFER_SIZE - 1 );
-		const size_t ofsInBlock = uncompressedProducedBytes & ( UNCOMPRESSED_BLOCK_SIZE - 1 );
-		const size_t remainingInBlock = UNCOMPRESSED_BLOCK_SIZE - ofsInBlock;
+		const size_t ofsInBuffer = uncompressedProducedBytes & ( uncompressedBufferSize - 1 );
+		const size_t ofsInBlock = uncompressedProducedBytes & ( uncompressedFlushSize - 1 );
+		const size_t remainingInBlock = uncompressedFlushSize - ofsInBlock;
 		const size_t copyToBlock = ( lengthRemaining < remainingInBlock ) ? lengthRemaining : remainingInBlock;
 
-		memcpy( uncompressed + ofsInBuffer, buffer_p, copyToBlock );
+		memcpy( uncompressedBuffer + ofsInBuffer, buffer_p, copyToBlock );
 		uncompressedProducedBytes += copyToBlock;
 
 		buffer_p += copyToBlock;
@@ -680,6 +717,7 @@ bool idFile_SaveGamePipelined::OpenForReading( const char * const filename, bool
 	mode = READ;
 	nativeFile = NULL;
 	numChecksums = 0;
+	formatChecked = false;
 
 	if ( useNativeFile ) {
 		nativeFile = fileSystem->OpenFileRead( filename );
@@ -729,6 +767,7 @@ bool idFile_SaveGamePipelined::OpenForReading( idFile * file ) {
 	mode = READ;
 	nativeFile = file;
 	numChecksums = 0;
+	formatChecked = false;
 
 	// init zlib for raw inflate with a 32k dictionary
 	//mem.PushHeap();
@@ -895,20 +934,47 @@ void idFile_SaveGamePipelined::DecompressBlock() {
 		return;
 	}
 
+	if ( !formatChecked ) {
+		while ( bytesIO == 0 ) {
+			PumpCompressedBlock();
+			if ( bytesIO == 0 && nativeFileEndHit ) {
+				zStreamEndHit = true;
+				return;
+			}
+		}
+		formatChecked = true;
+
+		uint32 magic = 0;
+		if ( bytesIO >= sizeof( magic ) ) {
+			memcpy( &magic, dataIO, sizeof( magic ) );
+		}
+		if ( LittleLong( magic ) == SGF_PARALLEL_MAGIC ) {
+			InitParallelBlocks();
+			dataIO += sizeof( magic );
+			bytesIO -= sizeof( magic );
+		}
+	}
+
+	if ( parallelBlocks ) {
+		DecompressParallelBlocks();
+		return;
+	}
+
 	assert( ( uncompressedProducedBytes & ( UNCOMPRESSED_BLOCK_SIZE - 1 ) ) == 0 );
 	zStream.next_out = (Bytef * )&uncompressed[ uncompressedProducedBytes & ( UNCOMPRESSED_BUFFER_SIZE - 1 ) ];
 	zStream.avail_out = UNCOMPRESSED_BLOCK_SIZE;
 
 	while( zStream.avail_out > 0 ) {
 		if ( zStream.avail_in == 0 ) {
-			do {
+			// the first block may already have been fetched to check the format
+			while ( bytesIO == 0 ) {
 				PumpCompressedBlock();
 				if ( bytesIO == 0 && nativeFileEndHit ) {
 					// don't try to decompress any more if there is no more data
 					zStreamEndHit = true;
 					return;
 				}
-			} while ( bytesIO == 0 );
+			}
 
 			zStream.next_in = (Bytef *) dataIO;
 			zStream.avail_in = (uInt) bytesIO;
@@ -978,7 +1044,7 @@ void idFile_SaveGamePipelined::PumpUncompressedBlock() {
 	}
 
 	// fetch the next block produced by Zlib
-	dataZlib = &uncompressed[ uncompressedConsumedBytes & ( UNCOMPRESSED_BUFFER_SIZE - 1 ) ];
+	dataZlib = &uncompressedBuffer[ uncompressedConsumedBytes & ( uncompressedBufferSize - 1 ) ];
 	bytesZlib = uncompressedProducedBytes - uncompressedConsumedBytes;
 	uncompressedConsumedBytes = uncompressedProducedBytes;
 
@@ -1034,6 +1100,382 @@ int idFile_SaveGamePipelined::Read( void * buffer, int length ) {
 /*
 ===================================================================================
 
+PARALLEL BLOCKS
+
+The file starts with SGF_PARALLEL_MAGIC, followed by blocks of up to
+UNCOMPRESSED_BLOCK_SIZE bytes that are each deflated on their own.  Every block
+has a header with the compressed size, the uncompressed size and a checksum of
+the compressed data.  A header with a compressed size of zero ends the file.
+Only the last block can be smaller than UNCOMPRESSED_BLOCK_SIZE, so a batch of
+PARALLEL_BLOCKS blocks always fills a whole half of the uncompressed buffer.
+
+===================================================================================
+*/
+
+/*
+============================
+SGF_CompressBlockJob
+============================
+*/
+static void SGF_CompressBlockJob( sgfParallelBlock_t * block ) {
+	z_stream stream;
+	memset( &stream, 0, sizeof( stream ) );
+	stream.zalloc = ZlibAlloc;
+	stream.zfree = ZlibFree;
+
+	block->ok = false;
+
+	if ( deflateInit2( &stream, Z_BEST_SPEED, Z_DEFLATED, sgf_windowBits.GetInteger(), 9, Z_DEFAULT_STRATEGY ) != Z_OK ) {
+		return;
+	}
+
+	stream.next_in = (Bytef *)block->src;
+	stream.avail_in = block->srcBytes;
+	stream.next_out = (Bytef *)block->dest;
+	stream.avail_out = block->destBytes;
+
+	if ( deflate( &stream, Z_FINISH ) == Z_STREAM_END ) {
+		block->destBytes = (uint32)stream.total_out;
+		block->checksum = MD5_BlockChecksum( block->dest, block->destBytes );
+		block->ok = true;
+	}
+
+	deflateEnd( &stream );
+}
+
+REGISTER_PARALLEL_JOB( SGF_CompressBlockJob, "SGF_CompressBlockJob" );
+
+/*
+============================
+SGF_DecompressBlockJob
+============================
+*/
+static void SGF_DecompressBlockJob( sgfParallelBlock_t * block ) {
+	z_stream stream;
+	memset( &stream, 0, sizeof( stream ) );
+	stream.zalloc = ZlibAlloc;
+	stream.zfree = ZlibFree;
+
+	block->ok = false;
+
+	// don't try to decompress the block if the checksum is wrong
+	if ( MD5_BlockChecksum( block->src, block->srcBytes ) != block->checksum ) {
+		return;
+	}
+
+	if ( inflateInit2( &stream, sgf_windowBits.GetInteger() ) != Z_OK ) {
+		return;
+	}
+
+	stream.next_in = (Bytef *)block->src;
+	stream.avail_in = block->srcBytes;
+	stream.next_out = (Bytef *)block->dest;
+	stream.avail_out = block->destBytes;
+
+	if ( inflate( &stream, Z_FINISH ) == Z_STREAM_END ) {
+		block->ok = ( stream.total_out == block->destBytes );
+	}
+
+	inflateEnd( &stream );
+}
+
+REGISTER_PARALLEL_JOB( SGF_DecompressBlockJob, "SGF_DecompressBlockJob" );
+
+/*
+============================
+idFile_SaveGamePipelined::InitParallelJobList
+
+The job list is shared by all save files, several of which can be compressing or
+decompressing at the same time, so it is only used with parallelJobListMutex held.
+Without the job list the blocks are compressed and decompressed inline.
+============================
+*/
+void idFile_SaveGamePipelined::InitParallelJobList() {
+	if ( parallelJobList == NULL ) {
+		parallelJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, PARALLEL_BLOCKS, 0, NULL );
+	}
+}
+
+/*
+============================
+idFile_SaveGamePipelined::ShutdownParallelJobList
+============================
+*/
+void idFile_SaveGamePipelined::ShutdownParallelJobList() {
+	if ( parallelJobList != NULL ) {
+		parallelJobManager->FreeJobList( parallelJobList );
+		parallelJobList = NULL;
+	}
+}
+
+/*
+============================
+idFile_SaveGamePipelined::InitParallelBlocks
+
+Replaces the uncompressed buffer with one that holds two batches of blocks.
+============================
+*/
+void idFile_SaveGamePipelined::InitParallelBlocks() {
+	assert( uncompressedProducedBytes == 0 && uncompressedConsumedBytes == 0 );
+
+	parallelCompressedSize = ( compressBound( UNCOMPRESSED_BLOCK_SIZE ) + 15 ) & ~15;
+	parallelBuffer = (byte *)Mem_Alloc( PARALLEL_BUFFER_SIZE, TAG_SAVEGAMES );
+	parallelCompressed = (byte *)Mem_Alloc( PARALLEL_BLOCKS * parallelCompressedSize, TAG_SAVEGAMES );
+
+	uncompressedBuffer = parallelBuffer;
+	uncompressedBufferSize = PARALLEL_BUFFER_SIZE;
+	uncompressedFlushSize = PARALLEL_BATCH_SIZE;
+
+	parallelBlocks = true;
+}
+
+/*
+============================
+idFile_SaveGamePipelined::FreeParallelBlocks
+============================
+*/
+void idFile_SaveGamePipelined::FreeParallelBlocks() {
+	if ( parallelBuffer != NULL ) {
+		Mem_Free( parallelBuffer );
+		parallelBuffer = NULL;
+	}
+	if ( parallelCompressed != NULL ) {
+		Mem_Free( parallelCompressed );
+		parallelCompressed = NULL;
+	}
+
+	uncompressedBuffer = uncompressed;
+	uncompressedBufferSize = UNCOMPRESSED_BUFFER_SIZE;
+	uncompressedFlushSize = UNCOMPRESSED_BLOCK_SIZE;
+
+	parallelBlocks = false;
+}
+
+/*
+============================
+idFile_SaveGamePipelined::WriteCompressed
+
+Appends data to the compressed buffer and flushes every block that fills up.
+
+Modifies:
+	compressed
+	compressedProducedBytes
+============================
+*/
+void idFile_SaveGamePipelined::WriteCompressed( const void * data, size_t length ) {
+	const byte * data_p = (const byte *)data;
+	while ( length > 0 ) {
+		const size_t ofsInBuffer = compressedProducedBytes & ( COMPRESSED_BUFFER_SIZE - 1 );
+		const size_t ofsInBlock = compressedProducedBytes & ( COMPRESSED_BLOCK_SIZE - 1 );
+		const size_t remainingInBlock = COMPRESSED_BLOCK_SIZE - ofsInBlock;
+		const size_t copyToBlock = ( length < remainingInBlock ) ? length : remainingInBlock;
+
+		memcpy( compressed + ofsInBuffer, data_p, copyToBlock );
+		compressedProducedBytes += copyToBlock;
+
+		data_p += copyToBlock;
+		length -= copyToBlock;
+
+		if ( copyToBlock == remainingInBlock ) {
+			FlushCompressedBlock();
+		}
+	}
+}
+
+/*
+============================
+idFile_SaveGamePipelined::CompressParallelBlocks
+
+Compresses a batch of blocks from [dataZlib, dataZlib + bytesZlib) in parallel.
+
+Modifies:
+	dataZlib
+	bytesZlib
+	compressed
+	compressedProducedBytes
+	zStreamEndHit
+============================
+*/
+void idFile_SaveGamePipelined::CompressParallelBlocks() {
+	const byte * data = dataZlib;
+	size_t bytes = bytesZlib;
+
+	dataZlib = NULL;
+	bytesZlib = 0;
+
+	int numBlocks = 0;
+	while ( bytes > 0 ) {
+		assert( numBlocks < PARALLEL_BLOCKS );
+		sgfParallelBlock_t & block = parallelJobs[numBlocks++];
+		block.src = data;
+		block.srcBytes = (uint32)Min( bytes, (size_t)UNCOMPRESSED_BLOCK_SIZE );
+		block.dest = parallelCompressed + ( numBlocks - 1 ) * parallelCompressedSize;
+		block.destBytes = (uint32)parallelCompressedSize;
+
+		data += block.srcBytes;
+		bytes -= block.srcBytes;
+	}
+
+	if ( numBlocks > 1 && parallelJobList != NULL ) {
+		idScopedCriticalSection lock( parallelJobListMutex );
+		for ( int i = 0; i < numBlocks; i++ ) {
+			parallelJobList->AddJob( (jobRun_t)SGF_CompressBlockJob, &parallelJobs[i] );
+		}
+		parallelJobList->Submit();
+		parallelJobList->Wait();
+	} else {
+		for ( int i = 0; i < numBlocks; i++ ) {
+			SGF_CompressBlockJob( &parallelJobs[i] );
+		}
+	}
+
+	uint32 header[3];
+	for ( int i = 0; i < numBlocks; i++ ) {
+		const sgfParallelBlock_t & block = parallelJobs[i];
+		if ( !block.ok ) {
+			idLib::FatalError( "idFile_SaveGamePipelined::CompressParallelBlocks: deflate() failed" );
+		}
+		header[0] = LittleLong( block.destBytes );
+		header[1] = LittleLong( block.srcBytes );
+		header[2] = LittleLong( block.checksum );
+		WriteCompressed( header, sizeof( header ) );
+		WriteCompressed( block.dest, block.destBytes );
+	}
+
+	if ( zLibFlushType == Z_FINISH ) {
+		// an empty block ends the file
+		header[0] = header[1] = header[2] = 0;
+		WriteCompressed( header, sizeof( header ) );
+
+		// flush the final partial block
+		FlushCompressedBlock();
+		zStreamEndHit = true;
+	}
+}
+
+/*
+============================
+idFile_SaveGamePipelined::ReadCompressed
+
+Reads data from the compressed blocks, returns false if the end of the file is hit first.
+
+Modifies:
+	dataIO
+	bytesIO
+============================
+*/
+bool idFile_SaveGamePipelined::ReadCompressed( void * data, size_t length ) {
+	byte * data_p = (byte *)data;
+	while ( length > 0 ) {
+		while ( bytesIO == 0 ) {
+			PumpCompressedBlock();
+			if ( bytesIO == 0 && nativeFileEndHit ) {
+				return false;
+			}
+		}
+
+		const size_t copyFromBlock = ( length < bytesIO ) ? length : bytesIO;
+
+		memcpy( data_p, dataIO, copyFromBlock );
+		dataIO += copyFromBlock;
+		bytesIO -= copyFromBlock;
+
+		data_p += copyFromBlock;
+		length -= copyFromBlock;
+	}
+	return true;
+}
+
+/*
+============================
+idFile_SaveGamePipelined::DecompressParallelBlocks
+
+Reads the next batch of compressed blocks and decompresses them in parallel.
+
+Modifies:
+	dataIO
+	bytesIO
+	uncompressedBuffer
+	uncompressedProducedBytes
+	zStreamEndHit
+============================
+*/
+void idFile_SaveGamePipelined::DecompressParallelBlocks() {
+	assert( ( uncompressedProducedBytes & ( PARALLEL_BATCH_SIZE - 1 ) ) == 0 );
+	byte * dest = &uncompressedBuffer[ uncompressedProducedBytes & ( PARALLEL_BUFFER_SIZE - 1 ) ];
+
+	int numBlocks = 0;
+	while ( numBlocks < PARALLEL_BLOCKS ) {
+		uint32 header[3];
+		if ( !ReadCompressed( header, sizeof( header ) ) ) {
+			idLib::Warning( "idFile_SaveGamePipelined::DecompressParallelBlocks: unexpected end of file" );
+			zStreamEndHit = true;
+			break;
+		}
+
+		const uint32 compressedBytes = LittleLong( header[0] );
+		const uint32 uncompressedBytes = LittleLong( header[1] );
+		if ( compressedBytes == 0 ) {
+			// don't try to decompress any more
+			zStreamEndHit = true;
+			break;
+		}
+		if ( compressedBytes > parallelCompressedSize || uncompressedBytes > UNCOMPRESSED_BLOCK_SIZE ) {
+			idLib::Warning( "idFile_SaveGamePipelined::DecompressParallelBlocks: bad block header" );
+			zStreamEndHit = true;
+			break;
+		}
+
+		byte * src = parallelCompressed + numBlocks * parallelCompressedSize;
+		if ( !ReadCompressed( src, compressedBytes ) ) {
+			idLib::Warning( "idFile_SaveGamePipelined::DecompressParallelBlocks: unexpected end of file" );
+			zStreamEndHit = true;
+			break;
+		}
+
+		sgfParallelBlock_t & block = parallelJobs[numBlocks++];
+		block.src = src;
+		block.srcBytes = compressedBytes;
+		block.dest = dest;
+		block.destBytes = uncompressedBytes;
+		block.checksum = LittleLong( header[2] );
+
+		dest += uncompressedBytes;
+
+		if ( uncompressedBytes < UNCOMPRESSED_BLOCK_SIZE ) {
+			// only the last block can be partially filled
+			zStreamEndHit = true;
+			break;
+		}
+	}
+
+	if ( numBlocks > 1 && parallelJobList != NULL ) {
+		idScopedCriticalSection lock( parallelJobListMutex );
+		for ( int i = 0; i < numBlocks; i++ ) {
+			parallelJobList->AddJob( (jobRun_t)SGF_DecompressBlockJob, &parallelJobs[i] );
+		}
+		parallelJobList->Submit();
+		parallelJobList->Wait();
+	} else {
+		for ( int i = 0; i < numBlocks; i++ ) {
+			SGF_DecompressBlockJob( &parallelJobs[i] );
+		}
+	}
+
+	for ( int i = 0; i < numBlocks; i++ ) {
+		if ( !verify( parallelJobs[i].ok ) ) {
+			// don't try to decompress any more if a block is corrupt
+			idLib::Warning( "idFile_SaveGamePipelined::DecompressParallelBlocks: bad checksum or inflate() failed" );
+			zStreamEndHit = true;
+			break;
+		}
+		uncompressedProducedBytes += parallelJobs[i].destBytes;
+	}
+}
+
+/*
+===================================================================================
+
 TEST CODE
 
 ===================================================================================
@@ -1045,7 +1487,7 @@ TestProcessFile
 ============================
 */
 static void TestProcessFile( const char * const filename ) {
-	idLib::Printf( "Processing %s:\n", filename );
+	idLib::Printf( "Processing %s%s:\n", filename, sgf_parallelBlocks.GetBool() ? " with parallel blocks" : "" );
 	// load some test data
 	void *testData;
 	const int testDataLength = fileSystem->ReadFile( filename, &testData, NULL );
@@ -1103,7 +1545,13 @@ TestSaveGameFile
 */
 CONSOLE_COMMAND( TestSaveGameFile, "Exercises the pipelined savegame code", 0 ) {
 #if 1
-	TestProcessFile( "maps/game/wasteland1/wasteland1.map" );
+	// files written either way must read back the same
+	const bool parallelBlocks = sgf_parallelBlocks.GetBool();
+	for ( int i = 0; i < 2; i++ ) {
+		sgf_parallelBlocks.SetBool( i != 0 );
+		TestProcessFile( "maps/game/wasteland1/wasteland1.map" );
+	}
+	sgf_parallelBlocks.SetBool( parallelBlocks );
 #else
 	// test every file in base (found a fencepost error >100 files in originally!)
 	idFileList * fileList = fileSystem->ListFiles( "", "" );
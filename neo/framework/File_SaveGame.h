@@ -87,6 +87,15 @@ struct blockForIO_t {
 	size_t		bytes;
 };
 
+struct sgfParallelBlock_t {
+	const byte *	src;
+	byte *			dest;
+	uint32			srcBytes;
+	uint32			destBytes;
+	uint32			checksum;		// of the compressed data
+	bool			ok;
+};
+
 class idFile_SaveGamePipelined : public idFile {
 public:
 	// The buffers each hold two blocks of data, so one block can be operated on by
@@ -96,6 +105,11 @@ public:
 	static const int COMPRESSED_BLOCK_SIZE		= 128 * 1024;
 	static const int UNCOMPRESSED_BLOCK_SIZE	= 256 * 1024;
 
+	// With parallel blocks every uncompressed block is deflated on its own with a checksum,
+	// so a batch of blocks can be compressed or decompressed at the same time on the job
+	// system.  Files in the old single zlib stream format can still be read.
+	static const int PARALLEL_BLOCKS			= 8;
+
 
 							idFile_SaveGamePipelined();
 	virtual					~idFile_SaveGamePipelined();
@@ -115,6 +129,10 @@ public:
 	// Cancel any reading or writing for app termination
 	static void				CancelToTerminate() { cancelToTerminate = true; }
 
+	// Allocate and free the job list used for files with independently compressed blocks.
+	static void				InitParallelJobList();
+	static void				ShutdownParallelJobList();
+
 	bool					ReadBuildVersion();
 	const char *			GetBuildVersion() const { return buildVersion; }
 	
@@ -176,14 +194,24 @@ private:
 	idStr					osPath;		// OS path.
 	mode_t					mode;		// Open mode.
 	size_t					compressedLength;
+	bool					parallelBlocks;		// the file is a series of independently compressed blocks
+	bool					formatChecked;		// set once the first compressed block has been read
 
 	static const int COMPRESSED_BUFFER_SIZE		= COMPRESSED_BLOCK_SIZE * 2;
 	static const int UNCOMPRESSED_BUFFER_SIZE	= UNCOMPRESSED_BLOCK_SIZE * 2;
 
+	static const int PARALLEL_BATCH_SIZE		= UNCOMPRESSED_BLOCK_SIZE * PARALLEL_BLOCKS;
+	static const int PARALLEL_BUFFER_SIZE		= PARALLEL_BATCH_SIZE * 2;
+
 	byte					uncompressed[UNCOMPRESSED_BUFFER_SIZE];
 	size_t					uncompressedProducedBytes;	// not masked
 	size_t					uncompressedConsumedBytes;	// not masked
 
+	// with parallel blocks a whole batch of blocks is flushed at once from a larger buffer
+	byte *					uncompressedBuffer;
+	size_t					uncompressedBufferSize;
+	size_t					uncompressedFlushSize;
+
 	byte					compressed[COMPRESSED_BUFFER_SIZE];
 	size_t					compressedProducedBytes;	// not masked
 	size_t					compressedConsumedBytes;	// not masked
@@ -207,6 +235,17 @@ private:
 	bool					zStreamEndHit;
 	int						numChecksums;
 
+	//------------------------
+	// These variables are used by CompressParallelBlocks() and DecompressParallelBlocks().
+	//------------------------
+
+	byte *					parallelBuffer;			// PARALLEL_BUFFER_SIZE bytes replacing uncompressed
+	byte *					parallelCompressed;		// PARALLEL_BLOCKS compressed blocks of parallelCompressedSize bytes
+	size_t					parallelCompressedSize;
+	sgfParallelBlock_t		parallelJobs[PARALLEL_BLOCKS];
+	static idParallelJobList *	parallelJobList;	// shared by all save files
+	static idSysMutex		parallelJobListMutex;
+
 	//------------------------
 	// These variables are used by WriteBlock() and ReadBlock().
 	//------------------------
@@ -247,6 +286,13 @@ private:
 	void					PumpCompressedBlock();
 	void					DecompressBlock();
 	void					ReadBlock();
+
+	void					InitParallelBlocks();
+	void					FreeParallelBlocks();
+	void					CompressParallelBlocks();
+	void					DecompressParallelBlocks();
+	void					WriteCompressed( const void * data, size_t length );
+	bool					ReadCompressed( void * data, size_t length );
 };
 
 #endif // !__FILE_SAVEGAME_H__
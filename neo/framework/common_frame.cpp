@@ -66,6 +66,7 @@ idCVar com_skipGameDraw( "com_skipGameDraw", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 
 idCVar com_sleepGame( "com_sleepGame", "0", CVAR_SYSTEM | CVAR_INTEGER, "intentionally add a sleep in the game time" );
 idCVar com_sleepDraw( "com_sleepDraw", "0", CVAR_SYSTEM | CVAR_INTEGER, "intentionally add a sleep in the draw time" );
+idCVar com_traceMaxEvents( "com_traceMaxEvents", "262144", CVAR_SYSTEM | CVAR_INTEGER, "maximum number of events recorded by traceCapture", 1024, 16 * 1024 * 1024 );
 idCVar com_sleepRender( "com_sleepRender", "0", CVAR_SYSTEM | CVAR_INTEGER, "intentionally add a sleep in the render time" );
 
 idCVar net_drawDebugHud( "net_drawDebugHud", "0", CVAR_SYSTEM | CVAR_INTEGER, "0 = None, 1 = Hud 1, 2 = Hud 2, 3 = Snapshots" );
@@ -359,6 +360,44 @@ void idCommonLocal::ProcessGameReturn( const gameReturn_t & ret ) {
 
 extern idCVar com_forceGenericSIMD;
 
+/*
+=================
+idCommonLocal::StartTraceCapture
+=================
+*/
+void idCommonLocal::StartTraceCapture( int numFrames, const char * fileName ) {
+	if ( idTraceCapture::IsCapturing() ) {
+		Printf( "a trace capture is already running\n" );
+		return;
+	}
+	traceCaptureFrames = Max( numFrames, 1 );
+	traceCaptureFileName = fileName;
+	traceCaptureFileName.DefaultFileExtension( ".json" );
+	idTraceCapture::Start( com_traceMaxEvents.GetInteger() );
+	Printf( "capturing a trace of %d frames to %s\n", traceCaptureFrames, traceCaptureFileName.c_str() );
+}
+
+/*
+=================
+idCommonLocal::UpdateTraceCapture
+
+Marks the start of a new frame in the trace and writes the trace
+after the requested number of frames.
+=================
+*/
+void idCommonLocal::UpdateTraceCapture() {
+	if ( !idTraceCapture::IsCapturing() ) {
+		return;
+	}
+	if ( traceCaptureFrames-- <= 0 ) {
+		// make sure none of the job threads is still adding events
+		parallelJobManager->WaitForAllJobLists();
+		idTraceCapture::Stop( traceCaptureFileName );
+		return;
+	}
+	idTraceCapture::AddFrameMarker( idLib::frameNumber );
+}
+
 /*
 =================
 idCommonLocal::Frame
@@ -371,6 +410,8 @@ void idCommonLocal::Frame() {
 		// This is the only place this is incremented
 		idLib::frameNumber++;
 
+		UpdateTraceCapture();
+
 		// allow changing SIMD usage on the fly
 		if ( com_forceGenericSIMD.IsModified() ) {
 			idSIMD::InitProcessor( "doom", com_forceGenericSIMD.GetBool() );
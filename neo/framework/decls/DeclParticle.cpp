@@ -1437,7 +1437,25 @@ idParticleStage::ParticleColors
 ==================
 */
 void idParticleStage::ParticleColors( particleGen_t *g, idDrawVert *verts ) const {
+	const dword	fcolor = ParticleColor( g );
+
+	verts[0].SetColor( fcolor );
+	verts[1].SetColor( fcolor );
+	verts[2].SetColor( fcolor );
+	verts[3].SetColor( fcolor );
+}
+
+/*
+==================
+idParticleStage::ParticleColor
+==================
+*/
+dword idParticleStage::ParticleColor( const particleGen_t *g ) const {
 	float	fadeFraction = 1.0f;
+	union {
+		byte	b[4];
+		dword	d;
+	} result;
 
 	// most particles fade in at the beginning and fade out at the end
 	if ( g->frac < fadeInFraction ) {
@@ -1464,11 +1482,9 @@ void idParticleStage::ParticleColors( particleGen_t *g, idDrawVert *verts ) cons
 		} else if ( icolor > 255 ) {
 			icolor = 255;
 		}
-		verts[0].color[i] = 
-		verts[1].color[i] = 
-		verts[2].color[i] = 
-		verts[3].color[i] = icolor;
+		result.b[i] = icolor;
 	}
+	return result.d;
 }
 
 /*
@@ -1536,6 +1552,235 @@ int idParticleStage::CreateParticle( particleGen_t *g, idDrawVert *verts ) const
 	return numVerts * 2;
 }
 
+/*
+================
+SetupParticleGen
+================
+*/
+static ID_INLINE void SetupParticleGen( particleGen_t &g, const particleGen_t *gen, const particleSpawn_t &spawn, const float particleLife ) {
+	g.index = spawn.index;
+	g.frac = spawn.frac;
+	g.random = spawn.random;
+	g.originalRandom = spawn.random;
+	g.origin = ( spawn.origin != NULL ) ? *spawn.origin : gen->origin;
+	g.axis = ( spawn.axis != NULL ) ? *spawn.axis : gen->axis;
+	g.age = spawn.frac * particleLife;
+}
+
+static const int PARTICLE_BATCH_SIZE = 64;
+
+/*
+================
+idParticleStage::CreateParticles
+
+Creates the spawned particles in batches.  The colors, origins and random
+draws are calculated per particle in the same order as CreateParticle and
+stored as one array per component, then the quads are expanded four
+particles at a time.  Aimed particles back up along their path for the
+trails and still go through CreateParticle one at a time.
+================
+*/
+int idParticleStage::CreateParticles( const particleGen_t *gen, const particleSpawn_t *spawns, int numSpawns, idDrawVert *verts ) const {
+	particleGen_t g = *gen;
+	int numVerts = 0;
+
+	if ( orientation == POR_AIMED ) {
+		for ( int i = 0; i < numSpawns; i++ ) {
+			SetupParticleGen( g, gen, spawns[i], particleLife );
+			numVerts += CreateParticle( &g, verts + numVerts );
+		}
+		return numVerts;
+	}
+
+	// the quad axes are the same for all particles in the stage:
+	// left = ( axisA * cos + axisB * sin ) * width, up = ( axisB * cos - axisA * sin ) * height
+	idVec3 axisA, axisB;
+	switch( orientation ) {
+		case POR_X:
+			axisA.Set( 0.0f, 1.0f, 0.0f );
+			axisB.Set( 0.0f, 0.0f, 1.0f );
+			break;
+		case POR_Y:
+			axisA.Set( 1.0f, 0.0f, 0.0f );
+			axisB.Set( 0.0f, 0.0f, 1.0f );
+			break;
+		case POR_Z:
+			axisA.Set( 0.0f, 1.0f, 0.0f );
+			axisB.Set( 1.0f, 0.0f, 0.0f );
+			break;
+		default:
+			// oriented in viewer space
+			gen->renderEnt->axis.ProjectVector( gen->renderView->viewaxis[1], axisA );
+			gen->renderEnt->axis.ProjectVector( gen->renderView->viewaxis[2], axisB );
+			break;
+	}
+
+	const float texWidth = ( animationFrames > 1 ) ? 1.0f / animationFrames : 1.0f;
+
+	ALIGN16( float originX[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float originY[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float originZ[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float width[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float height[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float cosAngle[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float sinAngle[PARTICLE_BATCH_SIZE] );
+	ALIGN16( float cornerX[4][PARTICLE_BATCH_SIZE] );
+	ALIGN16( float cornerY[4][PARTICLE_BATCH_SIZE] );
+	ALIGN16( float cornerZ[4][PARTICLE_BATCH_SIZE] );
+	float	texS[PARTICLE_BATCH_SIZE];
+	float	frameFrac[PARTICLE_BATCH_SIZE];
+	dword	colors[PARTICLE_BATCH_SIZE];
+
+	for ( int first = 0; first < numSpawns; first += PARTICLE_BATCH_SIZE ) {
+		const int last = Min( first + PARTICLE_BATCH_SIZE, numSpawns );
+		int count = 0;
+
+		for ( int i = first; i < last; i++ ) {
+			SetupParticleGen( g, gen, spawns[i], particleLife );
+
+			// if we are completely faded out, kill the particle
+			const dword fcolor = ParticleColor( &g );
+			if ( fcolor == 0 ) {
+				continue;
+			}
+			colors[count] = fcolor;
+
+			idVec3 origin;
+			ParticleOrigin( &g, origin );
+			originX[count] = origin.x;
+			originY[count] = origin.y;
+			originZ[count] = origin.z;
+
+			if ( animationFrames > 1 ) {
+				const float floatFrame = ( animationRate ) ? g.age * animationRate : g.frac * animationFrames;
+				const int intFrame = (int)floatFrame;
+				frameFrac[count] = floatFrame - intFrame;
+				texS[count] = texWidth * intFrame;
+			} else {
+				frameFrac[count] = 0.0f;
+				texS[count] = 0.0f;
+			}
+
+			const float psize = size.Eval( g.frac, g.random );
+			width[count] = psize;
+			height[count] = psize * aspect.Eval( g.frac, g.random );
+
+			float angle = ( initialAngle ) ? initialAngle : 360 * g.random.RandomFloat();
+			const float angleMove = rotationSpeed.Integrate( g.frac, g.random ) * particleLife;
+			// have half the particles rotate each way
+			if ( g.index & 1 ) {
+				angle += angleMove;
+			} else {
+				angle -= angleMove;
+			}
+			angle = angle / 180 * idMath::PI;
+			cosAngle[count] = idMath::Cos16( angle );
+			sinAngle[count] = idMath::Sin16( angle );
+
+			count++;
+		}
+
+		// pad the last group of four with empty particles
+		for ( int i = count; i < ( ( count + 3 ) & ~3 ); i++ ) {
+			originX[i] = originY[i] = originZ[i] = 0.0f;
+			width[i] = height[i] = 0.0f;
+			cosAngle[i] = sinAngle[i] = 0.0f;
+		}
+
+		// expand the quads, vertex order is:
+		// 0 1
+		// 2 3
+#ifdef ID_X86_SSE2_INTRIN
+		const __m128 ax = _mm_set1_ps( axisA.x );
+		const __m128 ay = _mm_set1_ps( axisA.y );
+		const __m128 az = _mm_set1_ps( axisA.z );
+		const __m128 bx = _mm_set1_ps( axisB.x );
+		const __m128 by = _mm_set1_ps( axisB.y );
+		const __m128 bz = _mm_set1_ps( axisB.z );
+
+		for ( int i = 0; i < count; i += 4 ) {
+			const __m128 c = _mm_load_ps( cosAngle + i );
+			const __m128 s = _mm_load_ps( sinAngle + i );
+			const __m128 w = _mm_load_ps( width + i );
+			const __m128 h = _mm_load_ps( height + i );
+
+			const __m128 lx = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ax, c ), _mm_mul_ps( bx, s ) ), w );
+			const __m128 ly = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ay, c ), _mm_mul_ps( by, s ) ), w );
+			const __m128 lz = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( az, c ), _mm_mul_ps( bz, s ) ), w );
+			const __m128 ux = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( bx, c ), _mm_mul_ps( ax, s ) ), h );
+			const __m128 uy = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( by, c ), _mm_mul_ps( ay, s ) ), h );
+			const __m128 uz = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( bz, c ), _mm_mul_ps( az, s ) ), h );
+
+			const __m128 ox = _mm_load_ps( originX + i );
+			const __m128 oy = _mm_load_ps( originY + i );
+			const __m128 oz = _mm_load_ps( originZ + i );
+
+			_mm_store_ps( cornerX[0] + i, _mm_add_ps( _mm_sub_ps( ox, lx ), ux ) );
+			_mm_store_ps( cornerY[0] + i, _mm_add_ps( _mm_sub_ps( oy, ly ), uy ) );
+			_mm_store_ps( cornerZ[0] + i, _mm_add_ps( _mm_sub_ps( oz, lz ), uz ) );
+			_mm_store_ps( cornerX[1] + i, _mm_add_ps( _mm_add_ps( ox, lx ), ux ) );
+			_mm_store_ps( cornerY[1] + i, _mm_add_ps( _mm_add_ps( oy, ly ), uy ) );
+			_mm_store_ps( cornerZ[1] + i, _mm_add_ps( _mm_add_ps( oz, lz ), uz ) );
+			_mm_store_ps( cornerX[2] + i, _mm_sub_ps( _mm_sub_ps( ox, lx ), ux ) );
+			_mm_store_ps( cornerY[2] + i, _mm_sub_ps( _mm_sub_ps( oy, ly ), uy ) );
+			_mm_store_ps( cornerZ[2] + i, _mm_sub_ps( _mm_sub_ps( oz, lz ), uz ) );
+			_mm_store_ps( cornerX[3] + i, _mm_sub_ps( _mm_add_ps( ox, lx ), ux ) );
+			_mm_store_ps( cornerY[3] + i, _mm_sub_ps( _mm_add_ps( oy, ly ), uy ) );
+			_mm_store_ps( cornerZ[3] + i, _mm_sub_ps( _mm_add_ps( oz, lz ), uz ) );
+		}
+#else
+		for ( int i = 0; i < count; i++ ) {
+			const idVec3 origin( originX[i], originY[i], originZ[i] );
+			const idVec3 left = ( axisA * cosAngle[i] + axisB * sinAngle[i] ) * width[i];
+			const idVec3 up = ( axisB * cosAngle[i] - axisA * sinAngle[i] ) * height[i];
+			const idVec3 corners[4] = { origin - left + up, origin + left + up, origin - left - up, origin + left - up };
+			for ( int j = 0; j < 4; j++ ) {
+				cornerX[j][i] = corners[j].x;
+				cornerY[j][i] = corners[j].y;
+				cornerZ[j][i] = corners[j].z;
+			}
+		}
+#endif
+
+		for ( int i = 0; i < count; i++ ) {
+			idDrawVert *quad = verts + numVerts;
+
+			for ( int j = 0; j < 4; j++ ) {
+				quad[j].Clear();
+				quad[j].xyz.Set( cornerX[j][i], cornerY[j][i], cornerZ[j][i] );
+				quad[j].SetColor( colors[i] );
+			}
+			quad[0].SetTexCoord( texS[i], 0.0f );
+			quad[1].SetTexCoord( texS[i] + texWidth, 0.0f );
+			quad[2].SetTexCoord( texS[i], 1.0f );
+			quad[3].SetTexCoord( texS[i] + texWidth, 1.0f );
+			numVerts += 4;
+
+			if ( animationFrames <= 1 ) {
+				continue;
+			}
+
+			// if we are doing strip-animation, we need to double the quad and cross fade it
+			const float frac = frameFrac[i];
+			const float iFrac = 1.0f - frac;
+			for ( int j = 0; j < 4; j++ ) {
+				quad[4 + j] = quad[j];
+
+				const idVec2 tempST = quad[4 + j].GetTexCoord();
+				quad[4 + j].SetTexCoord( tempST.x + texWidth, tempST.y );
+
+				for ( int k = 0; k < 4; k++ ) {
+					quad[4 + j].color[k] *= frac;
+					quad[j].color[k] *= iFrac;
+				}
+			}
+			numVerts += 4;
+		}
+	}
+
+	return numVerts;
+}
+
 /*
 ==================
 idParticleStage::GetCustomPathName
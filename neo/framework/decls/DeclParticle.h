@@ -99,6 +99,14 @@ typedef struct {
 	float					animationFrameFrac;	// set by ParticleTexCoords, used to make the cross faded version
 } particleGen_t;
 
+typedef struct {
+	int						index;				// particle number in the system
+	float					frac;				// 0.0 to 1.0
+	idRandom				random;
+	const idVec3 *			origin;				// individual origin and axis of a dynamic smoke particle,
+	const idMat3 *			axis;				// NULL to use the ones in the particleGen_t
+} particleSpawn_t;
+
 
 //
 // single particle stage
@@ -112,11 +120,15 @@ public:
 	int						NumQuadsPerParticle() const;	// includes trails and cross faded animations
 	// returns the number of verts created, which will range from 0 to 4*NumQuadsPerParticle()
 	int						CreateParticle( particleGen_t *g, idDrawVert *verts ) const;
+	// same as CreateParticle for each spawned particle but evaluates the quads in batches,
+	// verts needs room for 4*NumQuadsPerParticle() verts per spawned particle
+	int						CreateParticles( const particleGen_t *g, const particleSpawn_t *spawns, int numSpawns, idDrawVert *verts ) const;
 
 	void					ParticleOrigin( particleGen_t *g, idVec3 &origin ) const;
 	int						ParticleVerts( particleGen_t *g, const idVec3 origin, idDrawVert *verts ) const;
 	void					ParticleTexCoords( particleGen_t *g, idDrawVert *verts ) const;
 	void					ParticleColors( particleGen_t *g, idDrawVert *verts ) const;
+	dword					ParticleColor( const particleGen_t *g ) const;
 
 	const char *			GetCustomPathName();
 	const char *			GetCustomPathDesc();
@@ -37,6 +37,242 @@ If you have questions concerning this license or the applicable additional terms
 
 #undef new
 
+/*
+================================================================================================
+
+	Engine heap
+
+	Small allocations are carved out of 64 KB pages that each serve a single size class, so
+	blocks of the same size end up next to each other and freed blocks are reused without
+	fragmenting the system heap. A page that becomes completely empty is handed back to the
+	system as long as its size class has other pages with free space.
+
+	Allocations larger than the biggest size class go straight to the system allocator. Blocks
+	of a page or more are rounded up to whole pages so the system can recycle them efficiently.
+
+	Every block is preceded by a 16 byte header that remembers the requested size and memory
+	tag, which lets Mem_Free16 maintain the per tag statistics reported by memTagStats.
+
+================================================================================================
+*/
+
+static const int	HEAP_PAGE_SIZE			= 64 * 1024;
+static const int	HEAP_LARGE_PAGE_SIZE	= 4 * 1024;
+static const uint16	HEAP_LARGE_BLOCK		= 0xFFFF;
+static const uint8	HEAP_MAGIC_ALLOCATED	= 0xA5;
+static const uint8	HEAP_MAGIC_FREE			= 0x5A;
+
+// payload sizes, block strides add the size of the block header
+static const int heapSizeClasses[] = {
+	16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024,
+	1280, 1536, 1792, 2048,
+	2560, 3072, 3584, 4096,
+	5120, 6144, 7168, 8192
+};
+static const int HEAP_NUM_SIZE_CLASSES = sizeof( heapSizeClasses ) / sizeof( heapSizeClasses[0] );
+
+struct heapBlockHeader_t {
+	union {
+		heapBlockHeader_t *	nextFree;	// only valid while the block is on a page free list
+		uint64				pad;
+	};
+	uint32					size;		// size requested by the caller
+	uint16					sizeClass;	// HEAP_LARGE_BLOCK for blocks from the system allocator
+	uint8					tag;
+	uint8					magic;
+};
+
+compile_time_assert( sizeof( heapBlockHeader_t ) == 16 );
+
+struct heapPage_t {
+	heapPage_t *			prev;		// links pages that have free blocks
+	heapPage_t *			next;
+	heapBlockHeader_t *		freeList;	// blocks that were freed
+	byte *					unused;		// blocks that were never handed out
+	int						sizeClass;
+	int						numUsed;
+	int						numBlocks;
+};
+
+static const int HEAP_PAGE_HEADER_SIZE = ( sizeof( heapPage_t ) + 15 ) & ~15;
+
+struct heapSizeClass_t {
+	interlockedInt_t		lock;
+	heapPage_t *			pages;		// pages with at least one free block
+	int						numPages;
+};
+
+struct heapTagStats_t {
+	interlockedInt_t		liveBytes;
+	interlockedInt_t		peakBytes;
+	interlockedInt_t		liveCount;
+};
+
+// all heap state is zero initialized so allocations from static constructors work
+static heapSizeClass_t		heapClasses[HEAP_NUM_SIZE_CLASSES];
+static heapTagStats_t		heapTagStats[MAX_TAGS];
+static interlockedInt_t		heapNumPages;
+static interlockedInt_t		heapLargeBytes;
+
+static const char * heapTagNames[] = {
+#define MEM_TAG( x )	#x,
+#include "sys/sys_alloc_tags.h"
+};
+
+/*
+==================
+Heap_Lock
+==================
+*/
+static void Heap_Lock( interlockedInt_t & lock ) {
+	for ( ; ; ) {
+		if ( *(volatile interlockedInt_t *)&lock == 0 && Sys_InterlockedCompareExchange( lock, 0, 1 ) == 0 ) {
+			return;
+		}
+		Sys_Yield();
+	}
+}
+
+/*
+==================
+Heap_Unlock
+==================
+*/
+static void Heap_Unlock( interlockedInt_t & lock ) {
+	Sys_InterlockedCompareExchange( lock, 1, 0 );
+}
+
+/*
+==================
+Heap_SizeClassForSize
+
+Returns -1 if the size is too large for the small block pages.
+==================
+*/
+static int Heap_SizeClassForSize( const int size ) {
+	if ( size <= 256 ) {
+		return ( size - 1 ) >> 4;
+	}
+	for ( int i = 16; i < HEAP_NUM_SIZE_CLASSES; i++ ) {
+		if ( size <= heapSizeClasses[i] ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+==================
+Heap_LargeAllocSize
+==================
+*/
+static int Heap_LargeAllocSize( const int size ) {
+	const int totalSize = size + sizeof( heapBlockHeader_t );
+	if ( totalSize >= HEAP_PAGE_SIZE ) {
+		return ( totalSize + HEAP_LARGE_PAGE_SIZE - 1 ) & ~( HEAP_LARGE_PAGE_SIZE - 1 );
+	}
+	return ( totalSize + 15 ) & ~15;
+}
+
+/*
+==================
+Heap_AllocSmall
+==================
+*/
+static heapBlockHeader_t * Heap_AllocSmall( const int sizeClass ) {
+	heapSizeClass_t & sc = heapClasses[sizeClass];
+	const int stride = heapSizeClasses[sizeClass] + sizeof( heapBlockHeader_t );
+
+	Heap_Lock( sc.lock );
+
+	heapPage_t * page = sc.pages;
+	if ( page == NULL ) {
+		page = (heapPage_t *)_mm_malloc( HEAP_PAGE_SIZE, HEAP_PAGE_SIZE );
+		if ( page == NULL ) {
+			Heap_Unlock( sc.lock );
+			return NULL;
+		}
+		page->prev = NULL;
+		page->next = NULL;
+		page->freeList = NULL;
+		page->unused = (byte *)page + HEAP_PAGE_HEADER_SIZE;
+		page->sizeClass = sizeClass;
+		page->numUsed = 0;
+		page->numBlocks = ( HEAP_PAGE_SIZE - HEAP_PAGE_HEADER_SIZE ) / stride;
+		sc.pages = page;
+		sc.numPages++;
+		Sys_InterlockedIncrement( heapNumPages );
+	}
+
+	heapBlockHeader_t * block = page->freeList;
+	if ( block != NULL ) {
+		page->freeList = block->nextFree;
+	} else {
+		// carve lazily so untouched parts of a page never become resident
+		block = (heapBlockHeader_t *)page->unused;
+		page->unused += stride;
+	}
+
+	// full pages are unlinked until one of their blocks is freed
+	if ( ++page->numUsed == page->numBlocks ) {
+		sc.pages = page->next;
+		if ( page->next != NULL ) {
+			page->next->prev = NULL;
+		}
+		page->next = NULL;
+	}
+
+	Heap_Unlock( sc.lock );
+
+	block->sizeClass = (uint16)sizeClass;
+	return block;
+}
+
+/*
+==================
+Heap_FreeSmall
+==================
+*/
+static void Heap_FreeSmall( heapBlockHeader_t * block ) {
+	heapPage_t * page = (heapPage_t *)( (uintptr_t)block & ~(uintptr_t)( HEAP_PAGE_SIZE - 1 ) );
+	heapSizeClass_t & sc = heapClasses[block->sizeClass];
+
+	assert( page->sizeClass == block->sizeClass );
+
+	Heap_Lock( sc.lock );
+
+	if ( page->numUsed == page->numBlocks ) {
+		page->prev = NULL;
+		page->next = sc.pages;
+		if ( sc.pages != NULL ) {
+			sc.pages->prev = page;
+		}
+		sc.pages = page;
+	}
+
+	block->nextFree = page->freeList;
+	page->freeList = block;
+
+	// keep a single empty page around to avoid thrashing at page boundaries
+	if ( --page->numUsed == 0 && ( page->prev != NULL || page->next != NULL ) ) {
+		if ( page->prev != NULL ) {
+			page->prev->next = page->next;
+		} else {
+			sc.pages = page->next;
+		}
+		if ( page->next != NULL ) {
+			page->next->prev = page->prev;
+		}
+		sc.numPages--;
+		Sys_InterlockedDecrement( heapNumPages );
+		_mm_free( page );
+	}
+
+	Heap_Unlock( sc.lock );
+}
+
 /*
 ==================
 Mem_Alloc16
@@ -46,8 +282,38 @@ void * Mem_Alloc16( const int size, const memTag_t tag ) {
 	if ( !size ) {
 		return NULL;
 	}
-	const int paddedSize = ( size + 15 ) & ~15;
-	return _mm_malloc( paddedSize, 16 );
+	assert( size > 0 );
+	assert( tag < MAX_TAGS );
+
+	heapBlockHeader_t * block;
+	const int sizeClass = Heap_SizeClassForSize( size );
+	if ( sizeClass >= 0 ) {
+		block = Heap_AllocSmall( sizeClass );
+	} else {
+		const int allocSize = Heap_LargeAllocSize( size );
+		block = (heapBlockHeader_t *)_mm_malloc( allocSize, 16 );
+		if ( block != NULL ) {
+			block->sizeClass = HEAP_LARGE_BLOCK;
+			Sys_InterlockedAdd( heapLargeBytes, allocSize );
+		}
+	}
+	if ( block == NULL ) {
+		return NULL;
+	}
+	block->size = size;
+	block->tag = (uint8)tag;
+	block->magic = HEAP_MAGIC_ALLOCATED;
+
+	heapTagStats_t & stats = heapTagStats[tag];
+	const int live = Sys_InterlockedAdd( stats.liveBytes, size );
+	Sys_InterlockedIncrement( stats.liveCount );
+	for ( int peak = stats.peakBytes; live > peak; peak = stats.peakBytes ) {
+		if ( Sys_InterlockedCompareExchange( stats.peakBytes, peak, live ) == peak ) {
+			break;
+		}
+	}
+
+	return block + 1;
 }
 
 /*
@@ -59,7 +325,64 @@ void Mem_Free16( void *ptr ) {
 	if ( ptr == NULL ) {
 		return;
 	}
-	_mm_free( ptr );
+	heapBlockHeader_t * block = (heapBlockHeader_t *)ptr - 1;
+
+	assert( block->magic == HEAP_MAGIC_ALLOCATED );
+	block->magic = HEAP_MAGIC_FREE;
+
+	heapTagStats_t & stats = heapTagStats[block->tag];
+	Sys_InterlockedSub( stats.liveBytes, block->size );
+	Sys_InterlockedDecrement( stats.liveCount );
+
+	if ( block->sizeClass == HEAP_LARGE_BLOCK ) {
+		Sys_InterlockedSub( heapLargeBytes, Heap_LargeAllocSize( block->size ) );
+		_mm_free( block );
+	} else {
+		Heap_FreeSmall( block );
+	}
+}
+
+/*
+==================
+Mem_ShowTagStats_f
+==================
+*/
+void Mem_ShowTagStats_f( const idCmdArgs &args ) {
+	int sorted[TAG_NUM_TAGS];
+	int numSorted = 0;
+	for ( int i = 0; i < TAG_NUM_TAGS; i++ ) {
+		if ( heapTagStats[i].peakBytes == 0 ) {
+			continue;
+		}
+		// insertion sort on live bytes, largest first
+		int j = numSorted++;
+		for ( ; j > 0 && heapTagStats[sorted[j - 1]].liveBytes < heapTagStats[i].liveBytes; j-- ) {
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = i;
+	}
+
+	int totalLive = 0;
+	int totalCount = 0;
+	idLib::Printf( "   live KB    peak KB     blocks  tag\n" );
+	for ( int i = 0; i < numSorted; i++ ) {
+		const heapTagStats_t & stats = heapTagStats[sorted[i]];
+		idLib::Printf( "%10d %10d %10d  TAG_%s\n", stats.liveBytes >> 10, stats.peakBytes >> 10, stats.liveCount, heapTagNames[sorted[i]] );
+		totalLive += stats.liveBytes >> 10;
+		totalCount += stats.liveCount;
+	}
+	idLib::Printf( "%10d KB live in %d blocks\n", totalLive, totalCount );
+	idLib::Printf( "%10d KB in %d small block pages\n", heapNumPages * ( HEAP_PAGE_SIZE >> 10 ), heapNumPages );
+	idLib::Printf( "%10d KB in large blocks\n", heapLargeBytes >> 10 );
+
+	if ( args.Argc() > 1 && idStr::Icmp( args.Argv( 1 ), "classes" ) == 0 ) {
+		idLib::Printf( "size class  pages\n" );
+		for ( int i = 0; i < HEAP_NUM_SIZE_CLASSES; i++ ) {
+			if ( heapClasses[i].numPages > 0 ) {
+				idLib::Printf( "%10d %6d\n", heapSizeClasses[i], heapClasses[i].numPages );
+			}
+		}
+	}
 }
 
 /*
@@ -58,6 +58,9 @@ ID_INLINE void		Mem_Free( void *ptr ) { Mem_Free16( ptr ); }
 void *		Mem_ClearedAlloc( const int size, const memTag_t tag );
 char *		Mem_CopyString( const char *in );
 
+// prints live and peak bytes per memory tag, optionally followed by the small block page usage
+void		Mem_ShowTagStats_f( const class idCmdArgs &args );
+
 ID_INLINE void *operator new( size_t s ) {
 	return Mem_Alloc( s, TAG_NEW );
 }
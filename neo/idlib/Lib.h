@@ -316,6 +316,7 @@ public:
 #include "Swap.h"
 #include "Callback.h"
 #include "ParallelJobList.h"
+#include "TraceCapture.h"
 
 #include "SoftwareCache.h"
 
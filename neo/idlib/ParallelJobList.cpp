@@ -128,9 +128,11 @@ idParallelJobList_Threads
 */
 
 static idCVar jobs_longJobMicroSec( "jobs_longJobMicroSec", "10000", CVAR_INTEGER, "print a warning for jobs that take more than this number of microseconds" );
+static idCVar jobs_helpOnWait( "jobs_helpOnWait", "1", CVAR_BOOL | CVAR_NOCHEAT, "run jobs on the waiting thread instead of spinning until the job threads are done" );
 
 
 const static int		MAX_THREADS	= 32;
+const static int		WAIT_THREAD_UNIT = MAX_THREADS - 1;		// stats unit of the thread that helps out while waiting
 
 struct threadJobListState_t {
 								threadJobListState_t() :
@@ -171,7 +173,8 @@ public:
 	//------------------------
 	// These are called from the one thread that manages this list.
 	//------------------------
-	ID_INLINE void			AddJob( jobRun_t function, void * data );
+	ID_INLINE int			AddJob( jobRun_t function, void * data );
+	ID_INLINE void			AddDependency( int job, int dependsOn );
 	ID_INLINE void			InsertSyncPoint( jobSyncType_t syncType );
 	void					Submit( idParallelJobList_Threads * waitForJobList_, int parallelism );
 	void					Wait();
@@ -213,6 +216,7 @@ private:
 	bool					threaded;
 	bool					done;
 	bool					hasSignal;
+	bool					hasDependencies;
 	jobListId_t				listId;
 	jobListPriority_t		listPriority;
 	unsigned int			maxJobs;
@@ -234,10 +238,25 @@ private:
 	idSysInterlockedInteger				fetchLock;
 	idSysInterlockedInteger				numThreadsExecuting;
 
+	// jobs with dependencies are not fetched in order but from a queue with jobs that are ready to run
+	idList< int, TAG_JOBLIST >			dependencies;			// pairs of job and the job it depends on
+	idList< int, TAG_JOBLIST >			firstSuccessor;			// index into successors for each job
+	idList< int, TAG_JOBLIST >			successors;				// jobs that depend on each job
+	idList< idSysInterlockedInteger, TAG_JOBLIST >	numPendingDependencies;
+	idList< int, TAG_JOBLIST >			readyJobs;				// each job is added exactly once
+	idSysInterlockedInteger				readyJobsHead;
+	idSysInterlockedInteger				readyJobsTail;
+
 	threadStats_t						deferredThreadStats;
 	threadStats_t						threadStats;
 
-	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t & state, bool singleJob );
+	int						RunJobs( unsigned int threadNum, threadJobListState_t & state, bool singleJob, uint64 & execTime, uint64 & totalTime );
+	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t & state, bool singleJob, uint64 & execTime );
+	int						RunJobGraphInternal( unsigned int threadNum, bool singleJob, uint64 & execTime );
+	void					ExecuteJob( unsigned int threadNum, int jobIndex, uint64 & execTime );
+	void					SetupJobGraph();
+	void					AddReadyJob( int jobIndex );
+	int						FetchReadyJob();
 
 	static void				Nop( void * data ) {}
 
@@ -259,6 +278,7 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	threaded( true ),
 	done( true ),
 	hasSignal( false ),
+	hasDependencies( false ),
 	listId( id ),
 	listPriority( priority ),
 	numSyncs( 0 ),
@@ -294,7 +314,7 @@ idParallelJobList_Threads::~idParallelJobList_Threads() {
 idParallelJobList_Threads::AddJob
 ========================
 */
-ID_INLINE void idParallelJobList_Threads::AddJob( jobRun_t function, void * data ) {
+ID_INLINE int idParallelJobList_Threads::AddJob( jobRun_t function, void * data ) {
 	assert( done );
 #if defined( _DEBUG )
 	// make sure there isn't already a job with the same function and data in the list
@@ -331,6 +351,26 @@ ID_INLINE void idParallelJobList_Threads::AddJob( jobRun_t function, void * data
 		}
 		idLib::Error( "Can't add job '%s', too many jobs %d", GetJobName( function ), jobList.Num() );
 	}
+	return jobList.Num() - 1;
+}
+
+/*
+========================
+idParallelJobList_Threads::AddDependency
+========================
+*/
+ID_INLINE void idParallelJobList_Threads::AddDependency( int job, int dependsOn ) {
+	assert( done );
+	// sync points and dependencies don't mix
+	if ( numSyncs != 0 || hasSignal ) {
+		idLib::Error( "Can't add dependency to job list '%s' with sync points", GetJobListName( listId ) );
+	}
+	// only depending on an earlier job also makes cycles impossible
+	if ( dependsOn < 0 || dependsOn >= job || job >= jobList.Num() ) {
+		idLib::Error( "Can't make job %d depend on job %d in job list '%s' with %d jobs", job, dependsOn, GetJobListName( listId ), jobList.Num() );
+	}
+	dependencies.Append( job );
+	dependencies.Append( dependsOn );
 }
 
 /*
@@ -340,6 +380,9 @@ idParallelJobList_Threads::InsertSyncPoint
 */
 ID_INLINE void idParallelJobList_Threads::InsertSyncPoint( jobSyncType_t syncType ) {
 	assert( done );
+	if ( dependencies.Num() > 0 ) {
+		idLib::Error( "Can't insert sync point in job list '%s' with dependencies", GetJobListName( listId ) );
+	}
 	switch( syncType ) {
 		case SYNC_SIGNAL: {
 			assert( !hasSignal );
@@ -406,9 +449,14 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads * waitForJobLi
 	signalJobCount.Alloc();
 	signalJobCount[signalJobCount.Num() - 1].SetValue( jobList.Num() - lastSignalJob );
 
-	job_t & job = jobList.Alloc();
-	job.function = Nop;
-	job.data = & JOB_LIST_DONE;
+	hasDependencies = ( dependencies.Num() > 0 );
+	if ( hasDependencies ) {
+		SetupJobGraph();
+	} else {
+		job_t & job = jobList.Alloc();
+		job.function = Nop;
+		job.data = & JOB_LIST_DONE;
+	}
 
 	if ( threaded ) {
 		// hand over to the manager
@@ -435,6 +483,29 @@ void idParallelJobList_Threads::Wait() {
 
 		bool waited = false;
 		uint64 waitStart = Sys_Microseconds();
+		// the times of this thread are kept locally until the job threads are done with the list
+		uint64 waitExecTime = 0;
+		uint64 waitTotalTime = 0;
+
+		// instead of spinning, run the remaining jobs on this thread together with the job threads
+		if ( threaded && jobs_helpOnWait.GetBool() ) {
+			threadJobListState_t state( GetVersion() );
+			for ( ; ; ) {
+				if ( WaitForOtherJobList() ) {
+					Sys_Yield();
+					waited = true;
+					continue;
+				}
+				int result = RunJobs( WAIT_THREAD_UNIT, state, false, waitExecTime, waitTotalTime );
+				if ( ( result & RUN_DONE ) != 0 ) {
+					break;
+				}
+				if ( ( result & RUN_PROGRESS ) == 0 ) {
+					Sys_Yield();
+					waited = true;
+				}
+			}
+		}
 
 		while ( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 ) {
 			Sys_Yield();
@@ -446,13 +517,21 @@ void idParallelJobList_Threads::Wait() {
 			waited = true;
 		}
 
+		deferredThreadStats.threadExecTime[WAIT_THREAD_UNIT] = waitExecTime;
+		deferredThreadStats.threadTotalTime[WAIT_THREAD_UNIT] = waitTotalTime;
+
 		jobList.SetNum( 0 );
 		signalJobCount.SetNum( 0 );
+		dependencies.SetNum( 0 );
 		numSyncs = 0;
 		lastSignalJob = 0;
 
 		uint64 waitEnd = Sys_Microseconds();
 		deferredThreadStats.waitTime = waited ? ( waitEnd - waitStart ) : 0;
+
+		if ( idTraceCapture::IsCapturing() ) {
+			idTraceCapture::AddEvent( GetJobListName( listId ), "jobListWait", waitStart, waitEnd );
+		}
 	}
 	memcpy( & threadStats, & deferredThreadStats, sizeof( threadStats ) );
 	done = true;
@@ -536,12 +615,170 @@ volatile jobRun_t longJobFunc;
 volatile void * longJobData;
 #endif
 
+/*
+========================
+idParallelJobList_Threads::ExecuteJob
+========================
+*/
+void idParallelJobList_Threads::ExecuteJob( unsigned int threadNum, int jobIndex, uint64 & execTime ) {
+	uint64 jobStart = Sys_Microseconds();
+
+	jobList[jobIndex].function( jobList[jobIndex].data );
+	jobList[jobIndex].executed = 1;
+
+	uint64 jobEnd = Sys_Microseconds();
+	execTime += jobEnd - jobStart;
+
+	if ( idTraceCapture::IsCapturing() ) {
+		idTraceCapture::AddEvent( GetJobName( jobList[jobIndex].function ), GetJobListName( GetId() ), jobStart, jobEnd );
+	}
+
+#ifndef _DEBUG
+	if ( jobs_longJobMicroSec.GetInteger() > 0 ) {
+		if ( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
+			&& GetId() != JOBLIST_UTILITY ) {
+			longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
+			longJobFunc = jobList[jobIndex].function;
+			longJobData = jobList[jobIndex].data;
+			const char * jobName = GetJobName( jobList[jobIndex].function );
+			const char * jobListName = GetJobListName( GetId() );
+			idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
+		}
+	}
+#endif
+}
+
+/*
+========================
+idParallelJobList_Threads::SetupJobGraph
+
+Builds the successor lists from the dependencies and queues all jobs
+that don't depend on anything.
+========================
+*/
+void idParallelJobList_Threads::SetupJobGraph() {
+	const int numJobs = jobList.Num();
+	const int numDependencies = dependencies.Num() / 2;
+
+	numPendingDependencies.SetNum( numJobs );
+	firstSuccessor.SetNum( numJobs + 1 );
+	for ( int i = 0; i < numJobs; i++ ) {
+		numPendingDependencies[i].SetValue( 0 );
+		firstSuccessor[i] = 0;
+	}
+	firstSuccessor[numJobs] = 0;
+
+	for ( int i = 0; i < numDependencies; i++ ) {
+		const int job = dependencies[i * 2 + 0];
+		const int dependsOn = dependencies[i * 2 + 1];
+		numPendingDependencies[job].SetValue( numPendingDependencies[job].GetValue() + 1 );
+		firstSuccessor[dependsOn + 1]++;
+	}
+	for ( int i = 0; i < numJobs; i++ ) {
+		firstSuccessor[i + 1] += firstSuccessor[i];
+	}
+
+	// fill in the successors using readyJobs as the insertion point for each job
+	successors.SetNum( numDependencies );
+	readyJobs.SetNum( numJobs );
+	for ( int i = 0; i < numJobs; i++ ) {
+		readyJobs[i] = firstSuccessor[i];
+	}
+	for ( int i = 0; i < numDependencies; i++ ) {
+		successors[readyJobs[dependencies[i * 2 + 1]]++] = dependencies[i * 2 + 0];
+	}
+
+	for ( int i = 0; i < numJobs; i++ ) {
+		readyJobs[i] = -1;
+	}
+	readyJobsHead.SetValue( 0 );
+	readyJobsTail.SetValue( 0 );
+	for ( int i = 0; i < numJobs; i++ ) {
+		if ( numPendingDependencies[i].GetValue() == 0 ) {
+			AddReadyJob( i );
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::AddReadyJob
+========================
+*/
+void idParallelJobList_Threads::AddReadyJob( int jobIndex ) {
+	const int slot = readyJobsTail.Increment() - 1;
+	readyJobs[slot] = jobIndex;
+}
+
+/*
+========================
+idParallelJobList_Threads::FetchReadyJob
+
+Returns -1 if no job is ready to run right now.
+========================
+*/
+int idParallelJobList_Threads::FetchReadyJob() {
+	for ( ; ; ) {
+		const int head = readyJobsHead.GetValue();
+		if ( head >= readyJobsTail.GetValue() ) {
+			return -1;
+		}
+		if ( readyJobsHead.CompareExchange( head, head + 1 ) == head ) {
+			// the slot may have been reserved but not written yet
+			while ( ( (volatile int *)readyJobs.Ptr() )[head] < 0 ) {
+				Sys_Yield();
+			}
+			return readyJobs[head];
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::RunJobGraphInternal
+========================
+*/
+int idParallelJobList_Threads::RunJobGraphInternal( unsigned int threadNum, bool singleJob, uint64 & execTime ) {
+	int result = RUN_OK;
+
+	do {
+		const int jobIndex = FetchReadyJob();
+		if ( jobIndex < 0 ) {
+			if ( signalJobCount[0].GetValue() <= 0 ) {
+				return ( result | RUN_DONE );
+			}
+			// waiting for the dependencies of the remaining jobs
+			return ( result | RUN_STALLED );
+		}
+
+		ExecuteJob( threadNum, jobIndex, execTime );
+
+		result |= RUN_PROGRESS;
+
+		// release the jobs that were only waiting for this one
+		for ( int i = firstSuccessor[jobIndex]; i < firstSuccessor[jobIndex + 1]; i++ ) {
+			if ( numPendingDependencies[successors[i]].Decrement() == 0 ) {
+				AddReadyJob( successors[i] );
+			}
+		}
+
+		if ( signalJobCount[0].Decrement() == 0 ) {
+			deferredThreadStats.endTime = Sys_Microseconds();
+			doneGuards[currentDoneGuard].Decrement();
+			return ( result | RUN_DONE );
+		}
+
+	} while( ! singleJob );
+
+	return result;
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobsInternal
 ========================
 */
-int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJobListState_t & state, bool singleJob ) {
+int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJobListState_t & state, bool singleJob, uint64 & execTime ) {
 	if ( state.version != version.GetValue() ) {
 		// trying to run an old version of this list that is already done
 		return RUN_DONE;
@@ -553,6 +790,10 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		deferredThreadStats.startTime = Sys_Microseconds();	// first time any thread is running jobs from this list
 	}
 
+	if ( hasDependencies ) {
+		return RunJobGraphInternal( threadNum, singleJob, execTime );
+	}
+
 	int result = RUN_OK;
 
 	do {
@@ -626,29 +867,7 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		}
 
 		// execute the next job
-		{
-			uint64 jobStart = Sys_Microseconds();
-
-			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
-			jobList[state.nextJobIndex].executed = 1;
-
-			uint64 jobEnd = Sys_Microseconds();
-			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
-
-#ifndef _DEBUG
-			if ( jobs_longJobMicroSec.GetInteger() > 0 ) {
-				if ( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
-					&& GetId() != JOBLIST_UTILITY ) {
-					longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
-					longJobFunc = jobList[state.nextJobIndex].function;
-					longJobData = jobList[state.nextJobIndex].data;
-					const char * jobName = GetJobName( jobList[state.nextJobIndex].function );
-					const char * jobListName = GetJobListName( GetId() );
-					idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
-				}
-			}
-#endif
-		}
+		ExecuteJob( threadNum, state.nextJobIndex, execTime );
 
 		result |= RUN_PROGRESS;
 
@@ -672,15 +891,26 @@ idParallelJobList_Threads::RunJobs
 ========================
 */
 int idParallelJobList_Threads::RunJobs( unsigned int threadNum, threadJobListState_t & state, bool singleJob ) {
+	assert( threadNum < WAIT_THREAD_UNIT );
+	// every job thread only ever writes its own unit
+	return RunJobs( threadNum, state, singleJob, deferredThreadStats.threadExecTime[threadNum], deferredThreadStats.threadTotalTime[threadNum] );
+}
+
+/*
+========================
+idParallelJobList_Threads::RunJobs
+========================
+*/
+int idParallelJobList_Threads::RunJobs( unsigned int threadNum, threadJobListState_t & state, bool singleJob, uint64 & execTime, uint64 & totalTime ) {
 	uint64 start = Sys_Microseconds();
 
 	numThreadsExecuting.Increment();
 
-	int result = RunJobsInternal( threadNum, state, singleJob );
+	int result = RunJobsInternal( threadNum, state, singleJob, execTime );
 
 	numThreadsExecuting.Decrement();
 
-	deferredThreadStats.threadTotalTime[threadNum] += Sys_Microseconds() - start;
+	totalTime += Sys_Microseconds() - start;
 
 	return result;
 }
@@ -732,9 +962,18 @@ idParallelJobList::~idParallelJobList() {
 idParallelJobList::AddJob
 ========================
 */
-void idParallelJobList::AddJob( jobRun_t function, void * data ) {
+int idParallelJobList::AddJob( jobRun_t function, void * data ) {
 	assert( IsRegisteredJob( function ) );
-	jobListThreads->AddJob( function, data );
+	return jobListThreads->AddJob( function, data );
+}
+
+/*
+========================
+idParallelJobList::AddDependency
+========================
+*/
+void idParallelJobList::AddDependency( int job, int dependsOn ) {
+	jobListThreads->AddDependency( job, dependsOn );
 }
 
 /*
@@ -1090,9 +1329,11 @@ extern int Sys_GetCPUCount();
 //
 // Hyperthreading is not dead yet.  Intel's Core i7 Processor is quad-core with HT for 8 logicals.
 
-// DOOM3: We don't have that many jobs, so just set this fairly low so we don't spin up a ton of idle threads
-#define MAX_JOB_THREADS		2
-#define NUM_JOB_THREADS		"2"
+// Job threads are only started for the logical cores that are actually available, and the
+// waiting thread helps out, so by default use one thread less than there are logical cores.
+#define MIN_JOB_THREADS		2
+#define MAX_JOB_THREADS		( MAX_THREADS - 1 )		// the last unit is used by waiting threads
+#define NUM_JOB_THREADS		"-1"
 #define JOB_THREAD_CORES	{	CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
@@ -1103,7 +1344,7 @@ extern int Sys_GetCPUCount();
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY }
 
 
-idCVar jobs_numThreads( "jobs_numThreads", NUM_JOB_THREADS, CVAR_INTEGER | CVAR_NOCHEAT, "number of threads used to crunch through jobs", 0, MAX_JOB_THREADS );
+idCVar jobs_numThreads( "jobs_numThreads", NUM_JOB_THREADS, CVAR_INTEGER | CVAR_NOCHEAT, "number of threads used to crunch through jobs, -1 = one less than the number of logical cores", -1, MAX_JOB_THREADS );
 
 class idParallelJobManagerLocal : public idParallelJobManager {
 public:
@@ -1127,8 +1368,12 @@ public:
 
 private:
 	idJobThread						threads[MAX_JOB_THREADS];
+	unsigned int					numJobThreads;			// number of started job threads
 	unsigned int					maxThreads;
 	int								numLogicalCpuCores;
+	idSysInterlockedInteger			nextThread;				// first thread for the next submitted job list
+
+	unsigned int				GetNumThreadsFromCVar() const;
 	idStaticList< idParallelJobList *, MAX_JOBLISTS >	jobLists;
 };
 
@@ -1154,12 +1399,27 @@ void idParallelJobManagerLocal::Init() {
 	core_t cores[] = JOB_THREAD_CORES;
 	assert( sizeof( cores ) / sizeof( cores[0] ) >= MAX_JOB_THREADS );
 
-	for ( int i = 0; i < MAX_JOB_THREADS; i++ ) {
+	numLogicalCpuCores = Sys_GetCPUCount();
+
+	// don't spin up idle threads for cores that don't exist
+	numJobThreads = idMath::ClampInt( MIN_JOB_THREADS, MAX_JOB_THREADS, numLogicalCpuCores );
+	for ( unsigned int i = 0; i < numJobThreads; i++ ) {
 		threads[i].Start( cores[i], i );
 	}
-	maxThreads = jobs_numThreads.GetInteger();
+	maxThreads = GetNumThreadsFromCVar();
+	jobs_numThreads.ClearModified();
+}
 
-	numLogicalCpuCores = Sys_GetCPUCount();
+/*
+========================
+idParallelJobManagerLocal::GetNumThreadsFromCVar
+========================
+*/
+unsigned int idParallelJobManagerLocal::GetNumThreadsFromCVar() const {
+	if ( jobs_numThreads.GetInteger() < 0 ) {
+		return idMath::ClampInt( 1, numJobThreads, numLogicalCpuCores - 1 );
+	}
+	return idMath::ClampInt( 0, numJobThreads, jobs_numThreads.GetInteger() );
 }
 
 /*
@@ -1168,7 +1428,7 @@ idParallelJobManagerLocal::Shutdown
 ========================
 */
 void idParallelJobManagerLocal::Shutdown() {
-	for ( int i = 0; i < MAX_JOB_THREADS; i++ ) {
+	for ( unsigned int i = 0; i < numJobThreads; i++ ) {
 		threads[i].StopThread();
 	}
 }
@@ -1199,7 +1459,7 @@ void idParallelJobManagerLocal::FreeJobList( idParallelJobList * jobList ) {
 		return;
 	}
 	// wait for all job threads to finish because job list deletion is not thread safe
-	for ( unsigned int i = 0; i < maxThreads; i++ ) {
+	for ( unsigned int i = 0; i < numJobThreads; i++ ) {
 		threads[i].WaitForThread();
 	}
 	int index = jobLists.FindIndex( jobList );
@@ -1264,7 +1524,7 @@ idParallelJobManagerLocal::Submit
 */
 void idParallelJobManagerLocal::Submit( idParallelJobList_Threads * jobList, int parallelism ) {
 	if ( jobs_numThreads.IsModified() ) {
-		maxThreads = idMath::ClampInt( 0, MAX_JOB_THREADS, jobs_numThreads.GetInteger() );
+		maxThreads = GetNumThreadsFromCVar();
 		jobs_numThreads.ClearModified();
 	}
 
@@ -1275,12 +1535,11 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads * jobList, int
 	} else if ( parallelism == JOBLIST_PARALLELISM_MAX_CORES ) {
 		numThreads = numLogicalCpuCores;
 	} else if ( parallelism == JOBLIST_PARALLELISM_MAX_THREADS ) {
-		numThreads = MAX_JOB_THREADS;
-	} else if ( parallelism > MAX_JOB_THREADS ) {
-		numThreads = MAX_JOB_THREADS;
+		numThreads = numJobThreads;
 	} else {
 		numThreads = parallelism;
 	}
+	numThreads = Min( numThreads, (int)numJobThreads );
 
 	if ( numThreads <= 0 ) {
 		threadJobListState_t state( jobList->GetVersion() );
@@ -1288,8 +1547,14 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads * jobList, int
 		return;
 	}
 
+	// Jobs are fetched one at a time from a shared index in the job list, so any thread that
+	// picks up the list steals work from the others. Rotate the first thread for every job list
+	// so lists from different systems with limited parallelism interleave on all the cores
+	// instead of piling up on the first threads.
+	const unsigned int firstThread = (unsigned int)nextThread.Increment();
 	for ( int i = 0; i < numThreads; i++ ) {
-		threads[i].AddJobList( jobList );
-		threads[i].SignalWork();
+		idJobThread & thread = threads[( firstThread + i ) % numJobThreads];
+		thread.AddJobList( jobList );
+		thread.SignalWork();
 	}
 }
\ No newline at end of file
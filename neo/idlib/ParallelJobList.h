@@ -75,19 +75,34 @@ order to outweigh any job switching overhead. On the other
 hand a job should consume no more than a couple of
 100,000 clock cycles to maintain a good load balance over
 multiple processing units.
+
+Instead of sync points, jobs can declare the jobs they depend
+on. A job with dependencies is started as soon as all the jobs
+it depends on are done, so it does not wait for the slowest
+job of a whole stage. Jobs can only depend on jobs that were
+added before them, and dependencies can't be mixed with sync
+points in the same list. Breaking either rule is a fatal error.
+
+	int entityJob = jobList->AddJob( (jobRun_t)AddEntityJob, entity );
+	int shadowJob = jobList->AddJob( (jobRun_t)ShadowVolumeJob, shadowParms );
+	jobList->AddDependency( shadowJob, entityJob );
+	jobList->Submit();
 ================================================
 */
 class idParallelJobList {
 	friend class idParallelJobManagerLocal;
 public:
 
-	void					AddJob( jobRun_t function, void * data );
+	// Returns the index of the job for use with AddDependency.
+	int						AddJob( jobRun_t function, void * data );
+	// The job will not be started before the job it depends on is done.
+	void					AddDependency( int job, int dependsOn );
 	CellSpursJob128 *		AddJobSPURS();
 	void					InsertSyncPoint( jobSyncType_t syncType );
 
 	// Submit the jobs in this list.
 	void					Submit( idParallelJobList * waitForJobList = NULL, int parallelism = JOBLIST_PARALLELISM_DEFAULT );
-	// Wait for the jobs in this list to finish. Will spin in place if any jobs are not done.
+	// Wait for the jobs in this list to finish. Runs any jobs that are not done yet on the calling thread.
 	void					Wait();
 	// Try to wait for the jobs in this list to finish but either way return immediately. Returns true if all jobs are done.
 	bool					TryWait();
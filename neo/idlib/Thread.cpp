@@ -282,6 +282,8 @@ int idSysThread::ThreadProc( idSysThread * thread ) {
 
 	Sys_SetCurrentThreadPriority( thread->priority );
 
+	idTraceCapture::SetThreadName( thread->GetName() );
+
 	try {
 		if ( thread->isWorker ) {
 			for( ; ; ) {
@@ -0,0 +1,255 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").  
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#pragma hdrstop
+#include "precompiled.h"
+
+static const int MAX_TRACE_NAME		= 48;
+static const int MAX_TRACE_THREADS	= 64;
+
+struct traceEvent_t {
+	char				name[MAX_TRACE_NAME];
+	const char *		category;		// NULL for frame markers
+	uint64				startTime;
+	uint32				duration;
+	uint32				threadId;
+};
+
+struct traceThread_t {
+	uint32				threadId;
+	char				name[MAX_TRACE_NAME];
+};
+
+volatile bool					idTraceCapture::capturing = false;
+
+static traceEvent_t *			traceEvents;
+static int						traceMaxEvents;
+static uint64					traceStartTime;
+static idSysInterlockedInteger	traceNumEvents;
+static idSysInterlockedInteger	traceNumWriters;		// threads that may be writing an event right now
+static traceThread_t			traceThreads[MAX_TRACE_THREADS];
+static idSysInterlockedInteger	traceNumThreads;
+
+/*
+========================
+Trace_ThreadId
+========================
+*/
+static uint32 Trace_ThreadId() {
+	return (uint32)Sys_GetCurrentThreadID();
+}
+
+/*
+========================
+Trace_AllocEvent
+
+Returns NULL if there is no capture running or the buffer is full. The
+caller must call Trace_FinishEvent if this didn't return NULL.
+========================
+*/
+static traceEvent_t * Trace_AllocEvent() {
+	traceNumWriters.Increment();
+	if ( idTraceCapture::IsCapturing() ) {
+		const int index = traceNumEvents.Increment() - 1;
+		if ( index < traceMaxEvents ) {
+			return &traceEvents[index];
+		}
+	}
+	traceNumWriters.Decrement();
+	return NULL;
+}
+
+/*
+========================
+Trace_FinishEvent
+========================
+*/
+static void Trace_FinishEvent() {
+	traceNumWriters.Decrement();
+}
+
+/*
+========================
+Trace_WriteString
+
+Writes a string with JSON escapes.
+========================
+*/
+static void Trace_WriteString( idFile * file, const char * string ) {
+	char buffer[MAX_TRACE_NAME * 2 + 1];
+	int length = 0;
+	for ( const char * s = string; *s != '\0' && length < MAX_TRACE_NAME * 2 - 1; s++ ) {
+		if ( *s == '"' || *s == '\\' ) {
+			buffer[length++] = '\\';
+			buffer[length++] = *s;
+		} else if ( (unsigned char)*s >= ' ' ) {
+			buffer[length++] = *s;
+		}
+	}
+	buffer[length] = '\0';
+	file->Printf( "\"%s\"", buffer );
+}
+
+/*
+========================
+idTraceCapture::Start
+========================
+*/
+void idTraceCapture::Start( int maxEvents ) {
+	if ( capturing || maxEvents <= 0 ) {
+		return;
+	}
+
+	// the thread that starts the capture is normally the main thread
+	const uint32 threadId = Trace_ThreadId();
+	bool named = false;
+	for ( int i = 0; i < Min( traceNumThreads.GetValue(), MAX_TRACE_THREADS ); i++ ) {
+		if ( traceThreads[i].threadId == threadId ) {
+			named = true;
+			break;
+		}
+	}
+	if ( !named ) {
+		SetThreadName( "Main" );
+	}
+
+	traceEvents = (traceEvent_t *)Mem_Alloc( maxEvents * sizeof( traceEvent_t ), TAG_DEBUG );
+	traceMaxEvents = maxEvents;
+	traceNumEvents.SetValue( 0 );
+	traceStartTime = Sys_Microseconds();
+	capturing = true;
+}
+
+/*
+========================
+idTraceCapture::Stop
+========================
+*/
+bool idTraceCapture::Stop( const char * fileName ) {
+	if ( !capturing ) {
+		return false;
+	}
+	capturing = false;
+
+	// let any thread finish the event it is writing
+	while ( traceNumWriters.GetValue() > 0 ) {
+		Sys_Yield();
+	}
+
+	const int numEvents = Min( traceNumEvents.GetValue(), traceMaxEvents );
+	if ( traceNumEvents.GetValue() > traceMaxEvents ) {
+		idLib::Warning( "trace capture dropped %d events, increase the maximum number of events", traceNumEvents.GetValue() - traceMaxEvents );
+	}
+
+	idFile * file = idLib::fileSystem->OpenFileWrite( fileName );
+	if ( file == NULL ) {
+		idLib::Warning( "couldn't open %s for writing", fileName );
+		Mem_Free( traceEvents );
+		traceEvents = NULL;
+		return false;
+	}
+
+	file->Printf( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+	file->Printf( "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"" GAME_NAME "\"}}" );
+	for ( int i = 0; i < Min( traceNumThreads.GetValue(), MAX_TRACE_THREADS ); i++ ) {
+		file->Printf( ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", traceThreads[i].threadId );
+		Trace_WriteString( file, traceThreads[i].name );
+		file->Printf( "}}" );
+	}
+	for ( int i = 0; i < numEvents; i++ ) {
+		const traceEvent_t & event = traceEvents[i];
+		const double timeStamp = (double)(int64)( event.startTime - traceStartTime );
+		file->Printf( ",\n{\"name\":" );
+		Trace_WriteString( file, event.name );
+		if ( event.category != NULL ) {
+			file->Printf( ",\"cat\":" );
+			Trace_WriteString( file, event.category );
+			file->Printf( ",\"ph\":\"X\",\"ts\":%.0f,\"dur\":%u,\"pid\":0,\"tid\":%u}", timeStamp, event.duration, event.threadId );
+		} else {
+			file->Printf( ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.0f,\"pid\":0,\"tid\":%u}", timeStamp, event.threadId );
+		}
+	}
+	file->Printf( "\n]}\n" );
+
+	idLib::Printf( "wrote %d trace events to %s\n", numEvents, file->GetFullPath() );
+	idLib::fileSystem->CloseFile( file );
+
+	Mem_Free( traceEvents );
+	traceEvents = NULL;
+	return true;
+}
+
+/*
+========================
+idTraceCapture::AddEvent
+========================
+*/
+void idTraceCapture::AddEvent( const char * name, const char * category, uint64 startMicroSec, uint64 endMicroSec ) {
+	traceEvent_t * event = Trace_AllocEvent();
+	if ( event == NULL ) {
+		return;
+	}
+	idStr::Copynz( event->name, name, sizeof( event->name ) );
+	event->category = category;
+	event->startTime = startMicroSec;
+	event->duration = (uint32)( endMicroSec - startMicroSec );
+	event->threadId = Trace_ThreadId();
+	Trace_FinishEvent();
+}
+
+/*
+========================
+idTraceCapture::AddFrameMarker
+========================
+*/
+void idTraceCapture::AddFrameMarker( int frameNumber ) {
+	traceEvent_t * event = Trace_AllocEvent();
+	if ( event == NULL ) {
+		return;
+	}
+	idStr::snPrintf( event->name, sizeof( event->name ), "frame %d", frameNumber );
+	event->category = NULL;
+	event->startTime = Sys_Microseconds();
+	event->duration = 0;
+	event->threadId = Trace_ThreadId();
+	Trace_FinishEvent();
+}
+
+/*
+========================
+idTraceCapture::SetThreadName
+========================
+*/
+void idTraceCapture::SetThreadName( const char * name ) {
+	const int index = traceNumThreads.Increment() - 1;
+	if ( index >= MAX_TRACE_THREADS ) {
+		return;
+	}
+	idStr::Copynz( traceThreads[index].name, name, sizeof( traceThreads[index].name ) );
+	traceThreads[index].threadId = Trace_ThreadId();
+}
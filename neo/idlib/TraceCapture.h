@@ -0,0 +1,61 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").  
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __TRACECAPTURE_H__
+#define __TRACECAPTURE_H__
+
+/*
+================================================
+idTraceCapture records timed events from all threads into a fixed size
+buffer and writes them out as a Chrome trace event JSON file, which can
+be viewed with chrome://tracing or Perfetto.
+
+Recording an event is lock free and only costs a branch when no capture
+is running. Event names are copied so they don't have to outlive the
+capture.
+================================================
+*/
+class idTraceCapture {
+public:
+	static void			Start( int maxEvents );
+	// Stops recording and writes all recorded events to the given file.
+	static bool			Stop( const char * fileName );
+	static bool			IsCapturing() { return capturing; }
+
+	// Records an event on the calling thread with Sys_Microseconds() start and end times.
+	static void			AddEvent( const char * name, const char * category, uint64 startMicroSec, uint64 endMicroSec );
+	// Records a marker that spans all threads.
+	static void			AddFrameMarker( int frameNumber );
+	// Names the calling thread in the trace. Threads keep their name across captures.
+	static void			SetThreadName( const char * name );
+
+private:
+	static volatile bool	capturing;
+};
+
+#endif // !__TRACECAPTURE_H__
@@ -119,11 +119,15 @@ void idSIMD::Shutdown() {
 #define BIG_COUNT	COUNT*5		// Some tests need a larger count
 #define NUMTESTS	2048		// number of tests
 
+// data counts the tests are run with, small counts catch the edge cases of the SIMD loops
+static const int testCounts[] = { 1, 3, 16, 130, COUNT, BIG_COUNT };
+
 #define RANDOM_SEED		1013904223L	//((int)idLib::sys->GetClockTicks())
 
 idSIMDProcessor *p_simd;
 idSIMDProcessor *p_generic;
 int baseClocks = 0;
+int numFailedTests = 0;
 
 
 #define TIME_TYPE int
@@ -153,7 +157,7 @@ void PrintClocks( char *string, int dataCount, int clocks, int otherClocks = 0 )
 	int i;
 
 	idLib::common->Printf( string );
-	for ( i = idStr::LengthWithoutColors(string); i < 48; i++ ) {
+	for ( i = idStr::LengthWithoutColors(string); i < 56; i++ ) {
 		idLib::common->Printf(" ");
 	}
 	clocks -= baseClocks;
@@ -183,19 +187,32 @@ void GetBaseClocks() {
 	baseClocks = bestClocks;
 }
 
+/*
+============
+TestResult
+============
+*/
+const char *TestResult( bool ok ) {
+	if ( !ok ) {
+		numFailedTests++;
+		return S_COLOR_RED"X";
+	}
+	return "ok";
+}
+
 /*
 ============
 TestMinMax
 ============
 */
-void TestMinMax() {
+void TestMinMax( const int count ) {
 	int i;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	ALIGN16( float fsrc0[COUNT] );
-	ALIGN16( idVec2 v2src0[COUNT] );
-	ALIGN16( idVec3 v3src0[COUNT] );
-	ALIGN16( idDrawVert drawVerts[COUNT] );
-	ALIGN16( triIndex_t indexes[COUNT] );
+	idTempArray< float > fsrc0( count );
+	idTempArray< idVec2 > v2src0( count );
+	idTempArray< idVec3 > v3src0( count );
+	idTempArray< idDrawVert > drawVerts( count );
+	idTempArray< triIndex_t > indexes( count );
 	float min = 0.0f, max = 0.0f, min2 = 0.0f, max2 = 0.0f;
 	idVec2 v2min, v2max, v2min2, v2max2;
 	idVec3 vmin, vmax, vmin2, vmax2;
@@ -203,7 +220,7 @@ void TestMinMax() {
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		fsrc0[i] = srnd.CRandomFloat() * 10.0f;
 		v2src0[i][0] = srnd.CRandomFloat() * 10.0f;
 		v2src0[i][1] = srnd.CRandomFloat() * 10.0f;
@@ -221,102 +238,102 @@ void TestMinMax() {
 		min = idMath::INFINITY;
 		max = -idMath::INFINITY;
 		StartRecordTime( start );
-		p_generic->MinMax( min, max, fsrc0, COUNT );
+		p_generic->MinMax( min, max, fsrc0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->MinMax( float[] )", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->MinMax( float[] )", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->MinMax( min2, max2, fsrc0, COUNT );
+		p_simd->MinMax( min2, max2, fsrc0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	result = ( min == min2 && max == max2 ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->MinMax( float[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( min == min2 && max == max2 );
+	PrintClocks( va( "   simd->MinMax( float[] ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->MinMax( v2min, v2max, v2src0, COUNT );
+		p_generic->MinMax( v2min, v2max, v2src0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->MinMax( idVec2[] )", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->MinMax( idVec2[] )", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->MinMax( v2min2, v2max2, v2src0, COUNT );
+		p_simd->MinMax( v2min2, v2max2, v2src0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	result = ( v2min == v2min2 && v2max == v2max2 ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->MinMax( idVec2[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( v2min == v2min2 && v2max == v2max2 );
+	PrintClocks( va( "   simd->MinMax( idVec2[] ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->MinMax( vmin, vmax, v3src0, COUNT );
+		p_generic->MinMax( vmin, vmax, v3src0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->MinMax( idVec3[] )", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->MinMax( idVec3[] )", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->MinMax( vmin2, vmax2, v3src0, COUNT );
+		p_simd->MinMax( vmin2, vmax2, v3src0.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->MinMax( idVec3[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( vmin == vmin2 && vmax == vmax2 );
+	PrintClocks( va( "   simd->MinMax( idVec3[] ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->MinMax( vmin, vmax, drawVerts, COUNT );
+		p_generic->MinMax( vmin, vmax, drawVerts.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->MinMax( idDrawVert[] )", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->MinMax( idDrawVert[] )", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->MinMax( vmin2, vmax2, drawVerts, COUNT );
+		p_simd->MinMax( vmin2, vmax2, drawVerts.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->MinMax( idDrawVert[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( vmin == vmin2 && vmax == vmax2 );
+	PrintClocks( va( "   simd->MinMax( idDrawVert[] ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->MinMax( vmin, vmax, drawVerts, indexes, COUNT );
+		p_generic->MinMax( vmin, vmax, drawVerts.Ptr(), indexes.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->MinMax( idDrawVert[], indexes[] )", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->MinMax( idDrawVert[], indexes[] )", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->MinMax( vmin2, vmax2, drawVerts, indexes, COUNT );
+		p_simd->MinMax( vmin2, vmax2, drawVerts.Ptr(), indexes.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->MinMax( idDrawVert[], indexes[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( vmin == vmin2 && vmax == vmax2 );
+	PrintClocks( va( "   simd->MinMax( idDrawVert[], indexes[] ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -324,20 +341,20 @@ void TestMinMax() {
 TestBlendJoints
 ============
 */
-void TestBlendJoints() {
+void TestBlendJoints( const int count ) {
 	int i, j;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointQuat > baseJoints( COUNT );
-	idTempArray< idJointQuat > joints1( COUNT );
-	idTempArray< idJointQuat > joints2( COUNT );
-	idTempArray< idJointQuat > blendJoints( COUNT );
-	idTempArray< int > index( COUNT );
+	idTempArray< idJointQuat > baseJoints( count );
+	idTempArray< idJointQuat > joints1( count );
+	idTempArray< idJointQuat > joints2( count );
+	idTempArray< idJointQuat > blendJoints( count );
+	idTempArray< int > index( count );
 	float lerp = 0.3f;
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -360,28 +377,28 @@ void TestBlendJoints() {
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j < COUNT; j++ ) {
+		for ( j = 0; j < count; j++ ) {
 			joints1[j] = baseJoints[j];
 		}
 		StartRecordTime( start );
-		p_generic->BlendJoints( joints1.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), COUNT );
+		p_generic->BlendJoints( joints1.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->BlendJoints()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->BlendJoints()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j < COUNT; j++ ) {
+		for ( j = 0; j < count; j++ ) {
 			joints2[j] = baseJoints[j];
 		}
 		StartRecordTime( start );
-		p_simd->BlendJoints( joints2.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), COUNT );
+		p_simd->BlendJoints( joints2.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		if ( !joints1[i].t.Compare( joints2[i].t, 1e-3f ) ) {
 			break;
 		}
@@ -389,29 +406,29 @@ void TestBlendJoints() {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->BlendJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->BlendJoints() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
 ============
-TestBlendJoints
+TestBlendJointsFast
 ============
 */
-void TestBlendJointsFast() {
+void TestBlendJointsFast( const int count ) {
 	int i, j;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointQuat > baseJoints( COUNT );
-	idTempArray< idJointQuat > joints1( COUNT );
-	idTempArray< idJointQuat > joints2( COUNT );
-	idTempArray< idJointQuat > blendJoints( COUNT );
-	idTempArray< int > index( COUNT );
+	idTempArray< idJointQuat > baseJoints( count );
+	idTempArray< idJointQuat > joints1( count );
+	idTempArray< idJointQuat > joints2( count );
+	idTempArray< idJointQuat > blendJoints( count );
+	idTempArray< int > index( count );
 	float lerp = 0.3f;
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -434,28 +451,28 @@ void TestBlendJointsFast() {
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j < COUNT; j++ ) {
+		for ( j = 0; j < count; j++ ) {
 			joints1[j] = baseJoints[j];
 		}
 		StartRecordTime( start );
-		p_generic->BlendJointsFast( joints1.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), COUNT );
+		p_generic->BlendJointsFast( joints1.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->BlendJointsFast()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->BlendJointsFast()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j < COUNT; j++ ) {
+		for ( j = 0; j < count; j++ ) {
 			joints2[j] = baseJoints[j];
 		}
 		StartRecordTime( start );
-		p_simd->BlendJointsFast( joints2.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), COUNT );
+		p_simd->BlendJointsFast( joints2.Ptr(), blendJoints.Ptr(), lerp, index.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		if ( !joints1[i].t.Compare( joints2[i].t, 1e-3f ) ) {
 			break;
 		}
@@ -463,8 +480,8 @@ void TestBlendJointsFast() {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->BlendJointsFast() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->BlendJointsFast() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -472,17 +489,17 @@ void TestBlendJointsFast() {
 TestConvertJointQuatsToJointMats
 ============
 */
-void TestConvertJointQuatsToJointMats() {
+void TestConvertJointQuatsToJointMats( const int count ) {
 	int i;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointQuat > baseJoints( COUNT );
-	idTempArray< idJointMat > joints1( COUNT );
-	idTempArray< idJointMat > joints2( COUNT );
+	idTempArray< idJointQuat > baseJoints( count );
+	idTempArray< idJointMat > joints1( count );
+	idTempArray< idJointMat > joints2( count );
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -496,27 +513,27 @@ void TestConvertJointQuatsToJointMats() {
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->ConvertJointQuatsToJointMats( joints1.Ptr(), baseJoints.Ptr(), COUNT );
+		p_generic->ConvertJointQuatsToJointMats( joints1.Ptr(), baseJoints.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->ConvertJointQuatsToJointMats()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->ConvertJointQuatsToJointMats()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->ConvertJointQuatsToJointMats( joints2.Ptr(), baseJoints.Ptr(), COUNT );
+		p_simd->ConvertJointQuatsToJointMats( joints2.Ptr(), baseJoints.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		if ( !joints1[i].Compare( joints2[i], 1e-4f ) ) {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->ConvertJointQuatsToJointMats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->ConvertJointQuatsToJointMats() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -524,17 +541,17 @@ void TestConvertJointQuatsToJointMats() {
 TestConvertJointMatsToJointQuats
 ============
 */
-void TestConvertJointMatsToJointQuats() {
+void TestConvertJointMatsToJointQuats( const int count ) {
 	int i;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointMat > baseJoints( COUNT );
-	idTempArray< idJointQuat > joints1( COUNT );
-	idTempArray< idJointQuat > joints2( COUNT );
+	idTempArray< idJointMat > baseJoints( count );
+	idTempArray< idJointQuat > joints1( count );
+	idTempArray< idJointQuat > joints2( count );
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -550,21 +567,21 @@ void TestConvertJointMatsToJointQuats() {
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_generic->ConvertJointMatsToJointQuats( joints1.Ptr(), baseJoints.Ptr(), COUNT );
+		p_generic->ConvertJointMatsToJointQuats( joints1.Ptr(), baseJoints.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->ConvertJointMatsToJointQuats()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->ConvertJointMatsToJointQuats()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
 		StartRecordTime( start );
-		p_simd->ConvertJointMatsToJointQuats( joints2.Ptr(), baseJoints.Ptr(), COUNT );
+		p_simd->ConvertJointMatsToJointQuats( joints2.Ptr(), baseJoints.Ptr(), count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 0; i < COUNT; i++ ) {
+	for ( i = 0; i < count; i++ ) {
 		if ( !joints1[i].q.Compare( joints2[i].q, 1e-4f ) ) {
 			break;
 		}
@@ -572,8 +589,8 @@ void TestConvertJointMatsToJointQuats() {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->ConvertJointMatsToJointQuats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->ConvertJointMatsToJointQuats() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -581,18 +598,18 @@ void TestConvertJointMatsToJointQuats() {
 TestTransformJoints
 ============
 */
-void TestTransformJoints() {
+void TestTransformJoints( const int count ) {
 	int i, j;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointMat > joints( COUNT+1 );
-	idTempArray< idJointMat > joints1( COUNT+1 );
-	idTempArray< idJointMat > joints2( COUNT+1 );
-	idTempArray< int > parents( COUNT+1 );
+	idTempArray< idJointMat > joints( count+1 );
+	idTempArray< idJointMat > joints1( count+1 );
+	idTempArray< idJointMat > joints2( count+1 );
+	idTempArray< int > parents( count+1 );
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i <= COUNT; i++ ) {
+	for ( i = 0; i <= count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -608,34 +625,34 @@ void TestTransformJoints() {
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j <= COUNT; j++ ) {
+		for ( j = 0; j <= count; j++ ) {
 			joints1[j] = joints[j];
 		}
 		StartRecordTime( start );
-		p_generic->TransformJoints( joints1.Ptr(), parents.Ptr(), 1, COUNT );
+		p_generic->TransformJoints( joints1.Ptr(), parents.Ptr(), 1, count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->TransformJoints()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->TransformJoints()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j <= COUNT; j++ ) {
+		for ( j = 0; j <= count; j++ ) {
 			joints2[j] = joints[j];
 		}
 		StartRecordTime( start );
-		p_simd->TransformJoints( joints2.Ptr(), parents.Ptr(), 1, COUNT );
+		p_simd->TransformJoints( joints2.Ptr(), parents.Ptr(), 1, count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 1; i <= COUNT; i++ ) {
+	for ( i = 1; i <= count; i++ ) {
 		if ( !joints1[i].Compare( joints2[i], 1e-3f ) ) {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->TransformJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i > count );
+	PrintClocks( va( "   simd->TransformJoints() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -643,18 +660,18 @@ void TestTransformJoints() {
 TestUntransformJoints
 ============
 */
-void TestUntransformJoints() {
+void TestUntransformJoints( const int count ) {
 	int i, j;
 	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
-	idTempArray< idJointMat > joints( COUNT+1 );
-	idTempArray< idJointMat > joints1( COUNT+1 );
-	idTempArray< idJointMat > joints2( COUNT+1 );
-	idTempArray< int > parents( COUNT+1 );
+	idTempArray< idJointMat > joints( count+1 );
+	idTempArray< idJointMat > joints1( count+1 );
+	idTempArray< idJointMat > joints2( count+1 );
+	idTempArray< int > parents( count+1 );
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
 
-	for ( i = 0; i <= COUNT; i++ ) {
+	for ( i = 0; i <= count; i++ ) {
 		idAngles angles;
 		angles[0] = srnd.CRandomFloat() * 180.0f;
 		angles[1] = srnd.CRandomFloat() * 180.0f;
@@ -670,34 +687,543 @@ void TestUntransformJoints() {
 
 	bestClocksGeneric = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j <= COUNT; j++ ) {
+		for ( j = 0; j <= count; j++ ) {
 			joints1[j] = joints[j];
 		}
 		StartRecordTime( start );
-		p_generic->UntransformJoints( joints1.Ptr(), parents.Ptr(), 1, COUNT );
+		p_generic->UntransformJoints( joints1.Ptr(), parents.Ptr(), 1, count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksGeneric );
 	}
-	PrintClocks( "generic->UntransformJoints()", COUNT, bestClocksGeneric );
+	PrintClocks( "generic->UntransformJoints()", count, bestClocksGeneric );
 
 	bestClocksSIMD = 0;
 	for ( i = 0; i < NUMTESTS; i++ ) {
-		for ( j = 0; j <= COUNT; j++ ) {
+		for ( j = 0; j <= count; j++ ) {
 			joints2[j] = joints[j];
 		}
 		StartRecordTime( start );
-		p_simd->UntransformJoints( joints2.Ptr(), parents.Ptr(), 1, COUNT );
+		p_simd->UntransformJoints( joints2.Ptr(), parents.Ptr(), 1, count );
 		StopRecordTime( end );
 		GetBest( start, end, bestClocksSIMD );
 	}
 
-	for ( i = 1; i <= COUNT; i++ ) {
+	for ( i = 1; i <= count; i++ ) {
 		if ( !joints1[i].Compare( joints2[i], 1e-3f ) ) {
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
-	PrintClocks( va( "   simd->UntransformJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	result = TestResult( i > count );
+	PrintClocks( va( "   simd->UntransformJoints() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+GenericMultiply
+
+Reference versions of the idRenderMatrix functions that have SIMD paths.
+============
+*/
+void GenericMultiply( const idRenderMatrix & a, const idRenderMatrix & b, idRenderMatrix & out ) {
+	for ( int i = 0; i < 4; i++ ) {
+		for ( int j = 0; j < 4; j++ ) {
+			out[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+		}
+	}
+}
+
+/*
+============
+GenericTranspose
+============
+*/
+void GenericTranspose( const idRenderMatrix & src, idRenderMatrix & out ) {
+	for ( int i = 0; i < 4; i++ ) {
+		for ( int j = 0; j < 4; j++ ) {
+			out[i][j] = src[j][i];
+		}
+	}
+}
+
+/*
+============
+GenericOffsetScaleForBounds
+============
+*/
+void GenericOffsetScaleForBounds( const idRenderMatrix & src, const idBounds & bounds, idRenderMatrix & out ) {
+	const idVec3 offset = ( bounds[1] + bounds[0] ) * 0.5f;
+	const idVec3 scale = ( bounds[1] - bounds[0] ) * 0.5f;
+
+	for ( int i = 0; i < 4; i++ ) {
+		out[i][0] = src[i][0] * scale[0];
+		out[i][1] = src[i][1] * scale[1];
+		out[i][2] = src[i][2] * scale[2];
+		out[i][3] = src[i][3] + src[i][0] * offset[0] + src[i][1] * offset[1] + src[i][2] * offset[2];
+	}
+}
+
+/*
+============
+GenericCullBoundsToMVPbits
+============
+*/
+bool GenericCullBoundsToMVPbits( const idRenderMatrix & mvp, const idBounds & bounds, byte * outBits, bool zeroToOne ) {
+	int bits = 0;
+
+	idVec3 v;
+	for ( int x = 0; x < 2; x++ ) {
+		v[0] = bounds[x][0];
+		for ( int y = 0; y < 2; y++ ) {
+			v[1] = bounds[y][1];
+			for ( int z = 0; z < 2; z++ ) {
+				v[2] = bounds[z][2];
+
+				idVec4 c;
+				for ( int i = 0; i < 4; i++ ) {
+					c[i] = v[0] * mvp[i][0] + v[1] * mvp[i][1] + v[2] * mvp[i][2] + mvp[i][3];
+				}
+
+				const float minW = zeroToOne ? 0.0f : -c[3];
+				const float maxW = c[3];
+#if defined( CLIP_SPACE_D3D )
+				const float minZ = 0.0f;
+#else
+				const float minZ = minW;
+#endif
+
+				if ( c[0] > minW ) { bits |= ( 1 << 0 ); }
+				if ( c[0] < maxW ) { bits |= ( 1 << 1 ); }
+				if ( c[1] > minW ) { bits |= ( 1 << 2 ); }
+				if ( c[1] < maxW ) { bits |= ( 1 << 3 ); }
+				if ( c[2] > minZ ) { bits |= ( 1 << 4 ); }
+				if ( c[2] < maxW ) { bits |= ( 1 << 5 ); }
+			}
+		}
+	}
+
+	*outBits = (byte)( bits ^ 63 );
+
+	return ( bits != 63 );
+}
+
+/*
+============
+GenericProjectedBounds
+============
+*/
+void GenericProjectedBounds( idBounds & projected, const idRenderMatrix & mvp, const idBounds & bounds, bool windowSpace ) {
+	projected[0].Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
+	projected[1].Set( -idMath::INFINITY, -idMath::INFINITY, -idMath::INFINITY );
+
+	idVec3 v;
+	for ( int x = 0; x < 2; x++ ) {
+		v[0] = bounds[x][0];
+		for ( int y = 0; y < 2; y++ ) {
+			v[1] = bounds[y][1];
+			for ( int z = 0; z < 2; z++ ) {
+				v[2] = bounds[z][2];
+
+				idVec4 c;
+				for ( int i = 0; i < 4; i++ ) {
+					c[i] = v[0] * mvp[i][0] + v[1] * mvp[i][1] + v[2] * mvp[i][2] + mvp[i][3];
+				}
+
+				if ( c[3] <= idMath::FLT_SMALLEST_NON_DENORMAL ) {
+					// W=0 clipped so the bounds cover the full X-Y range
+					projected[0].Set( -idMath::INFINITY, -idMath::INFINITY, -idMath::INFINITY );
+					projected[1][0] = idMath::INFINITY;
+					projected[1][1] = idMath::INFINITY;
+					continue;
+				}
+
+				const float rw = 1.0f / c[3];
+				for ( int i = 0; i < 3; i++ ) {
+					projected[0][i] = Min( projected[0][i], c[i] * rw );
+					projected[1][i] = Max( projected[1][i], c[i] * rw );
+				}
+			}
+		}
+	}
+
+	if ( !windowSpace ) {
+		return;
+	}
+
+	// convert to window coords and clamp to the [0, 1] range
+	for ( int i = 0; i < 3; i++ ) {
+#if defined( CLIP_SPACE_D3D )
+		if ( i < 2 )
+#endif
+		{
+			projected[0][i] = projected[0][i] * 0.5f + 0.5f;
+			projected[1][i] = projected[1][i] * 0.5f + 0.5f;
+		}
+		projected[0][i] = idMath::ClampFloat( 0.0f, 1.0f, projected[0][i] );
+		projected[1][i] = idMath::ClampFloat( 0.0f, 1.0f, projected[1][i] );
+	}
+}
+
+/*
+============
+GenericDepthBoundsForBounds
+============
+*/
+void GenericDepthBoundsForBounds( float & min, float & max, const idRenderMatrix & mvp, const idBounds & bounds ) {
+	min = idMath::INFINITY;
+	max = -idMath::INFINITY;
+
+	idVec3 v;
+	for ( int x = 0; x < 2; x++ ) {
+		v[0] = bounds[x][0];
+		for ( int y = 0; y < 2; y++ ) {
+			v[1] = bounds[y][1];
+			for ( int z = 0; z < 2; z++ ) {
+				v[2] = bounds[z][2];
+
+				float tz = v[0] * mvp[2][0] + v[1] * mvp[2][1] + v[2] * mvp[2][2] + mvp[2][3];
+				float tw = v[0] * mvp[3][0] + v[1] * mvp[3][1] + v[2] * mvp[3][2] + mvp[3][3];
+
+				if ( tw > idMath::FLT_SMALLEST_NON_DENORMAL ) {
+					tz = tz / tw;
+				} else {
+					tz = -idMath::INFINITY;
+				}
+
+				min = Min( min, tz );
+				max = Max( max, tz );
+			}
+		}
+	}
+
+	// convert to window coords, the range is only clamped on the outside
+#if !defined( CLIP_SPACE_D3D )
+	min = min * 0.5f + 0.5f;
+	max = max * 0.5f + 0.5f;
+#endif
+	min = Max( min, 0.0f );
+	max = Min( max, 1.0f );
+}
+
+/*
+============
+CompareRelative
+
+Values projected close to the W=0 plane get very large, so they are compared relative to their size.
+============
+*/
+bool CompareRelative( const float a, const float b, const float epsilon ) {
+	return idMath::Fabs( a - b ) <= epsilon * Max( idMath::Fabs( a ), 1.0f );
+}
+
+/*
+============
+CompareRenderMatrix
+============
+*/
+bool CompareRenderMatrix( const idRenderMatrix & a, const idRenderMatrix & b, const float epsilon ) {
+	for ( int i = 0; i < 4; i++ ) {
+		for ( int j = 0; j < 4; j++ ) {
+			if ( idMath::Fabs( a[i][j] - b[i][j] ) > epsilon ) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+============
+TestRenderMatrix
+
+Times the idRenderMatrix functions that have SIMD paths against the reference versions above.
+The SIMD paths are selected at compile time so they are verified against the reference
+versions instead of against the generic processor.
+============
+*/
+void TestRenderMatrix( const int count ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< idRenderMatrix > models( count );
+	idTempArray< idRenderMatrix > mvps( count );
+	idTempArray< idRenderMatrix > results1( count );
+	idTempArray< idRenderMatrix > results2( count );
+	idTempArray< idBounds > bounds( count );
+	idTempArray< idBounds > projected1( count );
+	idTempArray< idBounds > projected2( count );
+	idTempArray< byte > bits1( count );
+	idTempArray< byte > bits2( count );
+	idTempArray< bool > culled1( count );
+	idTempArray< bool > culled2( count );
+	idTempArray< idVec2 > depth1( count );
+	idTempArray< idVec2 > depth2( count );
+	idRenderMatrix viewMatrix, projectionMatrix, viewProjection;
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	idRenderMatrix::CreateViewMatrix( vec3_origin, mat3_identity, viewMatrix );
+	idRenderMatrix::CreateProjectionMatrixFov( 90.0f, 73.74f, 3.0f, 0.0f, 0.0f, 0.0f, projectionMatrix );
+	GenericMultiply( projectionMatrix, viewMatrix, viewProjection );
+
+	// models are placed around the view so some bounds are culled, some are visible and some cross the near plane
+	for ( i = 0; i < count; i++ ) {
+		idAngles angles;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		idVec3 origin;
+		origin[0] = srnd.CRandomFloat() * 512.0f;
+		origin[1] = srnd.CRandomFloat() * 512.0f;
+		origin[2] = srnd.CRandomFloat() * 512.0f;
+		idRenderMatrix::CreateFromOriginAxis( origin, angles.ToMat3(), models[i] );
+		GenericMultiply( viewProjection, models[i], mvps[i] );
+		idVec3 size;
+		size[0] = 1.0f + srnd.RandomFloat() * 64.0f;
+		size[1] = 1.0f + srnd.RandomFloat() * 64.0f;
+		size[2] = 1.0f + srnd.RandomFloat() * 64.0f;
+		bounds[i][0] = -size;
+		bounds[i][1] = size;
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericMultiply( viewProjection, models[j], results1[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::Multiply()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::Multiply( viewProjection, models[j], results2[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( !CompareRenderMatrix( results1[i], results2[i], 1e-3f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::Multiply() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericTranspose( mvps[j], results1[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::Transpose()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::Transpose( mvps[j], results2[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( !CompareRenderMatrix( results1[i], results2[i], 0.0f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::Transpose() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::InverseByDoubles( models[j], results1[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::InverseByDoubles()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::Inverse( models[j], results2[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( !CompareRenderMatrix( results1[i], results2[i], 1e-2f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::Inverse() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericOffsetScaleForBounds( mvps[j], bounds[j], results1[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::OffsetScaleForBounds()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::OffsetScaleForBounds( mvps[j], bounds[j], results2[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( !CompareRenderMatrix( results1[i], results2[i], 1e-3f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::OffsetScaleForBounds() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			culled1[j] = GenericCullBoundsToMVPbits( mvps[j], bounds[j], &bits1[j], false );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::CullBoundsToMVPbits()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			culled2[j] = idRenderMatrix::CullBoundsToMVPbits( mvps[j], bounds[j], &bits2[j], false );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( culled1[i] != culled2[i] || bits1[i] != bits2[i] ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::CullBoundsToMVPbits() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericProjectedBounds( projected1[j], mvps[j], bounds[j], true );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::ProjectedBounds()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::ProjectedBounds( projected2[j], mvps[j], bounds[j], true );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( !projected1[i].Compare( projected2[i], 1e-3f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::ProjectedBounds() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericProjectedBounds( projected1[j], mvps[j], bounds[j], false );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::ProjectedBounds( clip )", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::ProjectedBounds( projected2[j], mvps[j], bounds[j], false );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	// NOTE: this is a known failure, the SSE path lets W=0 clipped corners count toward the
+	// maximum Z with their clip Z, which the window space clamp hides in the pass above
+	for ( i = 0; i < count; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			if ( !CompareRelative( projected1[i][0][j], projected2[i][0][j], 1e-3f ) || !CompareRelative( projected1[i][1][j], projected2[i][1][j], 1e-3f ) ) {
+				break;
+			}
+		}
+		if ( j < 3 ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::ProjectedBounds( clip ) %s", result ), count, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			GenericDepthBoundsForBounds( depth1[j].x, depth1[j].y, mvps[j], bounds[j] );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->idRenderMatrix::DepthBoundsForBounds()", count, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		for ( j = 0; j < count; j++ ) {
+			idRenderMatrix::DepthBoundsForBounds( depth2[j].x, depth2[j].y, mvps[j], bounds[j], true );
+		}
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	// the depth bounds are only clamped on the outside of the [0, 1] range
+	for ( i = 0; i < count; i++ ) {
+		if ( !CompareRelative( depth1[i].x, depth2[i].x, 1e-3f ) || !CompareRelative( depth1[i].y, depth2[i].y, 1e-3f ) ) {
+			break;
+		}
+	}
+	result = TestResult( i >= count );
+	PrintClocks( va( "   simd->idRenderMatrix::DepthBoundsForBounds() %s", result ), count, bestClocksSIMD, bestClocksGeneric );
 }
 
 /*
@@ -1114,20 +1640,37 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 
 	GetBaseClocks();
 
+	numFailedTests = 0;
+
 	TestMath();
-	TestMinMax();
 
-	idLib::common->Printf("====================================\n" );
+	for ( int i = 0; i < ARRAY_COUNT( testCounts ); i++ ) {
+		const int count = testCounts[i];
 
-	TestBlendJoints();
-	TestBlendJointsFast();
-	TestConvertJointQuatsToJointMats();
-	TestConvertJointMatsToJointQuats();
-	TestTransformJoints();
-	TestUntransformJoints();
+		TestMinMax( count );
+
+		idLib::common->Printf("====================================\n" );
+
+		TestBlendJoints( count );
+		TestBlendJointsFast( count );
+		TestConvertJointQuatsToJointMats( count );
+		TestConvertJointMatsToJointQuats( count );
+		TestTransformJoints( count );
+		TestUntransformJoints( count );
+
+		idLib::common->Printf("====================================\n" );
+
+		TestRenderMatrix( count );
+	}
 
 	idLib::common->Printf("====================================\n" );
 
+	if ( numFailedTests ) {
+		idLib::common->Printf( S_COLOR_RED"%d tests failed\n", numFailedTests );
+	} else {
+		idLib::common->Printf( "all tests passed\n" );
+	}
+
 	idLib::common->SetRefreshOnPrint( false );
 
 	if ( p_simd != processor ) {
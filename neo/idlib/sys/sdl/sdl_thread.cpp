@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "SDL_hints.h"
 #include "SDL_thread.h"
 #include "SDL_mutex.h"
+#include "SDL_timer.h"
 
 /*
 ================================================================================================
@@ -104,6 +105,8 @@ Sys_Yield
 ========================
 */
 void Sys_Yield() {
+	// give up the rest of the time slice to any other thread that is ready to run
+	SDL_Delay( 0 );
 }
 
 /*
@@ -264,3 +267,21 @@ Sys_InterlockedSub
 interlockedInt_t Sys_InterlockedSub( interlockedInt_t & value, interlockedInt_t i ) {
 	return SDL_AtomicAdd( (SDL_atomic_t *) & value, -i ) - i;
 }
+
+/*
+========================
+Sys_InterlockedCompareExchange
+========================
+*/
+interlockedInt_t Sys_InterlockedCompareExchange( interlockedInt_t & value, interlockedInt_t comparand, interlockedInt_t exchange ) {
+	for ( ; ; ) {
+		if ( SDL_AtomicCAS( (SDL_atomic_t *) & value, comparand, exchange ) ) {
+			return comparand;
+		}
+		// the exchange failed, report the value that caused it unless it changed back in the meantime
+		const interlockedInt_t current = SDL_AtomicGet( (SDL_atomic_t *) & value );
+		if ( current != comparand ) {
+			return current;
+		}
+	}
+}
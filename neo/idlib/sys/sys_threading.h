@@ -102,6 +102,9 @@ interlockedInt_t	Sys_InterlockedDecrement( interlockedInt_t & value );
 interlockedInt_t	Sys_InterlockedAdd( interlockedInt_t & value, interlockedInt_t i );
 interlockedInt_t	Sys_InterlockedSub( interlockedInt_t & value, interlockedInt_t i );
 
+// sets value to exchange if it equals comparand, returns the original value
+interlockedInt_t	Sys_InterlockedCompareExchange( interlockedInt_t & value, interlockedInt_t comparand, interlockedInt_t exchange );
+
 void				Sys_Yield();
 
 const int MAX_CRITICAL_SECTIONS		= 4;
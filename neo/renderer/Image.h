@@ -115,6 +115,11 @@ public:
 	void		SetReferencedOutsideLevelLoad() { referencedOutsideLevelLoad = true; }
 	void		SetReferencedInsideLevelLoad() { levelLoadReferenced = true; }
 	void		ActuallyLoadImage( bool fromBackEnd );
+
+	// the stages of ActuallyLoadImage, only LoadGeneratedImage may be run outside the main thread
+	void		StartLoad( idBinaryImage & im );
+	void		LoadGeneratedImage( idBinaryImage & im );
+	void		FinishLoad( idBinaryImage & im );
 	//---------------------------------------------
 	// Platform specific implementations
 	//---------------------------------------------
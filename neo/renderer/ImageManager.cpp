@@ -38,6 +38,24 @@ idImageManager	imageManager;
 idImageManager * globalImages = &imageManager;
 
 idCVar preLoad_Images( "preLoad_Images", "1", CVAR_SYSTEM | CVAR_BOOL, "preload images during beginlevelload" );
+idCVar image_parallelLoad( "image_parallelLoad", "1", CVAR_RENDERER | CVAR_BOOL, "read the generated images on the job threads while uploading on the main thread" );
+idCVar image_parallelLoadBatch( "image_parallelLoadBatch", "32", CVAR_RENDERER | CVAR_INTEGER, "number of images read ahead per batch by image_parallelLoad", 1, 256 );
+
+struct imageLoadJob_t {
+	idImage *			image;
+	idBinaryImage *		binaryImage;
+};
+
+/*
+===============
+R_LoadGeneratedImageJob
+===============
+*/
+static void R_LoadGeneratedImageJob( imageLoadJob_t * job ) {
+	job->image->LoadGeneratedImage( *job->binaryImage );
+}
+
+REGISTER_PARALLEL_JOB( R_LoadGeneratedImageJob, "R_LoadGeneratedImageJob" );
 
 /*
 ===============
@@ -752,7 +770,6 @@ void idImageManager::Preload( const idPreloadManifest &manifest, const bool & ma
 		int	start = Sys_Milliseconds();
 		int numLoaded = 0;
 
-		//fileSystem->StartPreload( preloadImageFiles );
 		for ( int i = 0; i < manifest.NumResources(); i++ ) {
 			const preloadEntry_s & p = manifest.GetPreloadByIndex( i );
 			if ( p.resType == PRELOAD_IMAGE && !ExcludePreloadImage( p.resourceName ) ) {
@@ -760,7 +777,6 @@ void idImageManager::Preload( const idPreloadManifest &manifest, const bool & ma
 				numLoaded++;
 			}
 		}
-		//fileSystem->StopPreload();
 		int	end = Sys_Milliseconds();
 		common->Printf( "%05d images preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
 		common->Printf( "----------------------------------------\n" );
@@ -774,23 +790,79 @@ idImageManager::LoadLevelImages
 ===============
 */
 int idImageManager::LoadLevelImages( bool pacifier ) {
-	int	loadCount = 0;
-	for ( int i = 0 ; i < images.Num() ; i++ ) {
-		if ( pacifier ) {
-			common->UpdateLevelLoadPacifier();
+	if ( !image_parallelLoad.GetBool() || !R_IsInitialized() || cvarSystem->GetCVarBool( "fs_buildresources" ) ) {
+		int	loadCount = 0;
+		for ( int i = 0 ; i < images.Num() ; i++ ) {
+			if ( pacifier ) {
+				common->UpdateLevelLoadPacifier();
+
+			}
 
+			idImage	*image = images[ i ];
+			if ( image->generatorFunction ) {
+				continue;
+			}
+			if ( image->levelLoadReferenced && !image->IsLoaded() ) {
+				loadCount++;
+				image->ActuallyLoadImage( false );
+			}
 		}
+		return loadCount;
+	}
 
+	// the binary images are read and parsed on the job threads one batch ahead
+	// of the main thread, which regenerates out of date images and does the uploads
+	idList< imageLoadJob_t, TAG_IMAGE > loads;
+	for ( int i = 0 ; i < images.Num() ; i++ ) {
 		idImage	*image = images[ i ];
 		if ( image->generatorFunction ) {
 			continue;
 		}
 		if ( image->levelLoadReferenced && !image->IsLoaded() ) {
-			loadCount++;
-			image->ActuallyLoadImage( false );
+			imageLoadJob_t & load = loads.Alloc();
+			load.image = image;
+			load.binaryImage = new (TAG_IMAGE) idBinaryImage( image->GetName() );
+			image->StartLoad( *load.binaryImage );
+		}
+	}
+
+	const int batchSize = image_parallelLoadBatch.GetInteger();
+	idParallelJobList * jobLists[2];
+	jobLists[0] = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batchSize, 0, NULL );
+	jobLists[1] = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batchSize, 0, NULL );
+
+	for ( int start = 0, batch = 0; start < loads.Num(); start += batchSize, batch ^= 1 ) {
+		// kick off the first batch, the following batches are submitted before waiting on the current one
+		if ( start == 0 ) {
+			for ( int i = 0; i < batchSize && i < loads.Num(); i++ ) {
+				jobLists[batch]->AddJob( (jobRun_t)R_LoadGeneratedImageJob, &loads[i] );
+			}
+			jobLists[batch]->Submit( NULL, JOBLIST_PARALLELISM_MAX_THREADS );
+		}
+		const int next = start + batchSize;
+		for ( int i = next; i < next + batchSize && i < loads.Num(); i++ ) {
+			jobLists[batch ^ 1]->AddJob( (jobRun_t)R_LoadGeneratedImageJob, &loads[i] );
+		}
+		if ( next < loads.Num() ) {
+			jobLists[batch ^ 1]->Submit( NULL, JOBLIST_PARALLELISM_MAX_THREADS );
+		}
+
+		jobLists[batch]->Wait();
+
+		for ( int i = start; i < next && i < loads.Num(); i++ ) {
+			if ( pacifier ) {
+				common->UpdateLevelLoadPacifier();
+			}
+			loads[i].image->FinishLoad( *loads[i].binaryImage );
+			delete loads[i].binaryImage;
+			loads[i].binaryImage = NULL;
 		}
 	}
-	return loadCount;
+
+	parallelJobManager->FreeJobList( jobLists[0] );
+	parallelJobManager->FreeJobList( jobLists[1] );
+
+	return loads.Num();
 }
 
 /*
@@ -276,6 +276,20 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 		return;
 	}
 
+	idBinaryImage im( GetName() );
+	StartLoad( im );
+	LoadGeneratedImage( im );
+	FinishLoad( im );
+}
+
+/*
+===============
+idImage::StartLoad
+
+Determines the options and the name of the generated binary image.
+===============
+*/
+void idImage::StartLoad( idBinaryImage & im ) {
 	if ( com_productionMode.GetInteger() != 0 ) {
 		sourceFileTime = FILE_NOT_FOUND_TIMESTAMP;
 		if ( cubeFiles != CF_2D ) {
@@ -299,7 +313,20 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 	idStrStatic< MAX_OSPATH > generatedName = GetName();
 	GetGeneratedName( generatedName, usage, cubeFiles );
 
-	idBinaryImage im( generatedName );
+	im.SetName( generatedName );
+}
+
+/*
+===============
+idImage::LoadGeneratedImage
+
+Reads the generated binary image. This only touches this image and the
+file system, so it can be run from any thread for different images.
+===============
+*/
+void idImage::LoadGeneratedImage( idBinaryImage & im ) {
+	idStrStatic< MAX_OSPATH > generatedName = im.GetName();
+
 	binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
 
 	// BFHACK, do not want to tweak on buildgame so catch these images here
@@ -338,6 +365,19 @@ void idImage::ActuallyLoadImage( bool fromBackEnd ) {
 			}
 		}
 	}
+}
+
+/*
+===============
+idImage::FinishLoad
+
+Creates the generated binary image if it was missing or out of date and
+uploads it.
+===============
+*/
+void idImage::FinishLoad( idBinaryImage & im ) {
+	idStrStatic< MAX_OSPATH > generatedName = im.GetName();
+
 	const bimageFile_t & header = im.GetFileHeader();
 
 	if ( ( fileSystem->InProductionMode() && binaryFileTime != FILE_NOT_FOUND_TIMESTAMP ) || ( ( binaryFileTime != FILE_NOT_FOUND_TIMESTAMP )
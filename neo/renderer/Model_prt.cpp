@@ -34,6 +34,79 @@ If you have questions concerning this license or the applicable additional terms
 
 static const char *parametricParticle_SnapshotName = "_ParametricParticle_Snapshot_";
 
+extern idCVar r_useParallelAddModels;
+
+idCVar r_particleJobMinParticles( "r_particleJobMinParticles", "0", CVAR_RENDERER | CVAR_INTEGER, "split particle stages with at least this many live particles over jobs when the models aren't added in parallel, 0 = never" );
+
+static const int MAX_PARTICLE_JOBS = 16;
+
+typedef struct {
+	const idParticleStage *	stage;
+	const particleGen_t *	gen;
+	const particleSpawn_t *	spawns;
+	int						numSpawns;
+	idDrawVert *			verts;
+	int						numVerts;
+} particleJob_t;
+
+/*
+====================
+ParticleJob
+====================
+*/
+static void ParticleJob( particleJob_t *job ) {
+	job->numVerts = job->stage->CreateParticles( job->gen, job->spawns, job->numSpawns, job->verts );
+}
+
+REGISTER_PARALLEL_JOB( ParticleJob, "ParticleJob" );
+
+/*
+====================
+R_CreateParticles
+
+Big stages are split over the front end job list when it isn't already
+running the models in parallel, the jobs write to their own range of the
+verts which are packed together afterwards.
+====================
+*/
+static int R_CreateParticles( const idParticleStage *stage, const particleGen_t *g, const particleSpawn_t *spawns, int numSpawns, idDrawVert *verts ) {
+	const int minParticles = r_particleJobMinParticles.GetInteger();
+	if ( minParticles <= 0 || numSpawns < minParticles || r_useParallelAddModels.GetBool() ) {
+		return stage->CreateParticles( g, spawns, numSpawns, verts );
+	}
+
+	const int numJobs = Min( Min( numSpawns / minParticles, parallelJobManager->GetNumProcessingUnits() ), MAX_PARTICLE_JOBS );
+	if ( numJobs <= 1 ) {
+		return stage->CreateParticles( g, spawns, numSpawns, verts );
+	}
+
+	const int spawnsPerJob = ( numSpawns + numJobs - 1 ) / numJobs;
+	const int vertsPerParticle = 4 * stage->NumQuadsPerParticle();
+	particleJob_t jobs[MAX_PARTICLE_JOBS];
+
+	int numSubmitted = 0;
+	for ( int first = 0; first < numSpawns; first += spawnsPerJob, numSubmitted++ ) {
+		particleJob_t &job = jobs[numSubmitted];
+		job.stage = stage;
+		job.gen = g;
+		job.spawns = spawns + first;
+		job.numSpawns = Min( spawnsPerJob, numSpawns - first );
+		job.verts = verts + first * vertsPerParticle;
+		job.numVerts = 0;
+		tr.frontEndJobList->AddJob( (jobRun_t)ParticleJob, &job );
+	}
+	tr.frontEndJobList->Submit();
+	tr.frontEndJobList->Wait();
+
+	// pack the verts of the particles that were not faded out
+	int numVerts = jobs[0].numVerts;
+	for ( int i = 1; i < numSubmitted; i++ ) {
+		memmove( verts + numVerts, jobs[i].verts, jobs[i].numVerts * sizeof( verts[0] ) );
+		numVerts += jobs[i].numVerts;
+	}
+	return numVerts;
+}
+
 /*
 ====================
 idRenderModelPrt::idRenderModelPrt
@@ -155,12 +228,10 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 			R_AllocStaticTriSurfIndexes( surf->geometry, 6 * count );
 		}
 
-		int numVerts = 0;
-		idDrawVert *verts = surf->geometry->verts;
+		particleSpawn_t *spawns = (particleSpawn_t *)R_FrameAlloc( stage->totalParticles * sizeof( spawns[0] ) );
+		int numSpawns = 0;
 
 		for ( int index = 0; index < stage->totalParticles; index++ ) {
-			g.index = index;
-
 			// bump the random
 			steppingRandom.RandomInt();
 			steppingRandom2.RandomInt();
@@ -179,12 +250,6 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 				continue;
 			}
 
-			if ( particleCycle == stageCycle ) {
-				g.random = steppingRandom;
-			} else {
-				g.random = steppingRandom2;
-			}
-
 			int	inCycleTime = particleAge - particleCycle * stage->cycleMsec;
 
 			if ( renderEntity->shaderParms[SHADERPARM_PARTICLE_STOPTIME] && 
@@ -194,25 +259,27 @@ idRenderModel *idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 			}
 
 			// supress particles before or after the age clamp
-			g.frac = (float)inCycleTime / ( stage->particleLife * 1000 );
-			if ( g.frac < 0.0f ) {
+			float frac = (float)inCycleTime / ( stage->particleLife * 1000 );
+			if ( frac < 0.0f ) {
 				// yet to be spawned
 				continue;
 			}
-			if ( g.frac > 1.0f ) {
+			if ( frac > 1.0f ) {
 				// this particle is in the deadTime band
 				continue;
 			}
 
-			// this is needed so aimed particles can calculate origins at different times
-			g.originalRandom = g.random;
-
-			g.age = g.frac * stage->particleLife;
-
-			// if the particle doesn't get drawn because it is faded out or beyond a kill region, don't increment the verts
-			numVerts += stage->CreateParticle( &g, verts + numVerts );
+			particleSpawn_t &spawn = spawns[numSpawns++];
+			spawn.index = index;
+			spawn.frac = frac;
+			spawn.random = ( particleCycle == stageCycle ) ? steppingRandom : steppingRandom2;
+			spawn.origin = NULL;
+			spawn.axis = NULL;
 		}
 
+		// if a particle doesn't get drawn because it is faded out or beyond a kill region, it doesn't add verts
+		int numVerts = R_CreateParticles( stage, &g, spawns, numSpawns, surf->geometry->verts );
+
 		// numVerts must be a multiple of 4
 		assert( ( numVerts & 3 ) == 0 && numVerts <= 4 * count );
 
@@ -285,3 +352,122 @@ int idRenderModelPrt::Memory() const {
 
 	return total;
 }
+
+/*
+====================
+R_TestParticles_f
+
+Creates every stage of the given particle systems, or of all of them, both
+in batches and one particle at a time, in every orientation, and compares
+the verts.
+
+testParticles [particle]
+====================
+*/
+void R_TestParticles_f( const idCmdArgs &args ) {
+	static const char * orientationNames[] = { "view", "aimed", "x", "y", "z" };
+
+	// an entity and view that are not axis aligned so the view oriented particles go through the projection
+	renderEntity_t renderEntity;
+	memset( &renderEntity, 0, sizeof( renderEntity ) );
+	renderEntity.axis = idAngles( 10.0f, 20.0f, 30.0f ).ToMat3();
+	for ( int i = 0; i < MAX_ENTITY_SHADER_PARMS; i++ ) {
+		renderEntity.shaderParms[i] = 0.75f;
+	}
+	renderView_t renderView;
+	memset( &renderView, 0, sizeof( renderView ) );
+	renderView.viewaxis = idAngles( -15.0f, 135.0f, 5.0f ).ToMat3();
+
+	particleGen_t gen;
+	gen.renderEnt = &renderEntity;
+	gen.renderView = &renderView;
+	gen.origin.Set( 100.0f, -50.0f, 25.0f );
+	gen.axis = idAngles( 0.0f, 45.0f, 0.0f ).ToMat3();
+
+	idList< particleSpawn_t, TAG_RENDER > spawns;
+	idList< idDrawVert, TAG_RENDER > batchVerts;
+	idList< idDrawVert, TAG_RENDER > singleVerts;
+
+	int numStages = 0;
+	int numFailed = 0;
+
+	const int numDecls = declManager->GetNumDecls( DECL_PARTICLE );
+	for ( int declNum = 0; declNum < numDecls; declNum++ ) {
+		const idDeclParticle * particleSystem = static_cast< const idDeclParticle * >( declManager->DeclByIndex( DECL_PARTICLE, declNum ) );
+		if ( args.Argc() > 1 && idStr::Icmp( particleSystem->GetName(), args.Argv( 1 ) ) != 0 ) {
+			continue;
+		}
+
+		for ( int stageNum = 0; stageNum < particleSystem->stages.Num(); stageNum++ ) {
+			idParticleStage * stage = particleSystem->stages[stageNum];
+			if ( stage->totalParticles <= 0 ) {
+				continue;
+			}
+
+			// spread the particles over their whole life
+			spawns.SetNum( stage->totalParticles );
+			for ( int i = 0; i < spawns.Num(); i++ ) {
+				spawns[i].index = i;
+				spawns[i].frac = ( i + 0.5f ) / spawns.Num();
+				spawns[i].random.SetSeed( i * 1234 + stageNum );
+				spawns[i].origin = NULL;
+				spawns[i].axis = NULL;
+			}
+
+			const int maxVerts = spawns.Num() * 4 * stage->NumQuadsPerParticle();
+			batchVerts.SetNum( maxVerts );
+			singleVerts.SetNum( maxVerts );
+
+			// the orientation is only changed on the stage for the test and restored afterwards
+			const prtOrientation_t orientation = stage->orientation;
+			for ( int testOrientation = POR_VIEW; testOrientation <= POR_Z; testOrientation++ ) {
+				stage->orientation = (prtOrientation_t)testOrientation;
+
+				memset( batchVerts.Ptr(), 0, maxVerts * sizeof( idDrawVert ) );
+				memset( singleVerts.Ptr(), 0, maxVerts * sizeof( idDrawVert ) );
+
+				const int numBatchVerts = stage->CreateParticles( &gen, spawns.Ptr(), spawns.Num(), batchVerts.Ptr() );
+
+				int numSingleVerts = 0;
+				for ( int i = 0; i < spawns.Num(); i++ ) {
+					particleGen_t g = gen;
+					g.index = spawns[i].index;
+					g.frac = spawns[i].frac;
+					g.random = spawns[i].random;
+					g.originalRandom = spawns[i].random;
+					g.age = spawns[i].frac * stage->particleLife;
+					numSingleVerts += stage->CreateParticle( &g, singleVerts.Ptr() + numSingleVerts );
+				}
+
+				int firstBad = -1;
+				if ( numBatchVerts != numSingleVerts ) {
+					firstBad = Min( numBatchVerts, numSingleVerts );
+				} else {
+					for ( int i = 0; i < numBatchVerts; i++ ) {
+						const idDrawVert & a = batchVerts[i];
+						const idDrawVert & b = singleVerts[i];
+						// the quad corners are evaluated with a different order of operations
+						const float epsilon = 0.001f * Max( 1.0f, b.xyz.LengthFast() );
+						if ( !a.xyz.Compare( b.xyz, epsilon ) ||
+								idMath::Fabs( F16toF32( a.st[0] ) - F16toF32( b.st[0] ) ) > 0.001f ||
+								idMath::Fabs( F16toF32( a.st[1] ) - F16toF32( b.st[1] ) ) > 0.001f ||
+								*(const dword *)a.color != *(const dword *)b.color ) {
+							firstBad = i;
+							break;
+						}
+					}
+				}
+
+				numStages++;
+				if ( firstBad >= 0 ) {
+					numFailed++;
+					common->Printf( "%s stage %d orientation %s: %d batched verts, %d single verts, first mismatch at vert %d\n",
+						particleSystem->GetName(), stageNum, orientationNames[testOrientation], numBatchVerts, numSingleVerts, firstBad );
+				}
+			}
+			stage->orientation = orientation;
+		}
+	}
+
+	common->Printf( "%d particle stage tests, %d failed\n", numStages, numFailed );
+}
@@ -991,6 +991,24 @@ void R_LinkDrawSurfToView( drawSurf_t * drawSurf, viewDef_t * viewDef ) {
 	viewDef->numDrawSurfs++;
 }
 
+/*
+===================
+R_AddSingleModelShadows
+
+Sets up the shadow volumes the entity queued while it was added.
+===================
+*/
+static void R_AddSingleModelShadows( viewEntity_t * vEntity ) {
+	for ( staticShadowVolumeParms_t * shadowParms = vEntity->staticShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
+		StaticShadowVolumeJob( shadowParms );
+	}
+	for ( dynamicShadowVolumeParms_t * shadowParms = vEntity->dynamicShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
+		DynamicShadowVolumeJob( shadowParms );
+	}
+	vEntity->staticShadowVolumes = NULL;
+	vEntity->dynamicShadowVolumes = NULL;
+}
+
 /*
 ===================
 R_AddModels
@@ -1010,7 +1028,20 @@ void R_AddModels() {
 	// any light that intersects the view (for shadows).
 	//-------------------------------------------------
 
-	if ( r_useParallelAddModels.GetBool() ) {
+	const bool addShadowsWithModels = r_useParallelAddModels.GetBool() && r_useParallelAddShadows.GetInteger() == 1;
+
+	if ( addShadowsWithModels ) {
+		// an entity only queues shadow volumes on itself, so its shadows can be set up as soon
+		// as it is added instead of waiting for all entities to be added
+		for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
+			const int addJob = tr.frontEndJobList->AddJob( (jobRun_t)R_AddSingleModel, vEntity );
+			const int shadowJob = tr.frontEndJobList->AddJob( (jobRun_t)R_AddSingleModelShadows, vEntity );
+			tr.frontEndJobList->AddDependency( shadowJob, addJob );
+		}
+		tr.frontEndJobList->Submit();
+		// wait here otherwise the shadow volume index buffer may be unmapped before all shadow volumes have been constructed
+		tr.frontEndJobList->Wait();
+	} else if ( r_useParallelAddModels.GetBool() ) {
 		for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
 			tr.frontEndJobList->AddJob( (jobRun_t)R_AddSingleModel, vEntity );
 		}
@@ -1026,7 +1057,9 @@ void R_AddModels() {
 	// Kick off jobs to setup static and dynamic shadow volumes.
 	//-------------------------------------------------
 
-	if ( r_useParallelAddShadows.GetInteger() == 1 ) {
+	if ( addShadowsWithModels ) {
+		// already set up by the jobs that depend on the entity adds
+	} else if ( r_useParallelAddShadows.GetInteger() == 1 ) {
 		for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
 			for ( staticShadowVolumeParms_t * shadowParms = vEntity->staticShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
 				tr.frontEndJobList->AddJob( (jobRun_t)StaticShadowVolumeJob, shadowParms );
@@ -1044,14 +1077,7 @@ void R_AddModels() {
 		int start = Sys_Microseconds();
 
 		for ( viewEntity_t * vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next ) {
-			for ( staticShadowVolumeParms_t * shadowParms = vEntity->staticShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
-				StaticShadowVolumeJob( shadowParms );
-			}
-			for ( dynamicShadowVolumeParms_t * shadowParms = vEntity->dynamicShadowVolumes; shadowParms != NULL; shadowParms = shadowParms->next ) {
-				DynamicShadowVolumeJob( shadowParms );
-			}
-			vEntity->staticShadowVolumes = NULL;
-			vEntity->dynamicShadowVolumes = NULL;
+			R_AddSingleModelShadows( vEntity );
 		}
 
 		int end = Sys_Microseconds();
@@ -227,36 +227,301 @@ FONT-END RENDERING
 ==========================================================================================
 */
 
+/*
+==========================================================================================
+
+DRAW SURFACE SORTING
+
+==========================================================================================
+*/
+
+idCVar r_parallelSortDrawSurfs( "r_parallelSortDrawSurfs", "8192", CVAR_RENDERER | CVAR_INTEGER, "sort the draw surfaces with jobs when there are at least this many, 0 = never" );
+
+// The sort key is the inverted material sort value in the upper 32 bits and the
+// depth in the lower 16 bits, inverted so the surfaces come out in ascending order.
+// The radix sort is stable, so surfaces with equal keys stay in the order they were added.
+static const int DRAWSURF_SORT_KEY_BITS		= 48;
+static const int DRAWSURF_SORT_RADIX_BITS	= 8;
+static const int DRAWSURF_SORT_RADIX		= 1 << DRAWSURF_SORT_RADIX_BITS;
+static const int DRAWSURF_SORT_PASSES		= DRAWSURF_SORT_KEY_BITS / DRAWSURF_SORT_RADIX_BITS;
+static const int MAX_DRAWSURF_SORT_JOBS		= 16;
+
+struct drawSurfSort_t {
+	uint64					key;
+	drawSurf_t *			drawSurf;
+};
+
+struct drawSurfSortJob_t {
+	drawSurf_t **			drawSurfs;		// if not NULL the keys are created from these
+	drawSurfSort_t *		src;
+	drawSurfSort_t *		dst;
+	int						first;
+	int						num;
+	int						pass;
+	int						counts[DRAWSURF_SORT_PASSES][DRAWSURF_SORT_RADIX];
+};
+
+/*
+=================
+R_DrawSurfSortKey
+
+Sorts on:
+1. material sort value (smallest first)
+2. depth (farthest first)
+=================
+*/
+static ID_INLINE uint64 R_DrawSurfSortKey( const drawSurf_t * drawSurf ) {
+	float sort = SS_POST_PROCESS - drawSurf->sort;
+	assert( sort >= 0.0f );
+
+	uint64 dist = 0;
+	if ( drawSurf->frontEndGeo != NULL ) {
+		float min = 0.0f;
+		float max = 1.0f;
+		idRenderMatrix::DepthBoundsForBounds( min, max, drawSurf->space->mvp, drawSurf->frontEndGeo->bounds );
+		dist = idMath::Ftoui16( min * 0xFFFF );
+	}
+
+	const uint64 key = dist | ( (uint64) ( *(uint32 *)&sort ) << 16 );
+	return ~key & ( ( (uint64)1 << DRAWSURF_SORT_KEY_BITS ) - 1 );
+}
+
+/*
+=================
+R_DrawSurfSortDigit
+=================
+*/
+static ID_INLINE int R_DrawSurfSortDigit( const uint64 key, const int pass ) {
+	return (int)( key >> ( pass * DRAWSURF_SORT_RADIX_BITS ) ) & ( DRAWSURF_SORT_RADIX - 1 );
+}
+
+/*
+=================
+R_DrawSurfSortCountAll
+
+Counts the digits for all passes at once, only valid for the order the keys are in now.
+=================
+*/
+static void R_DrawSurfSortCountAll( const drawSurfSort_t * sort, const int num, int counts[DRAWSURF_SORT_PASSES][DRAWSURF_SORT_RADIX] ) {
+	memset( counts, 0, DRAWSURF_SORT_PASSES * DRAWSURF_SORT_RADIX * sizeof( counts[0][0] ) );
+	for ( int i = 0; i < num; i++ ) {
+		const uint64 key = sort[i].key;
+		for ( int pass = 0; pass < DRAWSURF_SORT_PASSES; pass++ ) {
+			counts[pass][R_DrawSurfSortDigit( key, pass )]++;
+		}
+	}
+}
+
+/*
+=================
+R_DrawSurfSortScatter
+
+The offsets are advanced past the scattered elements.
+=================
+*/
+static void R_DrawSurfSortScatter( const drawSurfSort_t * src, drawSurfSort_t * dst, const int num, const int pass, int offsets[DRAWSURF_SORT_RADIX] ) {
+	for ( int i = 0; i < num; i++ ) {
+		dst[offsets[R_DrawSurfSortDigit( src[i].key, pass )]++] = src[i];
+	}
+}
+
+/*
+=================
+R_RadixSortDrawSurfs
+
+Returns either sort or temp, whichever holds the sorted keys.
+Passes where all keys have the same digit are skipped.
+=================
+*/
+static drawSurfSort_t * R_RadixSortDrawSurfs( drawSurfSort_t * sort, drawSurfSort_t * temp, const int num ) {
+	if ( num <= 1 ) {
+		return sort;
+	}
+
+	int counts[DRAWSURF_SORT_PASSES][DRAWSURF_SORT_RADIX];
+	R_DrawSurfSortCountAll( sort, num, counts );
+
+	drawSurfSort_t * src = sort;
+	drawSurfSort_t * dst = temp;
+	for ( int pass = 0; pass < DRAWSURF_SORT_PASSES; pass++ ) {
+		if ( counts[pass][R_DrawSurfSortDigit( src[0].key, pass )] == num ) {
+			continue;
+		}
+		int offsets[DRAWSURF_SORT_RADIX];
+		for ( int i = 0, total = 0; i < DRAWSURF_SORT_RADIX; i++ ) {
+			offsets[i] = total;
+			total += counts[pass][i];
+		}
+		R_DrawSurfSortScatter( src, dst, num, pass, offsets );
+		SwapValues( src, dst );
+	}
+	return src;
+}
+
+/*
+=================
+R_DrawSurfSortKeysJob
+=================
+*/
+static void R_DrawSurfSortKeysJob( drawSurfSortJob_t * job ) {
+	drawSurfSort_t * sort = job->src + job->first;
+	if ( job->drawSurfs != NULL ) {
+		for ( int i = 0; i < job->num; i++ ) {
+			drawSurf_t * drawSurf = job->drawSurfs[job->first + i];
+			sort[i].key = R_DrawSurfSortKey( drawSurf );
+			sort[i].drawSurf = drawSurf;
+		}
+	}
+	R_DrawSurfSortCountAll( sort, job->num, job->counts );
+}
+
+/*
+=================
+R_DrawSurfSortCountJob
+=================
+*/
+static void R_DrawSurfSortCountJob( drawSurfSortJob_t * job ) {
+	int * counts = job->counts[job->pass];
+	memset( counts, 0, DRAWSURF_SORT_RADIX * sizeof( counts[0] ) );
+	const drawSurfSort_t * sort = job->src + job->first;
+	for ( int i = 0; i < job->num; i++ ) {
+		counts[R_DrawSurfSortDigit( sort[i].key, job->pass )]++;
+	}
+}
+
+/*
+=================
+R_DrawSurfSortScatterJob
+=================
+*/
+static void R_DrawSurfSortScatterJob( drawSurfSortJob_t * job ) {
+	R_DrawSurfSortScatter( job->src + job->first, job->dst, job->num, job->pass, job->counts[job->pass] );
+}
+
+REGISTER_PARALLEL_JOB( R_DrawSurfSortKeysJob, "R_DrawSurfSortKeysJob" );
+REGISTER_PARALLEL_JOB( R_DrawSurfSortCountJob, "R_DrawSurfSortCountJob" );
+REGISTER_PARALLEL_JOB( R_DrawSurfSortScatterJob, "R_DrawSurfSortScatterJob" );
+
+/*
+=================
+R_ParallelRadixSortDrawSurfs
+
+Splits the keys into one range per job. Each pass counts the digits for every
+range and then scatters every range to the offsets reserved for it, which keeps
+the sort stable. If drawSurfs is not NULL the keys are created by the jobs as well.
+=================
+*/
+static drawSurfSort_t * R_ParallelRadixSortDrawSurfs( idParallelJobList * jobList, drawSurf_t ** drawSurfs, drawSurfSort_t * sort, drawSurfSort_t * temp, const int num ) {
+	const int numJobs = idMath::ClampInt( 1, MAX_DRAWSURF_SORT_JOBS, parallelJobManager->GetNumProcessingUnits() );
+	const int numPerJob = ( num + numJobs - 1 ) / numJobs;
+
+	drawSurfSortJob_t * jobs = (drawSurfSortJob_t *) _alloca16( numJobs * sizeof( jobs[0] ) );
+	for ( int i = 0; i < numJobs; i++ ) {
+		jobs[i].drawSurfs = drawSurfs;
+		jobs[i].src = sort;
+		jobs[i].dst = temp;
+		jobs[i].first = Min( i * numPerJob, num );
+		jobs[i].num = Min( numPerJob, num - jobs[i].first );
+		jobs[i].pass = 0;
+		jobList->AddJob( (jobRun_t)R_DrawSurfSortKeysJob, &jobs[i] );
+	}
+	jobList->Submit();
+	jobList->Wait();
+
+	// the keys jobs counted all digits in the original order, so the
+	// counts are only used per range until the first pass is done
+	int totals[DRAWSURF_SORT_PASSES][DRAWSURF_SORT_RADIX];
+	memset( totals, 0, sizeof( totals ) );
+	for ( int i = 0; i < numJobs; i++ ) {
+		for ( int pass = 0; pass < DRAWSURF_SORT_PASSES; pass++ ) {
+			for ( int d = 0; d < DRAWSURF_SORT_RADIX; d++ ) {
+				totals[pass][d] += jobs[i].counts[pass][d];
+			}
+		}
+	}
+
+	drawSurfSort_t * src = sort;
+	drawSurfSort_t * dst = temp;
+	bool reordered = false;
+	for ( int pass = 0; pass < DRAWSURF_SORT_PASSES; pass++ ) {
+		if ( totals[pass][R_DrawSurfSortDigit( src[0].key, pass )] == num ) {
+			continue;
+		}
+
+		if ( reordered ) {
+			for ( int i = 0; i < numJobs; i++ ) {
+				jobs[i].src = src;
+				jobs[i].pass = pass;
+				jobList->AddJob( (jobRun_t)R_DrawSurfSortCountJob, &jobs[i] );
+			}
+			jobList->Submit();
+			jobList->Wait();
+		}
+
+		// turn the counts into offsets, digit major so the ranges stay in order
+		for ( int d = 0, total = 0; d < DRAWSURF_SORT_RADIX; d++ ) {
+			for ( int i = 0; i < numJobs; i++ ) {
+				const int count = jobs[i].counts[pass][d];
+				jobs[i].counts[pass][d] = total;
+				total += count;
+			}
+		}
+
+		for ( int i = 0; i < numJobs; i++ ) {
+			jobs[i].src = src;
+			jobs[i].dst = dst;
+			jobs[i].pass = pass;
+			jobList->AddJob( (jobRun_t)R_DrawSurfSortScatterJob, &jobs[i] );
+		}
+		jobList->Submit();
+		jobList->Wait();
+
+		SwapValues( src, dst );
+		reordered = true;
+	}
+	return src;
+}
+
 /*
 =================
 R_SortDrawSurfs
 =================
 */
 static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
-#if 1
+	SCOPED_PROFILE_EVENT( "R_SortDrawSurfs" );
 
-	uint64 * indices = (uint64 *) _alloca16( numDrawSurfs * sizeof( indices[0] ) );
+	if ( numDrawSurfs <= 1 ) {
+		return;
+	}
 
-	// sort the draw surfs based on:
-	// 1. sort value (largest first)
-	// 2. depth (smallest first)
-	// 3. index (largest first)
-	assert( numDrawSurfs <= 0xFFFF );
-	for ( int i = 0; i < numDrawSurfs; i++ ) {
-		float sort = SS_POST_PROCESS - drawSurfs[i]->sort;
-		assert( sort >= 0.0f );
-
-		uint64 dist = 0;
-		if ( drawSurfs[i]->frontEndGeo != NULL ) {
-			float min = 0.0f;
-			float max = 1.0f;
-			idRenderMatrix::DepthBoundsForBounds( min, max, drawSurfs[i]->space->mvp, drawSurfs[i]->frontEndGeo->bounds );
-			dist = idMath::Ftoui16( min * 0xFFFF );
+	drawSurfSort_t * sort = (drawSurfSort_t *) R_FrameAlloc( numDrawSurfs * sizeof( sort[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
+	drawSurfSort_t * temp = (drawSurfSort_t *) R_FrameAlloc( numDrawSurfs * sizeof( temp[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
+
+	drawSurfSort_t * sorted;
+	if ( r_parallelSortDrawSurfs.GetInteger() > 0 && numDrawSurfs >= r_parallelSortDrawSurfs.GetInteger() ) {
+		sorted = R_ParallelRadixSortDrawSurfs( tr.frontEndJobList, drawSurfs, sort, temp, numDrawSurfs );
+	} else {
+		for ( int i = 0; i < numDrawSurfs; i++ ) {
+			sort[i].key = R_DrawSurfSortKey( drawSurfs[i] );
+			sort[i].drawSurf = drawSurfs[i];
 		}
-		
-		indices[i] = ( ( numDrawSurfs - i ) & 0xFFFF ) | ( dist << 16 ) | ( (uint64) ( *(uint32 *)&sort ) << 32 );
+		sorted = R_RadixSortDrawSurfs( sort, temp, numDrawSurfs );
 	}
 
+	for ( int i = 0; i < numDrawSurfs; i++ ) {
+		drawSurfs[i] = sorted[i].drawSurf;
+	}
+}
+
+/*
+=================
+R_QuickSortDrawSurfKeys
+
+The previous sort, kept to compare against. The keys are packed with a 16 bit
+index so this can't sort more than 64k surfaces. Sorts in descending order.
+=================
+*/
+static void R_QuickSortDrawSurfKeys( uint64 * indices, const int numDrawSurfs ) {
 	const int64 MAX_LEVELS = 128;
 	int64 lo[MAX_LEVELS];
 	int64 hi[MAX_LEVELS];
@@ -278,10 +543,6 @@ static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
 				uint64 h = indices[i]; indices[i] = indices[j]; indices[j] = h;
 			} while ( ++i <= --j );
 
-			// No need for these iterations because we are always sorting unique values.
-			//while ( indices[j] == pivot && st_lo < j ) j--;
-			//while ( indices[i] == pivot && i < st_hi ) i++;
-
 			assert( level < MAX_LEVELS - 1 );
 			lo[level] = i;
 			hi[level] = st_hi;
@@ -304,41 +565,91 @@ static void R_SortDrawSurfs( drawSurf_t ** drawSurfs, const int numDrawSurfs ) {
 			st_hi = hi[level];
 		}
 	}
+}
 
-	drawSurf_t ** newDrawSurfs = (drawSurf_t **) indices;
-	for ( int i = 0; i < numDrawSurfs; i++ ) {
-		newDrawSurfs[i] = drawSurfs[numDrawSurfs - ( indices[i] & 0xFFFF )];
+/*
+=================
+R_BenchSortDrawSurfs_f
+
+Times the draw surface sorts on random keys with a typical mix of material sort values.
+
+benchSortDrawSurfs [numSurfs] [numIterations]
+=================
+*/
+void R_BenchSortDrawSurfs_f( const idCmdArgs & args ) {
+	const int maxSurfs = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 256 * 1024;
+	const int numIterations = ( args.Argc() > 2 ) ? Max( 1, atoi( args.Argv( 2 ) ) ) : 20;
+
+	static const float sortValues[] = { SS_SUBVIEW, SS_GUI, SS_OPAQUE, SS_OPAQUE, SS_OPAQUE, SS_OPAQUE, SS_DECAL, SS_FAR, SS_MEDIUM, SS_CLOSE, SS_ALMOST_NEAREST, SS_NEAREST, SS_POST_PROCESS };
+
+	idRandom random( 0 );
+	drawSurfSort_t * keys = (drawSurfSort_t *) Mem_Alloc16( maxSurfs * sizeof( keys[0] ), TAG_RENDER );
+	drawSurfSort_t * sort = (drawSurfSort_t *) Mem_Alloc16( maxSurfs * sizeof( sort[0] ), TAG_RENDER );
+	drawSurfSort_t * temp = (drawSurfSort_t *) Mem_Alloc16( maxSurfs * sizeof( temp[0] ), TAG_RENDER );
+	uint64 * packed = (uint64 *) Mem_Alloc16( maxSurfs * sizeof( packed[0] ), TAG_RENDER );
+	for ( int i = 0; i < maxSurfs; i++ ) {
+		float value = SS_POST_PROCESS - sortValues[random.RandomInt( sizeof( sortValues ) / sizeof( sortValues[0] ) )];
+		const uint64 dist = random.RandomInt( 0x10000 );
+		keys[i].key = ~( dist | ( (uint64) ( *(uint32 *)&value ) << 16 ) ) & ( ( (uint64)1 << DRAWSURF_SORT_KEY_BITS ) - 1 );
+		keys[i].drawSurf = (drawSurf_t *)(intptr_t)i;
 	}
-	memcpy( drawSurfs, newDrawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
 
-#else
+	idParallelJobList * jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_DRAWSURF_SORT_JOBS, 0, NULL );
+
+	common->Printf( "    surfs   quicksort       radix  radix jobs  (best of %d, microseconds)\n", numIterations );
+	for ( int numSurfs = Min( 1024, maxSurfs ); ; numSurfs = Min( numSurfs * 4, maxSurfs ) ) {
+		int64 best[3] = { INT_MAX, INT_MAX, INT_MAX };
+		bool match = true;
+
+		for ( int iteration = 0; iteration < numIterations; iteration++ ) {
+			if ( numSurfs <= 0xFFFF ) {
+				for ( int i = 0; i < numSurfs; i++ ) {
+					packed[i] = ( ~keys[i].key << 16 ) | ( ( numSurfs - i ) & 0xFFFF );
+				}
+				int64 start = Sys_Microseconds();
+				R_QuickSortDrawSurfKeys( packed, numSurfs );
+				best[0] = Min( best[0], (int64)( Sys_Microseconds() - start ) );
+			}
 
-	struct local_t {
-		static int R_QsortSurfaces( const void *a, const void *b ) {
-			const drawSurf_t * ea = *(drawSurf_t **)a;
-			const drawSurf_t * eb = *(drawSurf_t **)b;
-			if ( ea->sort < eb->sort ) {
-				return -1;
+			memcpy( sort, keys, numSurfs * sizeof( sort[0] ) );
+			int64 start = Sys_Microseconds();
+			drawSurfSort_t * sorted = R_RadixSortDrawSurfs( sort, temp, numSurfs );
+			best[1] = Min( best[1], (int64)( Sys_Microseconds() - start ) );
+
+			if ( numSurfs <= 0xFFFF ) {
+				for ( int i = 0; i < numSurfs && match; i++ ) {
+					match = ( (intptr_t)sorted[i].drawSurf == numSurfs - (int)( packed[i] & 0xFFFF ) );
+				}
 			}
-			if ( ea->sort > eb->sort ) {
-				return 1;
+
+			memcpy( sort, keys, numSurfs * sizeof( sort[0] ) );
+			start = Sys_Microseconds();
+			drawSurfSort_t * sortedJobs = R_ParallelRadixSortDrawSurfs( jobList, NULL, sort, temp, numSurfs );
+			best[2] = Min( best[2], (int64)( Sys_Microseconds() - start ) );
+
+			// the keys are ordered and ties keep their original order if the sort is correct and stable
+			for ( int i = 1; i < numSurfs && match; i++ ) {
+				match = ( sortedJobs[i - 1].key < sortedJobs[i].key ) || ( sortedJobs[i - 1].key == sortedJobs[i].key && sortedJobs[i - 1].drawSurf < sortedJobs[i].drawSurf );
 			}
-			return 0;
 		}
-	};
 
-	// Add a sort offset so surfaces with equal sort orders still deterministically
-	// draw in the order they were added, at least within a given model.
-	float sorfOffset = 0.0f;
-	for ( int i = 0; i < numDrawSurfs; i++ ) {
-		drawSurf[i]->sort += sorfOffset;
-		sorfOffset += 0.000001f;
+		if ( numSurfs <= 0xFFFF ) {
+			common->Printf( "%9d %11d %11d %11d  %s\n", numSurfs, (int)best[0], (int)best[1], (int)best[2], match ? "ok" : "MISMATCH" );
+		} else {
+			common->Printf( "%9d %11s %11d %11d  %s\n", numSurfs, "-", (int)best[1], (int)best[2], match ? "ok" : "MISMATCH" );
+		}
+
+		if ( numSurfs == maxSurfs ) {
+			break;
+		}
 	}
 
-	// sort the drawsurfs
-	qsort( drawSurfs, numDrawSurfs, sizeof( drawSurfs[0] ), local_t::R_QsortSurfaces );
+	parallelJobManager->FreeJobList( jobList );
 
-#endif
+	Mem_Free16( keys );
+	Mem_Free16( sort );
+	Mem_Free16( temp );
+	Mem_Free16( packed );
 }
 
 /*
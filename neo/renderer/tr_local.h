@@ -1108,6 +1108,8 @@ void R_StaticFree( void *data );
 
 void R_RenderView( viewDef_t *parms );
 void R_RenderPostProcess( viewDef_t *parms );
+void R_BenchSortDrawSurfs_f( const idCmdArgs &args );
+void R_TestParticles_f( const idCmdArgs &args );
 
 /*
 ============================================================
@@ -36,6 +36,8 @@ idCVar net_ssTemplateDebug( "net_ssTemplateDebug", "0", CVAR_BOOL, "Debug snapsh
 idCVar net_ssTemplateDebug_len( "net_ssTemplateDebug_len", "32", CVAR_INTEGER, "Offset to start template state debugging" );
 idCVar net_ssTemplateDebug_start( "net_ssTemplateDebug_start", "0", CVAR_INTEGER, "length of template state to print in debugging" );
 
+idCVar net_snapPriorityDistance( "net_snapPriorityDistance", "1024", CVAR_FLOAT, "distance from a client's view at which objects gain priority half as fast, 0 = ignore distance", 0.0f, 65536.0f );
+
 /*
 ========================
 InDebugRange
@@ -142,7 +144,8 @@ idSnapShot::idSnapShot
 */
 idSnapShot::idSnapShot() :
 	time( 0 ),
-	recvTime( 0 )
+	recvTime( 0 ),
+	viewOriginMask( 0 )
 {
 }
 
@@ -151,7 +154,7 @@ idSnapShot::idSnapShot() :
 idSnapShot::idSnapShot
 ========================
 */
-idSnapShot::idSnapShot( const idSnapShot & other ) : time( 0 ), recvTime(0) {
+idSnapShot::idSnapShot( const idSnapShot & other ) : time( 0 ), recvTime(0), viewOriginMask( 0 ) {
 	*this = other;
 }
 
@@ -172,6 +175,7 @@ idSnapShot::Clear
 void idSnapShot::Clear() {
 	time = 0;
 	recvTime = 0;
+	viewOriginMask = 0;
 	for ( int i = 0; i < objectStates.Num(); i++ ) {
 		FreeObjectState( i );
 	}
@@ -206,9 +210,16 @@ void idSnapShot::operator=( const idSnapShot & other ) {
 			state.changedCount	= otherState.changedCount;
 			state.expectedSequence = otherState.expectedSequence;
 			state.createdFromTemplate = otherState.createdFromTemplate;
+			state.priority		= otherState.priority;
+			state.origin		= otherState.origin;
+			state.hasOrigin		= otherState.hasOrigin;
 		}
 		time = other.time;
 		recvTime = other.recvTime;
+		for ( int i = 0; i < MAX_VIS_INDEX; i++ ) {
+			viewOrigins[i] = other.viewOrigins[i];
+		}
+		viewOriginMask = other.viewOriginMask;
 	}
 }
 
@@ -548,6 +559,150 @@ idSnapShot::objectState_t * idSnapShot::GetTemplateState( int objNum, idSnapShot
 	return oldState;
 }
 
+/*
+========================
+AddObjectPair
+========================
+*/
+static ID_INLINE void AddObjectPair( idList< idSnapShot::objectPair_t, TAG_NETWORKING > & pairs, idSnapShot::objectState_t * newState, idSnapShot::objectState_t * oldState ) {
+	idSnapShot::objectPair_t & pair = pairs.Alloc();
+	pair.newState = newState;
+	pair.oldState = oldState;
+}
+
+/*
+========================
+EstimateObjectCost
+Roughly what the object will take in the delta after zero run length compression
+========================
+*/
+static int EstimateObjectCost( idSnapShot::objectState_t * newState, idSnapShot::objectState_t * oldState ) {
+	int cost = sizeof( uint16 ) + sizeof( objectSize_t );		// id and size
+
+	if ( newState == NULL ) {
+		return cost;
+	}
+
+	const byte * newData = newState->buffer.Ptr();
+	const int newSize = newState->buffer.Size();
+	const byte * oldData = ( oldState != NULL ) ? oldState->buffer.Ptr() : NULL;
+	const int compareSize = ( oldData != NULL ) ? Min( newSize, (int)oldState->buffer.Size() ) : 0;
+
+	// zero runs compress to a couple of bytes, every changed byte costs one
+	bool inRun = false;
+	for ( int b = 0; b < compareSize; b++ ) {
+		if ( newData[b] != oldData[b] ) {
+			cost++;
+			inRun = false;
+		} else if ( !inRun ) {
+			cost += 2;
+			inRun = true;
+		}
+	}
+	cost += newSize - compareSize;
+
+	return cost;
+}
+
+class idSort_ScheduledObject : public idSort_Quick< idSnapShot::scheduledObject_t, idSort_ScheduledObject > {
+public:
+	int Compare( const idSnapShot::scheduledObject_t & a, const idSnapShot::scheduledObject_t & b ) const {
+		if ( a.priority != b.priority ) {
+			return ( a.priority > b.priority ) ? -1 : 1;
+		}
+		return a.pair - b.pair;
+	}
+};
+
+/*
+========================
+idSnapShot::ScheduleObjects
+Every changed object gains its priority, scaled down with the distance to the client's
+view, each time a delta is written. Objects are then sent from the highest accumulated
+priority down until the budget is used, and the ones sent start over from zero.
+Objects that are left out stay at their last acknowledged state on the client and keep
+climbing, so on a slow connection everything still gets updated, just less often.
+New, deleted and visibility changing objects are always sent.
+========================
+*/
+void idSnapShot::ScheduleObjects( const submitDeltaJobsInfo_t & submitDeltaJobsInfo ) {
+	scheduler_t & scheduler = *submitDeltaJobsInfo.scheduler;
+	const int visIndex = submitDeltaJobsInfo.visIndex;
+
+	scheduler.deferred.SetNum( scheduler.pairs.Num() );
+	for ( int i = 0; i < scheduler.deferred.Num(); i++ ) {
+		scheduler.deferred[i] = false;
+	}
+
+	if ( scheduler.budget <= 0 ) {
+		return;
+	}
+
+	idVec3 viewOrigin;
+	const bool hasViewOrigin = GetViewOrigin( visIndex, viewOrigin );
+	const float halfDistance = net_snapPriorityDistance.GetFloat();
+
+	int used = 0;
+	scheduler.candidates.SetNum( 0 );
+
+	for ( int i = 0; i < scheduler.pairs.Num(); i++ ) {
+		objectState_t * newState = scheduler.pairs[i].newState;
+		objectState_t * oldState = scheduler.pairs[i].oldState;
+
+		if ( newState == NULL || oldState == NULL || oldState->buffer.Size() == 0 ) {
+			// Created or deleted
+			used += EstimateObjectCost( newState, oldState );
+			continue;
+		}
+
+		if ( visIndex > 0 ) {
+			const bool oldVisible = ( oldState->visMask & ( 1 << visIndex ) ) != 0;
+			const bool newVisible = ( newState->visMask & ( 1 << visIndex ) ) != 0;
+			if ( !oldVisible && !newVisible ) {
+				continue;		// stale for this client, nothing is written
+			}
+			if ( oldVisible != newVisible ) {
+				used += EstimateObjectCost( newVisible ? newState : NULL, oldState );
+				continue;
+			}
+		}
+
+		if ( newState->buffer.Size() == oldState->buffer.Size() && memcmp( newState->buffer.Ptr(), oldState->buffer.Ptr(), newState->buffer.Size() ) == 0 ) {
+			continue;			// same, nothing is written
+		}
+
+		float weight = newState->priority;
+		if ( hasViewOrigin && newState->hasOrigin && halfDistance > 0.0f ) {
+			weight *= halfDistance / ( halfDistance + ( newState->origin - viewOrigin ).Length() );
+		}
+
+		const int objectNum = newState->objectNum;
+		scheduler.accumulated.AssureSize( objectNum + 1, 0.0f );
+		scheduler.accumulated[objectNum] += weight;
+
+		scheduledObject_t & candidate = scheduler.candidates.Alloc();
+		candidate.pair		= i;
+		candidate.cost		= EstimateObjectCost( newState, oldState );
+		candidate.priority	= scheduler.accumulated[objectNum];
+	}
+
+	scheduler.candidates.SortWithTemplate( idSort_ScheduledObject() );
+
+	int numDeferred = 0;
+	for ( int i = 0; i < scheduler.candidates.Num(); i++ ) {
+		const scheduledObject_t & candidate = scheduler.candidates[i];
+		if ( used + candidate.cost > scheduler.budget && i > 0 ) {
+			scheduler.deferred[candidate.pair] = true;
+			numDeferred++;
+			continue;
+		}
+		used += candidate.cost;
+		scheduler.accumulated[scheduler.pairs[candidate.pair].newState->objectNum] = 0.0f;
+	}
+
+	NET_VERBOSESNAPSHOT_PRINT_LEVEL( 3, va( "ScheduleObjects: client %d sent %d of %d changed objects, ~%d of %d bytes\n", visIndex, scheduler.candidates.Num() - numDeferred, scheduler.candidates.Num(), used, scheduler.budget ) );
+}
+
 /*
 ========================
 idSnapShot::SubmitWriteDeltaToJobs
@@ -564,6 +719,10 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDel
 	submitDeltaJobInfo.lzwInOutData->lzwBytes		= 0;
 	submitDeltaJobInfo.lzwInOutData->fullSnap		= false;
 
+	assert( submitDeltaJobInfo.scheduler != NULL );
+	idList< objectPair_t, TAG_NETWORKING > & pairs = submitDeltaJobInfo.scheduler->pairs;
+	pairs.SetNum( 0 );
+
 	int j = 0;
 	
 	int numOldStates = submitDeltaJobInfo.oldSnap->objectStates.Num();
@@ -582,7 +741,7 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDel
 			// All objects are new from this point on.
 
 			objectState_t * oldState = GetTemplateState( newState.objectNum, submitDeltaJobInfo.templateStates, &newState );
-			SubmitObjectJob( submitDeltaJobInfo, &newState, oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+			AddObjectPair( pairs, &newState, oldState );
 			continue;
 		}
 
@@ -594,7 +753,7 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDel
 				continue;		// Don't delete objects that are stale and not marked as deleted
 			}
 
-			SubmitObjectJob( submitDeltaJobInfo, NULL, &oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+			AddObjectPair( pairs, NULL, &oldState );
 		}
 		
 		if ( j >= numOldStates ) {
@@ -611,13 +770,13 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDel
 				oldState = GetTemplateState( newState.objectNum, submitDeltaJobInfo.templateStates, &newState );
 			}
 
-			SubmitObjectJob( submitDeltaJobInfo, &newState, oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+			AddObjectPair( pairs, &newState, oldState );
 			j++;
 		} else {
 			// Different object, this one is new, 
 			// Spawned
 			oldState = GetTemplateState( newState.objectNum, submitDeltaJobInfo.templateStates, &newState );
-			SubmitObjectJob( submitDeltaJobInfo, &newState, oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+			AddObjectPair( pairs, &newState, oldState );
 		}
 	}
 	// Finally, remove any entities at the end
@@ -628,9 +787,20 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDel
 			continue;		// Don't delete objects that are stale and not marked as deleted
 		}
 
-		SubmitObjectJob( submitDeltaJobInfo, NULL, &oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+		AddObjectPair( pairs, NULL, &oldState );
 	}
 				
+	// Leave out the changed objects that don't fit the budget
+	ScheduleObjects( submitDeltaJobInfo );
+
+	const idList< bool, TAG_NETWORKING > & deferred = submitDeltaJobInfo.scheduler->deferred;
+	for ( int i = 0; i < pairs.Num(); i++ ) {
+		if ( deferred[i] ) {
+			continue;		// Left out of the delta, same as an ack
+		}
+		SubmitObjectJob( submitDeltaJobInfo, pairs[i].newState, pairs[i].oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
+	}
+
 	// Submit any objects that are left over (will be all if they all fit up to this point)
 	SubmitLZWJob( submitDeltaJobInfo, baseObjParms, curObjParms, curlzwParms, false );
 }
@@ -939,6 +1109,8 @@ idSnapShot::objectState_t * idSnapShot::S_AddObject( int objectNum, uint32 visMa
 	objectSize_t size = _size;
 	objectState_t & state = FindOrCreateObjectByID( objectNum );
 	state.visMask = visMask;
+	state.priority = 1.0f;
+	state.hasOrigin = false;
 	if ( state.buffer.Size() == size && state.buffer.NumRefs() == 1 ) {
 		// re-use the same buffer
 		memcpy( state.buffer.Ptr(), data, size );
@@ -973,6 +1145,9 @@ bool idSnapShot::CopyObject( const idSnapShot & oldss, int objectNum, bool force
 	newState.changedCount	= oldState.changedCount;
 	newState.expectedSequence = oldState.expectedSequence;
 	newState.createdFromTemplate = oldState.createdFromTemplate;
+	newState.priority		= oldState.priority;
+	newState.origin			= oldState.origin;
+	newState.hasOrigin		= oldState.hasOrigin;
 
 	if ( forceStale ) {
 		newState.visMask = 0;
@@ -1279,3 +1454,29 @@ CONSOLE_COMMAND( serializeQTest, "Serialization Sanity Test", 0 ) {
 	}
 }
 #endif
+
+/*
+========================
+idSnapShot::SetViewOrigin
+========================
+*/
+void idSnapShot::SetViewOrigin( int visIndex, const idVec3 & origin ) {
+	if ( visIndex < 0 || visIndex >= MAX_VIS_INDEX ) {
+		return;
+	}
+	viewOrigins[visIndex] = origin;
+	viewOriginMask |= ( 1 << visIndex );
+}
+
+/*
+========================
+idSnapShot::GetViewOrigin
+========================
+*/
+bool idSnapShot::GetViewOrigin( int visIndex, idVec3 & origin ) const {
+	if ( visIndex < 0 || visIndex >= MAX_VIS_INDEX || ( viewOriginMask & ( 1 << visIndex ) ) == 0 ) {
+		return false;
+	}
+	origin = viewOrigins[visIndex];
+	return true;
+}
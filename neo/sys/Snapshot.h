@@ -91,7 +91,10 @@ public:
 			changedCount( 0 ),
 			createdFromTemplate( false ),
 			
-			expectedSequence( 0 )
+			expectedSequence( 0 ),
+			priority( 1.0f ),
+			origin( vec3_origin ),
+			hasOrigin( false )
 			{ }
 		void Print( const char * name );
 
@@ -103,8 +106,40 @@ public:
 		int				changedCount;	// Incremented each time the state changed
 		int				expectedSequence;
 		bool			createdFromTemplate;
+
+		// Only used by the server to schedule objects, never sent
+		float			priority;		// gameplay priority, how fast the object climbs when it isn't sent
+		idVec3			origin;			// used for the distance to the client's view
+		bool			hasOrigin;
+	};
+
+	// Every object written to a delta, in object order
+	struct objectPair_t {
+		objectState_t *		newState;
+		objectState_t *		oldState;
+	};
+
+	struct scheduledObject_t {
+		int					pair;			// index into scheduler_t::pairs
+		int					cost;			// estimated bytes
+		float				priority;
+	};
+
+	// Per client priority accumulator, see idSnapShot::ScheduleObjects
+	struct scheduler_t {
+		scheduler_t() : budget( 0 ) { }
+
+		idList< float, TAG_NETWORKING >				accumulated;	// indexed by object number
+		int											budget;			// bytes of object data that fit a snapshot, 0 = send everything
+
+		// scratch memory
+		idList< objectPair_t, TAG_NETWORKING >		pairs;
+		idList< bool, TAG_NETWORKING >				deferred;		// parallel to pairs
+		idList< scheduledObject_t, TAG_NETWORKING >	candidates;
 	};
 
+	static const int MAX_VIS_INDEX = 32;
+
 	struct submitDeltaJobsInfo_t {
 		objParms_t *		objParms;				// Start of object parms
 		int					maxObjParms;			// Max parms (which will dictate how many objects can be processed)
@@ -122,6 +157,8 @@ public:
 		idSnapShot *		templateStates;			// states for new snapObj that arent in old states
 		
 		lzwInOutData_t *	lzwInOutData;
+
+		scheduler_t *		scheduler;				// picks the changed objects that fit the budget by priority
 	};
 
 	void SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t & submitDeltaJobInfo );
@@ -167,6 +204,10 @@ public:
 
 	void	RemoveObject( int objId );
 
+	// Where the client with this vis index is looking from, used to schedule objects by distance
+	void	SetViewOrigin( int visIndex, const idVec3 & origin );
+	bool	GetViewOrigin( int visIndex, idVec3 & origin ) const;
+
 private:
 
 	idList< objectState_t *, TAG_IDLIB_LIST_SNAPSHOT>							objectStates;
@@ -175,6 +216,9 @@ private:
 	int													time;
 	int													recvTime;
 
+	idVec3												viewOrigins[ MAX_VIS_INDEX ];
+	uint32												viewOriginMask;
+
 	int				BinarySearch( int objectNum ) const;
 	objectState_t &	FindOrCreateObjectByID( int objectNum );					// objIndex is optional parm for returning the index of the obj
 
@@ -194,6 +238,8 @@ private:
 		bool							saveDictionary		// If true, this is the first of several calls which will be appended
 	);		
 	
+	void ScheduleObjects( const submitDeltaJobsInfo_t & submitDeltaJobsInfo );
+
 	void WriteObject( idFile * file, int visIndex, objectState_t * newState, objectState_t * oldState, int & lastobjectNum );
 	void FreeObjectState( int index );
 };
@@ -31,6 +31,8 @@ If you have questions concerning this license or the applicable additional terms
 idCVar net_optimalSnapDeltaSize( "net_optimalSnapDeltaSize", "1000", CVAR_INTEGER, "Optimal size of snapshot delta msgs." );
 idCVar net_debugBaseStates( "net_debugBaseStates", "0", CVAR_BOOL, "Log out base state information" );
 idCVar net_skipClientDeltaAppend( "net_skipClientDeltaAppend", "0", CVAR_BOOL, "Simulate delta receive buffer overflowing" );
+idCVar net_snapPriority( "net_snapPriority", "1", CVAR_BOOL, "Only send the highest priority changed objects that fit the snapshot budget, the rest are sent later" );
+idCVar net_snapPriorityBudgetScale( "net_snapPriorityBudgetScale", "2", CVAR_FLOAT, "snapshot budget as a multiple of net_optimalSnapDeltaSize, to account for compression", 0.1f, 16.0f );
 
 /*
 ========================
@@ -82,6 +84,8 @@ void idSnapshotProcessor::Reset( bool cstor ) {
 	pendingSnap.Clear();
 	deltas.Clear();
 
+	scheduler.accumulated.Clear();
+
 	partialBaseSequence = -1;
 
 	memset( &jobMemory->lzwInOutData, 0, sizeof( jobMemory->lzwInOutData ) );
@@ -184,6 +188,9 @@ void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8 * objMemory, in
 		
 	submitInfo.lzwInOutData		= &jobMemory->lzwInOutData;
 
+	scheduler.budget			= net_snapPriority.GetBool() ? idMath::Ftoi( net_optimalSnapDeltaSize.GetInteger() * net_snapPriorityBudgetScale.GetFloat() ) : 0;
+	submitInfo.scheduler		= &scheduler;
+
 	pendingSnap.SubmitWriteDeltaToJobs( submitInfo );
 }
 
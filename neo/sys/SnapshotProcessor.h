@@ -138,6 +138,8 @@ private:
 	jobMemory_t *	jobMemory;
 
 	idSnapShot		submittedState;
+
+	idSnapShot::scheduler_t	scheduler;		// per client object priorities, persists across snapshots
 	
 	idSnapShot		templateStates;			// holds default snapshot states for some newly spawned object
 	idSnapShot		submittedTemplateStates;
@@ -34,6 +34,8 @@ If you have questions concerning this license or the applicable additional terms
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 #include "../sys_local.h"
 #include "../sdl/sdl_local.h"
@@ -144,6 +146,43 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp ) {
 	return st.st_mtime;
 }
 
+/*
+========================
+Sys_MapFile
+========================
+*/
+const byte * Sys_MapFile( const char *path, int &length ) {
+	length = 0;
+	int fd = open( path, O_RDONLY );
+	if ( fd < 0 ) {
+		return NULL;
+	}
+	struct stat st;
+	if ( fstat( fd, &st ) != 0 || st.st_size <= 0 || st.st_size > INT_MAX ) {
+		close( fd );
+		return NULL;
+	}
+	void * data = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	// the mapping stays valid after the descriptor is closed
+	close( fd );
+	if ( data == MAP_FAILED ) {
+		return NULL;
+	}
+	length = st.st_size;
+	return (const byte *)data;
+}
+
+/*
+========================
+Sys_UnmapFile
+========================
+*/
+void Sys_UnmapFile( const byte *data, int length ) {
+	if ( data != NULL ) {
+		munmap( (void *)data, length );
+	}
+}
+
 /*
 ========================
 Sys_Rmdir
@@ -526,6 +526,10 @@ typedef FILE * idFileHandle;
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// maps a whole file read only, returns NULL if the file can't be mapped
+const byte *	Sys_MapFile( const char *path, int &length );
+void			Sys_UnmapFile( const byte *data, int length );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char *	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char *	Sys_SecToStr( int sec );
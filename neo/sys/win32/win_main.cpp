@@ -207,6 +207,48 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp ) {
 	return st.st_mtime;
 }
 
+/*
+========================
+Sys_MapFile
+========================
+*/
+const byte * Sys_MapFile( const char *path, int &length ) {
+	length = 0;
+	HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( file == INVALID_HANDLE_VALUE ) {
+		return NULL;
+	}
+	LARGE_INTEGER size;
+	if ( !GetFileSizeEx( file, &size ) || size.QuadPart <= 0 || size.QuadPart > INT_MAX ) {
+		CloseHandle( file );
+		return NULL;
+	}
+	HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	CloseHandle( file );
+	if ( mapping == NULL ) {
+		return NULL;
+	}
+	// the view keeps the mapping alive after the handle is closed
+	const byte * data = (const byte *)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	CloseHandle( mapping );
+	if ( data == NULL ) {
+		return NULL;
+	}
+	length = (int)size.QuadPart;
+	return data;
+}
+
+/*
+========================
+Sys_UnmapFile
+========================
+*/
+void Sys_UnmapFile( const byte *data, int length ) {
+	if ( data != NULL ) {
+		UnmapViewOfFile( data );
+	}
+}
+
 /*
 ========================
 Sys_Rmdir